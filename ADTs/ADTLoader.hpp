@@ -18,8 +18,33 @@
 
 #include "Triplet/TripletLoader.hpp"
 #include "List/ListLoader.hpp"
+#include "Search/SearchLoader.hpp"
+#include "Queue/QueueLoader.hpp"
+#include "Array/ArrayLoader.hpp"
+#include "String/StringLoader.hpp"
+#include "Graph/GraphLoader.hpp"
+
+// 新增 ADT 时，只需在这里加入其 Loader 列出的指令，并在 loadAllAdts 中调用其 Loader
+constexpr InstructionEntry allInstructions[] = {
+    TRIPLET_INSTRUCTIONS
+    LIST_INSTRUCTIONS
+    SEARCH_INSTRUCTIONS
+    QUEUE_INSTRUCTIONS
+    ARRAY_INSTRUCTIONS
+    STRING_INSTRUCTIONS
+    GRAPH_INSTRUCTIONS
+};
+
+// 完美哈希指令表在编译期生成，程序启动时不需要为注册指令分配任何内存
+constexpr auto instructionTable = buildInstructionTable(allInstructions);
 
 void loadAllAdts() {
     loadTriplet();
     loadList();
+    loadSearch();
+    loadQueue();
+    loadArray();
+    loadString();
+    loadGraph();
+    Interactor::instance()->setInstructionTable(makeInstructionTableView(instructionTable));
 }
\ No newline at end of file
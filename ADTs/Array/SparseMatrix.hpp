@@ -0,0 +1,630 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "List/SequenceList.hpp"
+#include "Triplet/TripletArray.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <thread>
+#include <vector>
+
+namespace DataStructure_Cxx {
+
+#define SPARSE_MATRIX_MAX_DIM (1 << 24)             // 行数、列数的上限
+#define SPARSE_MATRIX_MAX_THREADS 64
+#define SPARSE_MATRIX_PARALLEL_THRESHOLD (1 << 16)  // 非零元少于该数目时矩阵向量乘法只用一个线程
+
+    // 稀疏矩阵：行逻辑链接的顺序表（参见教材 5.3.2 的 RLSMatrix，即 CSR 格式）
+    // 第 r 行（从 0 开始）的非零元按列号递增存放在 cols、vals 的 [rpos[r], rpos[r + 1]) 中，rpos 共 mu + 1 项
+    // 逐个追加的三元组（教材中的 TSMatrix）先按追加的顺序暂存，压缩（CompressSparseMatrix）时用计数排序按行分桶、
+    // 再在行内按列排序，并将同一位置的元素相加、去掉零元；尚有未压缩的三元组时，读取矩阵的指令都返回 INFEASIBLE
+    class SparseMatrix : public ADTObject {
+    public:
+        bool initialized = false;
+        int mu = 0;                     // 行数
+        int nu = 0;                     // 列数
+        vector<int> rpos;               // 各行第一个非零元的位置
+        vector<int> cols;               // 非零元的列号（从 0 开始）
+        vector<ElemType> vals;          // 非零元的值
+        vector<int> pendingRows;        // 尚未压缩的三元组（行号、列号均从 0 开始）
+        vector<int> pendingCols;
+        vector<ElemType> pendingVals;
+
+        ADTObject *copy() override {
+            auto pastedObj = new SparseMatrix;
+            pastedObj->initialized = initialized;
+            pastedObj->mu = mu;
+            pastedObj->nu = nu;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "SparseMatrix";
+        }
+
+        ADTObject *clone() override {
+            auto clonedObj = new SparseMatrix;
+            clonedObj->initialized = initialized;
+            clonedObj->mu = mu;
+            clonedObj->nu = nu;
+            clonedObj->rpos = rpos;
+            clonedObj->cols = cols;
+            clonedObj->vals = vals;
+            clonedObj->pendingRows = pendingRows;
+            clonedObj->pendingCols = pendingCols;
+            clonedObj->pendingVals = pendingVals;
+            return clonedObj;
+        }
+
+        void release() override {
+            vector<int>().swap(rpos);
+            vector<int>().swap(cols);
+            vector<ElemType>().swap(vals);
+            vector<int>().swap(pendingRows);
+            vector<int>().swap(pendingCols);
+            vector<ElemType>().swap(pendingVals);
+            initialized = false;
+            mu = nu = 0;
+        }
+
+        // 格式：是否已初始化、行数、列数、非零元个数、rpos、各非零元的列号和值、未压缩的三元组个数及其行号、列号和值
+        void serialize(string &out) override {
+            putU8(out, initialized);
+            putI32(out, mu);
+            putI32(out, nu);
+            putU32(out, (uint32_t) cols.size());
+            putI32Array(out, rpos.data(), (int) rpos.size());
+            putI32Array(out, cols.data(), (int) cols.size());
+            putI32Array(out, vals.data(), (int) vals.size());
+            putU32(out, (uint32_t) pendingRows.size());
+            putI32Array(out, pendingRows.data(), (int) pendingRows.size());
+            putI32Array(out, pendingCols.data(), (int) pendingCols.size());
+            putI32Array(out, pendingVals.data(), (int) pendingVals.size());
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            initialized = in.getU8() != 0;
+            mu = in.getI32();
+            nu = in.getI32();
+            uint32_t nnz = in.getU32();
+            if (!in.ok || mu < 0 || mu > SPARSE_MATRIX_MAX_DIM || nu < 0 || nu > SPARSE_MATRIX_MAX_DIM ||
+                nnz > INT_MAX || !in.require(((size_t) mu + 1 + (size_t) nnz * 2) * sizeof(int32_t))) {
+                return false;
+            }
+            if (!initialized) return true;
+            rpos.resize((size_t) mu + 1);
+            cols.resize(nnz);
+            vals.resize(nnz);
+            if (!in.getI32Array(rpos.data(), mu + 1) || !in.getI32Array(cols.data(), (int) nnz) ||
+                !in.getI32Array(vals.data(), (int) nnz)) {
+                return false;
+            }
+            if (rpos[0] != 0 || rpos[mu] != (int) nnz) return false;
+            for (int r = 0; r < mu; ++r) {
+                if (rpos[r] > rpos[r + 1]) return false;
+            }
+            for (auto col : cols) {
+                if (col < 0 || col >= nu) return false;
+            }
+            uint32_t pending = in.getU32();
+            if (!in.ok || pending > INT_MAX || !in.require((size_t) pending * 3 * sizeof(int32_t))) return false;
+            pendingRows.resize(pending);
+            pendingCols.resize(pending);
+            pendingVals.resize(pending);
+            if (!in.getI32Array(pendingRows.data(), (int) pending) || !in.getI32Array(pendingCols.data(), (int) pending) ||
+                !in.getI32Array(pendingVals.data(), (int) pending)) {
+                return false;
+            }
+            for (uint32_t k = 0; k < pending; ++k) {
+                if (pendingRows[k] < 0 || pendingRows[k] >= mu || pendingCols[k] < 0 || pendingCols[k] >= nu) return false;
+            }
+            return true;
+        }
+
+        int nonZeroCount() const {
+            return (int) cols.size();
+        }
+
+        bool compressed() const {
+            return pendingRows.empty();
+        }
+
+        // 初始化为 rows 行、columns 列的零矩阵
+        void reset(int rows, int columns) {
+            release();
+            initialized = true;
+            mu = rows;
+            nu = columns;
+            rpos.assign((size_t) rows + 1, 0);
+        }
+
+        void append(int row, int col, ElemType e) {
+            pendingRows.push_back(row);
+            pendingCols.push_back(col);
+            pendingVals.push_back(e);
+        }
+
+        // 丢弃第 count 个之后追加的未压缩三元组
+        void truncatePending(size_t count) {
+            pendingRows.resize(count);
+            pendingCols.resize(count);
+            pendingVals.resize(count);
+        }
+
+        // 将未压缩的三元组并入 CSR：已有的非零元与新三元组一起按行分桶（计数排序，保持先后顺序），
+        // 再在每行内按列排序，同一位置的元素相加，和为 0 的不再保存；和溢出时返回 OVERFLOW，矩阵保持不变
+        Status compress() {
+            int nnz = nonZeroCount();
+            size_t total = (size_t) nnz + pendingRows.size();
+            if (total > INT_MAX) {
+                return DSCxx_OVERFLOW;
+            }
+            vector<int> count((size_t) mu + 1, 0);
+            for (int r = 0; r < mu; ++r) {
+                count[r + 1] = rpos[r + 1] - rpos[r];
+            }
+            for (auto row : pendingRows) {
+                ++count[row + 1];
+            }
+            for (int r = 0; r < mu; ++r) {
+                count[r + 1] += count[r];
+            }
+            vector<pair<int, ElemType>> entries(total);
+            vector<int> next(count.begin(), count.end() - 1);
+            for (int r = 0; r < mu; ++r) {
+                for (int k = rpos[r]; k < rpos[r + 1]; ++k) {
+                    entries[next[r]++] = { cols[k], vals[k] };
+                }
+            }
+            for (size_t k = 0; k < pendingRows.size(); ++k) {
+                entries[next[pendingRows[k]]++] = { pendingCols[k], pendingVals[k] };
+            }
+            vector<int> newRpos((size_t) mu + 1, 0);
+            vector<int> newCols;
+            vector<ElemType> newVals;
+            newCols.reserve(total);
+            newVals.reserve(total);
+            for (int r = 0; r < mu; ++r) {
+                if (r % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return DSCxx_INFEASIBLE;
+                }
+                auto first = entries.begin() + count[r], last = entries.begin() + count[r + 1];
+                // 只有本行追加过三元组时才可能无序
+                if (last - first > 1 && !is_sorted(first, last)) {
+                    sort(first, last);
+                }
+                for (auto p = first; p != last;) {
+                    int col = p->first;
+                    int64_t sum = 0;
+                    for (; p != last && p->first == col; ++p) {
+                        sum += p->second;
+                    }
+                    if (sum > INT_MAX || sum < INT_MIN) {
+                        return DSCxx_OVERFLOW;
+                    }
+                    if (sum != 0) {
+                        newCols.push_back(col);
+                        newVals.push_back((ElemType) sum);
+                    }
+                }
+                newRpos[r + 1] = (int) newCols.size();
+            }
+            rpos.swap(newRpos);
+            cols.swap(newCols);
+            vals.swap(newVals);
+            vector<int>().swap(pendingRows);
+            vector<int>().swap(pendingCols);
+            vector<ElemType>().swap(pendingVals);
+            return DSCxx_OK;
+        }
+
+        // 第 row 行、第 col 列（均从 0 开始）的元素，行内二分查找
+        ElemType at(int row, int col) const {
+            auto first = cols.begin() + rpos[row], last = cols.begin() + rpos[row + 1];
+            auto p = lower_bound(first, last, col);
+            return (p != last && *p == col) ? vals[p - cols.begin()] : 0;
+        }
+    };
+
+    // 计算 y 中第 rowBegin ~ rowEnd - 1 行的结果；token 为发起计算的线程的取消标记（工作线程自己的为空）
+    inline Status SparseMatrixMultRows(const SparseMatrix &M, const ElemType *x, ElemType *y,
+                                       int rowBegin, int rowEnd, const atomic<bool> *token) {
+        const int *rpos = M.rpos.data();
+        const int *cols = M.cols.data();
+        const ElemType *vals = M.vals.data();
+        for (int r = rowBegin; r < rowEnd; ++r) {
+            if ((r - rowBegin) % CANCELLATION_CHUNK_SIZE == 0 && token != nullptr && token->load(memory_order_relaxed)) {
+                return DSCxx_INFEASIBLE;
+            }
+            int64_t sum = 0;
+            for (int k = rpos[r]; k < rpos[r + 1]; ++k) {
+                sum += (int64_t) vals[k] * x[cols[k]];
+            }
+            if (sum > INT_MAX || sum < INT_MIN) {
+                return DSCxx_OVERFLOW;
+            }
+            y[r] = (ElemType) sum;
+        }
+        return DSCxx_OK;
+    }
+
+    // y = M * x，按行分块多线程计算：各块的非零元个数大致相同，每个线程只写自己的那些行，不需要同步
+    // threads 为 0 时使用全部硬件线程；非零元较少时只用一个线程，此时创建线程的开销会超过计算本身
+    inline Status MultSparseMatrixVector_RL(const SparseMatrix &M, const ElemType *x, ElemType *y, int threads) {
+        if (threads <= 0) {
+            threads = (int) thread::hardware_concurrency();
+        }
+        threads = max(1, min(threads, SPARSE_MATRIX_MAX_THREADS));
+        threads = min(threads, max(M.mu, 1));
+        int nnz = M.nonZeroCount();
+        if (nnz < SPARSE_MATRIX_PARALLEL_THRESHOLD) {
+            threads = 1;
+        }
+        auto token = CancellationToken::current();
+        if (threads == 1) {
+            return SparseMatrixMultRows(M, x, y, 0, M.mu, token);
+        }
+        // 第 t 块从第一个 rpos 超过 t * nnz / threads 的行的前一行开始
+        vector<int> bounds((size_t) threads + 1);
+        bounds[0] = 0;
+        bounds[threads] = M.mu;
+        for (int t = 1; t < threads; ++t) {
+            int target = (int) ((int64_t) nnz * t / threads);
+            int row = (int) (upper_bound(M.rpos.begin(), M.rpos.end(), target) - M.rpos.begin()) - 1;
+            bounds[t] = max(bounds[t - 1], min(row, M.mu));
+        }
+        vector<Status> results((size_t) threads, DSCxx_OK);
+        vector<thread> workers;
+        workers.reserve((size_t) threads - 1);
+        for (int t = 1; t < threads; ++t) {
+            workers.emplace_back([&, t]() {
+                results[t] = SparseMatrixMultRows(M, x, y, bounds[t], bounds[t + 1], token);
+            });
+        }
+        results[0] = SparseMatrixMultRows(M, x, y, bounds[0], bounds[1], token);
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        for (auto result : results) {
+            if (result != DSCxx_OK) return result;
+        }
+        return DSCxx_OK;
+    }
+
+    // 快速转置（参见教材算法 5.2）：先统计 M 中每列的非零元个数，得到各列在 T 中的起始位置，
+    // 再按行扫描一遍 M，依次放到对应的位置上；按行扫描保证了 T 中每行的非零元仍按列号递增
+    inline void FastTransposeSMatrix(const SparseMatrix &M, SparseMatrix &T) {
+        int nnz = M.nonZeroCount();
+        vector<int> cpot((size_t) M.nu + 1, 0);
+        for (int k = 0; k < nnz; ++k) {
+            ++cpot[M.cols[k] + 1];
+        }
+        for (int c = 0; c < M.nu; ++c) {
+            cpot[c + 1] += cpot[c];
+        }
+        vector<int> cols((size_t) nnz);
+        vector<ElemType> vals((size_t) nnz);
+        vector<int> next(cpot.begin(), cpot.end() - 1);
+        for (int r = 0; r < M.mu; ++r) {
+            for (int k = M.rpos[r]; k < M.rpos[r + 1]; ++k) {
+                int q = next[M.cols[k]]++;
+                cols[q] = r;
+                vals[q] = M.vals[k];
+            }
+        }
+        // T 可能就是 M，所以全部算完之后才写入
+        int mu = M.nu, nu = M.mu;
+        T.reset(mu, nu);
+        T.rpos.swap(cpot);
+        T.cols.swap(cols);
+        T.vals.swap(vals);
+    }
+
+    // C = A + B：逐行按列号归并，和为 0 的元素不再保存；和溢出时返回 OVERFLOW，C 保持不变
+    inline Status AddSMatrix(const SparseMatrix &A, const SparseMatrix &B, SparseMatrix &C) {
+        vector<int> rpos((size_t) A.mu + 1, 0);
+        vector<int> cols;
+        vector<ElemType> vals;
+        cols.reserve((size_t) A.nonZeroCount() + B.nonZeroCount());
+        vals.reserve((size_t) A.nonZeroCount() + B.nonZeroCount());
+        for (int r = 0; r < A.mu; ++r) {
+            if (r % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                return DSCxx_INFEASIBLE;
+            }
+            int i = A.rpos[r], iEnd = A.rpos[r + 1];
+            int j = B.rpos[r], jEnd = B.rpos[r + 1];
+            while (i < iEnd || j < jEnd) {
+                int ci = (i < iEnd) ? A.cols[i] : INT_MAX;
+                int cj = (j < jEnd) ? B.cols[j] : INT_MAX;
+                int64_t sum;
+                int col;
+                if (ci < cj) {
+                    col = ci;
+                    sum = A.vals[i++];
+                }
+                else if (cj < ci) {
+                    col = cj;
+                    sum = B.vals[j++];
+                }
+                else {
+                    col = ci;
+                    sum = (int64_t) A.vals[i++] + B.vals[j++];
+                }
+                if (sum > INT_MAX || sum < INT_MIN) {
+                    return DSCxx_OVERFLOW;
+                }
+                if (sum != 0) {
+                    cols.push_back(col);
+                    vals.push_back((ElemType) sum);
+                }
+            }
+            rpos[r + 1] = (int) cols.size();
+        }
+        // C 可能就是 A 或 B
+        int mu = A.mu, nu = A.nu;
+        C.reset(mu, nu);
+        C.rpos.swap(rpos);
+        C.cols.swap(cols);
+        C.vals.swap(vals);
+        return DSCxx_OK;
+    }
+
+    // 初始化为 mu 行、nu 列的零矩阵（原有的元素被丢弃）
+    class InitSparseMatrix : public Function {
+    ENABLE_SINGLETON(InitSparseMatrix)
+    SIGNATURE(ADT_ARG(SparseMatrix), INT_ARG, INT_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pMatrix = args.adt<SparseMatrix>(0);
+            int mu = args.value(1);
+            int nu = args.value(2);
+            if (mu < 1 || mu > SPARSE_MATRIX_MAX_DIM || nu < 1 || nu > SPARSE_MATRIX_MAX_DIM) {
+                return DSCxx_ERROR;
+            }
+            pMatrix->reset(mu, nu);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(InitSparseMatrix)
+
+    class DestroySparseMatrix : public Function {
+    ENABLE_SINGLETON(DestroySparseMatrix)
+    SIGNATURE(ADT_ARG(SparseMatrix))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pMatrix = args.adt<SparseMatrix>(0);
+            if (!pMatrix->initialized) {
+                return DSCxx_ERROR;
+            }
+            pMatrix->release();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DestroySparseMatrix)
+
+    // 追加一个三元组（第 i 行、第 j 列的元素加上 e，位序从 1 开始），压缩之后才生效
+    class SparseMatrixAppend : public Function {
+    ENABLE_SINGLETON(SparseMatrixAppend)
+    SIGNATURE(ADT_ARG(SparseMatrix), INT_ARG, INT_ARG, INT_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pMatrix = args.adt<SparseMatrix>(0);
+            int i = args.value(1);
+            int j = args.value(2);
+            if (!pMatrix->initialized || i < 1 || i > pMatrix->mu || j < 1 || j > pMatrix->nu) {
+                return DSCxx_ERROR;
+            }
+            pMatrix->append(i - 1, j - 1, args.value(3));
+            return DSCxx_OK;
+        }
+
+        // 只向未压缩的三元组末尾追加，撤销时截断回原来的个数
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            size_t pending = args.adt<SparseMatrix>(0)->pendingRows.size();
+            steps.push_back({ 0, [pending](ADTObject *obj) {
+                static_cast<SparseMatrix *>(obj)->truncatePending(pending);
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(SparseMatrixAppend)
+
+    // 将三元组数组中的全部三元组（行号、列号、值，位序从 1 开始）追加到矩阵中；有越界的三元组时返回 ERROR，不追加任何三元组
+    class AppendTripletArrayToSparseMatrix : public Function {
+    ENABLE_SINGLETON(AppendTripletArrayToSparseMatrix)
+    SIGNATURE(ADT_ARG(SparseMatrix), ADT_ARG(TripletArray))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pMatrix = args.adt<SparseMatrix>(0);
+            auto pArray = args.adt<TripletArray>(1);
+            if (!pMatrix->initialized || pArray->e1 == nullptr) {
+                return DSCxx_ERROR;
+            }
+            for (int k = 0; k < pArray->length; ++k) {
+                if (pArray->e1[k] < 1 || pArray->e1[k] > pMatrix->mu || pArray->e2[k] < 1 || pArray->e2[k] > pMatrix->nu) {
+                    return DSCxx_ERROR;
+                }
+            }
+            for (int k = 0; k < pArray->length; ++k) {
+                pMatrix->append(pArray->e1[k] - 1, pArray->e2[k] - 1, pArray->e3[k]);
+            }
+            return DSCxx_OK;
+        }
+
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            size_t pending = args.adt<SparseMatrix>(0)->pendingRows.size();
+            steps.push_back({ 0, [pending](ADTObject *obj) {
+                static_cast<SparseMatrix *>(obj)->truncatePending(pending);
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(AppendTripletArrayToSparseMatrix)
+
+    class CompressSparseMatrix : public Function {
+    ENABLE_SINGLETON(CompressSparseMatrix)
+    SIGNATURE(ADT_ARG(SparseMatrix))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pMatrix = args.adt<SparseMatrix>(0);
+            if (!pMatrix->initialized) {
+                return DSCxx_ERROR;
+            }
+            return pMatrix->compress();
+        }
+    };
+
+    SINGLETON_MEMBER(CompressSparseMatrix)
+
+    class SparseMatrixNonZeroCount : public Function {
+    ENABLE_SINGLETON(SparseMatrixNonZeroCount)
+    SIGNATURE(ADT_ARG(SparseMatrix))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pMatrix = args.adt<SparseMatrix>(0);
+            if (!pMatrix->initialized) {
+                return DSCxx_ERROR;
+            }
+            if (!pMatrix->compressed()) {
+                return DSCxx_INFEASIBLE;
+            }
+            return pMatrix->nonZeroCount();
+        }
+    };
+
+    SINGLETON_MEMBER(SparseMatrixNonZeroCount)
+
+    // 用 e 返回第 i 行、第 j 列的元素
+    class GetElemInSparseMatrix : public Function {
+    ENABLE_SINGLETON(GetElemInSparseMatrix)
+    SIGNATURE(ADT_ARG(SparseMatrix), INT_ARG, INT_ARG, VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pMatrix = args.adt<SparseMatrix>(0);
+            int i = args.value(1);
+            int j = args.value(2);
+            if (!pMatrix->initialized || i < 1 || i > pMatrix->mu || j < 1 || j > pMatrix->nu) {
+                return DSCxx_ERROR;
+            }
+            if (!pMatrix->compressed()) {
+                return DSCxx_INFEASIBLE;
+            }
+            *args.var(3) = pMatrix->at(i - 1, j - 1);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(GetElemInSparseMatrix)
+
+    // T = M 的转置，T 可以就是 M
+    class TransposeSparseMatrix : public Function {
+    ENABLE_SINGLETON(TransposeSparseMatrix)
+    SIGNATURE(ADT_ARG(SparseMatrix), ADT_ARG(SparseMatrix))
+    SNAPSHOT_ARGS(1)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pMatrix = args.adt<SparseMatrix>(0);
+            auto pTarget = args.adt<SparseMatrix>(1);
+            if (!pMatrix->initialized) {
+                return DSCxx_ERROR;
+            }
+            if (!pMatrix->compressed()) {
+                return DSCxx_INFEASIBLE;
+            }
+            FastTransposeSMatrix(*pMatrix, *pTarget);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(TransposeSparseMatrix)
+
+    // C = A + B，A、B 的行数、列数必须相同，C 可以就是 A 或 B
+    class AddSparseMatrix : public Function {
+    ENABLE_SINGLETON(AddSparseMatrix)
+    SIGNATURE(ADT_ARG(SparseMatrix), ADT_ARG(SparseMatrix), ADT_ARG(SparseMatrix))
+    SNAPSHOT_ARGS(2)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pA = args.adt<SparseMatrix>(0);
+            auto pB = args.adt<SparseMatrix>(1);
+            auto pC = args.adt<SparseMatrix>(2);
+            if (!pA->initialized || !pB->initialized || pA->mu != pB->mu || pA->nu != pB->nu) {
+                return DSCxx_ERROR;
+            }
+            if (!pA->compressed() || !pB->compressed()) {
+                return DSCxx_INFEASIBLE;
+            }
+            return AddSMatrix(*pA, *pB, *pC);
+        }
+    };
+
+    SINGLETON_MEMBER(AddSparseMatrix)
+
+    // Y = M * X：X 的长度必须等于 M 的列数，结果存入线性表 Y（原有内容被覆盖，长度为 M 的行数），Y 可以就是 X
+    // Threads 为使用的线程数，为 0 时使用全部硬件线程；某一行的结果溢出时返回 OVERFLOW，此时 Y 的内容未定义
+    class MultSparseMatrixVector : public Function {
+    ENABLE_SINGLETON(MultSparseMatrixVector)
+    SIGNATURE(ADT_ARG(SparseMatrix), ADT_FAMILY_ARG(SequenceList), ADT_ARG(SequenceList), INT_ARG)
+    SNAPSHOT_ARGS(2)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pMatrix = args.adt<SparseMatrix>(0);
+            auto pX = args.adt<SequenceList>(1);
+            auto pY = args.adt<SequenceList>(2);
+            int threads = args.value(3);
+            if (!pMatrix->initialized || pX->elem == nullptr || pX->length != pMatrix->nu || threads < 0) {
+                return DSCxx_ERROR;
+            }
+            if (!pMatrix->compressed()) {
+                return DSCxx_INFEASIBLE;
+            }
+            // Y 就是 X 时先复制一份 X，结果写入 Y 的过程中不能修改 X
+            vector<ElemType> buffer;
+            const ElemType *x = pX->elem;
+            if (pX == pY) {
+                buffer.assign(pX->elem, pX->elem + pX->length);
+                x = buffer.data();
+            }
+            if (ResizeSequenceList(pY, pMatrix->mu) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            return MultSparseMatrixVector_RL(*pMatrix, x, pY->elem, threads);
+        }
+    };
+
+    SINGLETON_MEMBER(MultSparseMatrixVector)
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+// DataStructure_Cxx 的类型化接口：链接 CMake 中的 dscxx 库（只有头文件）后包含本文件，
+// 即可直接以对象和整数调用各个数据结构的操作，不需要经过 Interactor 的解析、查找和分派，例如：
+//
+//     DataStructure_Cxx::SequenceList L;
+//     InitList_Sq(L);
+//     ListInsert_Sq(L, 1, 42);
+//
+// 函数的返回值与对应的指令相同（参见 Common.h 中的 Status）
+
+#include "List/SequenceListCore.hpp"
+#include "Triplet/TripletCore.hpp"
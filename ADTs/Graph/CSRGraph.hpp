@@ -0,0 +1,645 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "List/SequenceList.hpp"
+#include "Queue/PriorityQueue.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace DataStructure_Cxx {
+
+#define CSR_GRAPH_MAX_VERTICES (1 << 28)
+#define CSR_GRAPH_MAX_THREADS 64
+#define CSR_GRAPH_PARALLEL_THRESHOLD (1 << 14)  // 一步要处理的顶点数或边数少于该数目时只用一个线程
+#define CSR_GRAPH_BFS_ALPHA 14                  // 方向优化 BFS 的切换参数（参见 Beamer 等人的论文）
+#define CSR_GRAPH_BFS_BETA 24
+
+    // 以压缩稀疏行（CSR）形式存储的图：顶点 v（从 0 开始）的出边终点依次存放在 adj 的 [offsets[v], offsets[v + 1]) 中，
+    // 相当于把邻接表（参见教材 7.2.2）的所有边结点按顶点顺序排进一个数组，遍历时顺序访问内存
+    // 有向图还保存反向的 CSR（每个顶点的入边起点），供自底向上的 BFS 使用；无向图的每条边在两个端点各存一次，
+    // 入边与出边相同。带权图的权值存放在与 adj 对应的 weights 中，必须非负；不带权时每条边的权值都视为 1
+    // 图只能整体构建（BuildCSRGraph），构建后不再修改；顶点的位序从 1 开始
+    class CSRGraph : public ADTObject {
+    public:
+        bool initialized = false;
+        bool directed = false;
+        int vexnum = 0;                 // 顶点数
+        int arcnum = 0;                 // 构建时给出的边数（无向图的每条边只计一次）
+        vector<int> offsets;
+        vector<int> adj;
+        vector<ElemType> weights;       // 不带权时为空
+        vector<int> inOffsets;          // 反向的 CSR，只有有向图才有
+        vector<int> inAdj;
+
+        ADTObject *copy() override {
+            auto pastedObj = new CSRGraph;
+            pastedObj->initialized = initialized;
+            pastedObj->directed = directed;
+            pastedObj->vexnum = vexnum;
+            pastedObj->arcnum = arcnum;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "CSRGraph";
+        }
+
+        ADTObject *clone() override {
+            auto clonedObj = new CSRGraph;
+            clonedObj->initialized = initialized;
+            clonedObj->directed = directed;
+            clonedObj->vexnum = vexnum;
+            clonedObj->arcnum = arcnum;
+            clonedObj->offsets = offsets;
+            clonedObj->adj = adj;
+            clonedObj->weights = weights;
+            clonedObj->inOffsets = inOffsets;
+            clonedObj->inAdj = inAdj;
+            return clonedObj;
+        }
+
+        void release() override {
+            vector<int>().swap(offsets);
+            vector<int>().swap(adj);
+            vector<ElemType>().swap(weights);
+            vector<int>().swap(inOffsets);
+            vector<int>().swap(inAdj);
+            initialized = directed = false;
+            vexnum = arcnum = 0;
+        }
+
+        // 格式：是否已初始化、是否有向、是否带权、顶点数、边数、offsets、adj、weights（反向的 CSR 在恢复时重新计算）
+        void serialize(string &out) override {
+            putU8(out, initialized);
+            putU8(out, directed);
+            putU8(out, !weights.empty());
+            putI32(out, vexnum);
+            putI32(out, arcnum);
+            putU32(out, (uint32_t) adj.size());
+            putI32Array(out, offsets.data(), offsets.size());
+            putI32Array(out, adj.data(), adj.size());
+            putI32Array(out, weights.data(), weights.size());
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            initialized = in.getU8() != 0;
+            directed = in.getU8() != 0;
+            bool weighted = in.getU8() != 0;
+            vexnum = in.getI32();
+            arcnum = in.getI32();
+            uint32_t size = in.getU32();
+            if (!in.ok || vexnum < 0 || vexnum > CSR_GRAPH_MAX_VERTICES || arcnum < 0 || size > INT_MAX ||
+                !in.require(((size_t) vexnum + 1 + (size_t) size * (weighted ? 2 : 1)) * sizeof(int32_t))) {
+                return false;
+            }
+            if (!initialized) return true;
+            offsets.resize((size_t) vexnum + 1);
+            adj.resize(size);
+            weights.resize(weighted ? size : 0);
+            if (!in.getI32Array(offsets.data(), offsets.size()) || !in.getI32Array(adj.data(), adj.size()) ||
+                !in.getI32Array(weights.data(), weights.size())) {
+                return false;
+            }
+            if (offsets[0] != 0 || offsets[vexnum] != (int) size) return false;
+            for (int v = 0; v < vexnum; ++v) {
+                if (offsets[v] > offsets[v + 1]) return false;
+            }
+            for (auto w : adj) {
+                if (w < 0 || w >= vexnum) return false;
+            }
+            for (auto weight : weights) {
+                if (weight < 0) return false;
+            }
+            if (directed) buildReverse();
+            return true;
+        }
+
+        int arcCount() const {
+            return (int) adj.size();
+        }
+
+        int outDegree(int v) const {
+            return offsets[v + 1] - offsets[v];
+        }
+
+        const int *inBegin(int v) const {
+            return directed ? inAdj.data() + inOffsets[v] : adj.data() + offsets[v];
+        }
+
+        const int *inEnd(int v) const {
+            return directed ? inAdj.data() + inOffsets[v + 1] : adj.data() + offsets[v + 1];
+        }
+
+        // 由 n 个顶点、count 条边（起点 tails、终点 heads，均从 0 开始）构建，weight 为空时不带权
+        // 按起点计数排序，同一顶点的出边保持给出的顺序
+        void build(int n, const ElemType *tails, const ElemType *heads, const ElemType *weight, int count, bool isDirected) {
+            release();
+            initialized = true;
+            directed = isDirected;
+            vexnum = n;
+            arcnum = count;
+            size_t arcs = isDirected ? (size_t) count : (size_t) count * 2;
+            offsets.assign((size_t) n + 1, 0);
+            adj.resize(arcs);
+            if (weight != nullptr) weights.resize(arcs);
+            for (int k = 0; k < count; ++k) {
+                ++offsets[tails[k] + 1];
+                if (!isDirected) ++offsets[heads[k] + 1];
+            }
+            for (int v = 0; v < n; ++v) {
+                offsets[v + 1] += offsets[v];
+            }
+            vector<int> next(offsets.begin(), offsets.end() - 1);
+            for (int k = 0; k < count; ++k) {
+                int q = next[tails[k]]++;
+                adj[q] = heads[k];
+                if (weight != nullptr) weights[q] = weight[k];
+                if (!isDirected) {
+                    q = next[heads[k]]++;
+                    adj[q] = tails[k];
+                    if (weight != nullptr) weights[q] = weight[k];
+                }
+            }
+            if (isDirected) buildReverse();
+        }
+
+        // 由出边的 CSR 计算入边的 CSR（即转置），按起点顺序扫描，每个顶点的入边按起点递增
+        void buildReverse() {
+            inOffsets.assign((size_t) vexnum + 1, 0);
+            inAdj.resize(adj.size());
+            for (auto w : adj) {
+                ++inOffsets[w + 1];
+            }
+            for (int v = 0; v < vexnum; ++v) {
+                inOffsets[v + 1] += inOffsets[v];
+            }
+            vector<int> next(inOffsets.begin(), inOffsets.end() - 1);
+            for (int v = 0; v < vexnum; ++v) {
+                for (int k = offsets[v]; k < offsets[v + 1]; ++k) {
+                    inAdj[next[adj[k]]++] = v;
+                }
+            }
+        }
+    };
+
+    // 将 [0, n) 均分给若干个线程执行 body(begin, end, t)，t 为线程的序号（0 号在调用者的线程中执行）
+    // work 为这一步的总工作量，少于 CSR_GRAPH_PARALLEL_THRESHOLD 时直接在调用者的线程中执行
+    template<typename Body>
+    inline void CSRGraphParallelFor(int threads, int n, int64_t work, Body body) {
+        if (threads <= 1 || n <= 1 || work < CSR_GRAPH_PARALLEL_THRESHOLD) {
+            body(0, n, 0);
+            return;
+        }
+        threads = min(threads, n);
+        vector<thread> workers;
+        workers.reserve((size_t) threads - 1);
+        for (int t = 1; t < threads; ++t) {
+            workers.emplace_back(body, (int) ((int64_t) n * t / threads), (int) ((int64_t) n * (t + 1) / threads), t);
+        }
+        body(0, (int) ((int64_t) n / threads), 0);
+        for (auto &worker : workers) {
+            worker.join();
+        }
+    }
+
+    inline int CSRGraphThreads(int threads) {
+        if (threads <= 0) {
+            threads = (int) thread::hardware_concurrency();
+        }
+        return max(1, min(threads, CSR_GRAPH_MAX_THREADS));
+    }
+
+    // 广度优先搜索：dist 中存放各顶点到 source 的边数，不可达的为 -1，返回可达的顶点数（含 source），被取消时返回 -1
+    // 自顶向下的一步从当前层的每个顶点出发检查出边，新访问的顶点用 CAS 认领，保证只被一个线程加入下一层；
+    // directionOptimizing 为 true 时，当前层的出边数超过未访问顶点的边数的 1/ALPHA 后改为自底向上：
+    // 每个未访问的顶点检查入边，找到一个在当前层中的起点即可停止，下一层的顶点数少于 n/BETA 时再改回自顶向下
+    inline int CSRGraphBFS(const CSRGraph &G, int source, ElemType *dist, int threads, bool directionOptimizing) {
+        int n = G.vexnum;
+        auto token = CancellationToken::current();
+        auto cancelled = [token]() { return token != nullptr && token->load(memory_order_relaxed); };
+        unique_ptr<atomic<int>[]> level(new atomic<int>[n]);
+        for (int v = 0; v < n; ++v) {
+            level[v].store(-1, memory_order_relaxed);
+        }
+        vector<int> frontier{ source };
+        vector<uint8_t> inFrontier, inNext;     // 自底向上时当前层、下一层的位图
+        vector<vector<int>> localNext((size_t) threads);
+        vector<int64_t> localCount((size_t) threads);       // 自底向上时各线程找到的顶点数
+        vector<int64_t> localEdges((size_t) threads);       // 以及这些顶点的出边数
+        level[source].store(0, memory_order_relaxed);
+        int64_t edgesToCheck = G.arcCount() - G.outDegree(source);     // 尚未访问的顶点的出边数
+        int64_t frontierEdges = G.outDegree(source);
+        int64_t frontierSize = 1;
+        int reached = 1;
+        bool bottomUp = false;
+        for (int depth = 0; frontierSize > 0; ++depth) {
+            if (cancelled()) return -1;
+            if (directionOptimizing && !bottomUp && frontierEdges > edgesToCheck / CSR_GRAPH_BFS_ALPHA) {
+                bottomUp = true;
+                inFrontier.assign((size_t) n, 0);
+                inNext.assign((size_t) n, 0);
+                for (int v : frontier) inFrontier[v] = 1;
+            }
+            else if (bottomUp && frontierSize < n / CSR_GRAPH_BFS_BETA) {
+                bottomUp = false;
+                frontier.clear();
+                for (int v = 0; v < n; ++v) {
+                    if (inFrontier[v]) frontier.push_back(v);
+                }
+            }
+            fill(localCount.begin(), localCount.end(), 0);
+            fill(localEdges.begin(), localEdges.end(), 0);
+            if (bottomUp) {
+                CSRGraphParallelFor(threads, n, n, [&](int begin, int end, int t) {
+                    int64_t found = 0, edges = 0;
+                    for (int v = begin; v < end; ++v) {
+                        if ((v - begin) % CANCELLATION_CHUNK_SIZE == 0 && cancelled()) break;
+                        inNext[v] = 0;
+                        if (level[v].load(memory_order_relaxed) >= 0) continue;
+                        for (auto p = G.inBegin(v), last = G.inEnd(v); p != last; ++p) {
+                            if (inFrontier[*p]) {
+                                level[v].store(depth + 1, memory_order_relaxed);
+                                inNext[v] = 1;
+                                ++found;
+                                edges += G.outDegree(v);
+                                break;
+                            }
+                        }
+                    }
+                    localCount[t] = found;
+                    localEdges[t] = edges;
+                });
+                inFrontier.swap(inNext);
+                frontierSize = frontierEdges = 0;
+                for (int t = 0; t < threads; ++t) {
+                    frontierSize += localCount[t];
+                    frontierEdges += localEdges[t];
+                }
+            }
+            else {
+                int size = (int) frontier.size();
+                CSRGraphParallelFor(threads, size, frontierEdges + size, [&](int begin, int end, int t) {
+                    auto &next = localNext[t];
+                    next.clear();
+                    for (int i = begin; i < end; ++i) {
+                        if ((i - begin) % CANCELLATION_CHUNK_SIZE == 0 && cancelled()) break;
+                        int u = frontier[i];
+                        for (int k = G.offsets[u]; k < G.offsets[u + 1]; ++k) {
+                            int w = G.adj[k];
+                            int expected = -1;
+                            if (level[w].load(memory_order_relaxed) < 0 &&
+                                level[w].compare_exchange_strong(expected, depth + 1, memory_order_relaxed)) {
+                                next.push_back(w);
+                            }
+                        }
+                    }
+                });
+                frontier.clear();
+                frontierEdges = 0;
+                for (int t = 0; t < threads; ++t) {
+                    for (int w : localNext[t]) {
+                        frontier.push_back(w);
+                        frontierEdges += G.outDegree(w);
+                    }
+                    localNext[t].clear();
+                }
+                frontierSize = (int64_t) frontier.size();
+            }
+            reached += (int) frontierSize;
+            edgesToCheck -= frontierEdges;
+        }
+        if (cancelled()) return -1;
+        for (int v = 0; v < n; ++v) {
+            dist[v] = level[v].load(memory_order_relaxed);
+        }
+        return reached;
+    }
+
+    // 迪杰斯特拉算法（参见教材算法 7.15），用 d 叉堆（参见 PriorityQueue.hpp）选取距离最小的顶点：
+    // 全部顶点一次建堆，顶点 v 的句柄就是 v，松弛时直接按句柄上浮；不可达的顶点距离为 -1
+    // 超过 ElemType 范围的路径不参与松弛（它不会比已有的路径更短，除非该顶点没有其他路径）；
+    // 只有某个可达顶点的最短距离本身超出范围时才返回 OVERFLOW
+    inline Status ShortestPath_DIJ(const CSRGraph &G, int source, ElemType *dist, int arity) {
+        int n = G.vexnum;
+        vector<ElemType> initial((size_t) n, INT_MAX);
+        initial[source] = 0;
+        PriorityQueue heap;
+        heap.arity = arity;
+        if (!heap.heapify(initial.data(), n)) return DSCxx_INFEASIBLE;
+        vector<uint8_t> final((size_t) n, 0);
+        vector<uint8_t> skipped((size_t) n, 0);     // 曾有一条因超出范围而被跳过的路径
+        fill(dist, dist + n, -1);
+        for (int popped = 0; !heap.keys.empty(); ++popped) {
+            if (popped % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                return DSCxx_INFEASIBLE;
+            }
+            int u = heap.handles[0];
+            ElemType d = heap.pop();
+            if (d == INT_MAX) break;    // 剩下的顶点都不可达
+            final[u] = 1;
+            dist[u] = d;
+            for (int k = G.offsets[u]; k < G.offsets[u + 1]; ++k) {
+                int w = G.adj[k];
+                if (final[w]) continue;
+                int64_t nd = (int64_t) d + (G.weights.empty() ? 1 : G.weights[k]);
+                if (nd >= INT_MAX) {
+                    skipped[w] = 1;
+                    continue;
+                }
+                if (nd < heap.keys[heap.position[w]]) {
+                    heap.decreaseKey(w, (ElemType) nd);
+                }
+            }
+        }
+        for (int v = 0; v < n; ++v) {
+            if (skipped[v] && !final[v]) return DSCxx_OVERFLOW;
+        }
+        return DSCxx_OK;
+    }
+
+    // 并查集中 v 所在集合的根：parent 只会指向编号更小的顶点，所以沿途顺便把 v 指向祖父（路径减半）
+    inline int CSRGraphFindRoot(atomic<int> *parent, int v) {
+        while (true) {
+            int p = parent[v].load(memory_order_relaxed);
+            int gp = parent[p].load(memory_order_relaxed);
+            if (p == gp) return p;
+            parent[v].compare_exchange_weak(p, gp, memory_order_relaxed);
+            v = gp;
+        }
+    }
+
+    // 连通分量（有向图为弱连通分量）：无锁的并查集，各线程并行地合并自己那段顶点的出边两端，
+    // 合并时用 CAS 把编号较大的根指向较小的根，失败说明根已经变化，重新查找后再试
+    // comp 中存放各顶点所在分量的编号（按分量中最小顶点的顺序从 1 开始编号），返回分量个数，被取消时返回 -1
+    inline int CSRGraphComponents(const CSRGraph &G, ElemType *comp, int threads) {
+        int n = G.vexnum;
+        auto token = CancellationToken::current();
+        unique_ptr<atomic<int>[]> parent(new atomic<int>[n]);
+        for (int v = 0; v < n; ++v) {
+            parent[v].store(v, memory_order_relaxed);
+        }
+        atomic<bool> stopped{false};
+        CSRGraphParallelFor(threads, n, (int64_t) n + G.arcCount(), [&](int begin, int end, int) {
+            for (int u = begin; u < end; ++u) {
+                if ((u - begin) % CANCELLATION_CHUNK_SIZE == 0 && token != nullptr && token->load(memory_order_relaxed)) {
+                    stopped.store(true, memory_order_relaxed);
+                    return;
+                }
+                for (int k = G.offsets[u]; k < G.offsets[u + 1]; ++k) {
+                    int a = u, b = G.adj[k];
+                    while (true) {
+                        a = CSRGraphFindRoot(parent.get(), a);
+                        b = CSRGraphFindRoot(parent.get(), b);
+                        if (a == b) break;
+                        if (a < b) swap(a, b);
+                        int expected = a;
+                        if (parent[a].compare_exchange_strong(expected, b, memory_order_relaxed)) break;
+                    }
+                }
+            }
+        });
+        if (stopped.load()) return -1;
+        // 根是分量中编号最小的顶点，按顶点顺序扫描时总是先遇到根
+        int count = 0;
+        for (int v = 0; v < n; ++v) {
+            int root = CSRGraphFindRoot(parent.get(), v);
+            comp[v] = (root == v) ? ++count : comp[root];
+        }
+        return count;
+    }
+
+    // 从两个线性表 Tails、Heads 给出的 m 条边（第 k 条边为 Tails 的第 k 个元素指向 Heads 的第 k 个元素，顶点位序从 1 开始）
+    // 构建有 n 个顶点的图，directed 为 0 时为无向图；两个线性表长度不同或者有顶点越界时返回 ERROR
+    inline Status BuildCSRGraphFromLists(CSRGraph *pGraph, int n, const SequenceList *pTails, const SequenceList *pHeads,
+                                         const SequenceList *pWeights, bool directed) {
+        if (n < 1 || n > CSR_GRAPH_MAX_VERTICES || pTails->elem == nullptr || pHeads->elem == nullptr ||
+            pTails->length != pHeads->length) {
+            return DSCxx_ERROR;
+        }
+        int m = pTails->length;
+        if ((directed ? (int64_t) m : (int64_t) m * 2) > INT_MAX) {
+            return DSCxx_OVERFLOW;
+        }
+        if (pWeights != nullptr && (pWeights->elem == nullptr || pWeights->length != m)) {
+            return DSCxx_ERROR;
+        }
+        vector<ElemType> tails(pTails->elem, pTails->elem + m), heads(pHeads->elem, pHeads->elem + m);
+        for (int k = 0; k < m; ++k) {
+            if (tails[k] < 1 || tails[k] > n || heads[k] < 1 || heads[k] > n ||
+                (pWeights != nullptr && pWeights->elem[k] < 0)) {
+                return DSCxx_ERROR;
+            }
+            --tails[k];
+            --heads[k];
+        }
+        pGraph->build(n, tails.data(), heads.data(), pWeights != nullptr ? pWeights->elem : nullptr, m, directed);
+        return DSCxx_OK;
+    }
+
+    class BuildCSRGraph : public Function {
+    ENABLE_SINGLETON(BuildCSRGraph)
+    SIGNATURE(ADT_ARG(CSRGraph), INT_ARG, ADT_FAMILY_ARG(SequenceList), ADT_FAMILY_ARG(SequenceList), INT_ARG)
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            return BuildCSRGraphFromLists(args.adt<CSRGraph>(0), args.value(1), args.adt<SequenceList>(2),
+                                          args.adt<SequenceList>(3), nullptr, args.value(4) != 0);
+        }
+    };
+
+    SINGLETON_MEMBER(BuildCSRGraph)
+
+    // 同 BuildCSRGraph，第 k 条边的权值为线性表 Weights 的第 k 个元素，权值必须非负
+    class BuildWeightedCSRGraph : public Function {
+    ENABLE_SINGLETON(BuildWeightedCSRGraph)
+    SIGNATURE(ADT_ARG(CSRGraph), INT_ARG, ADT_FAMILY_ARG(SequenceList), ADT_FAMILY_ARG(SequenceList),
+              ADT_FAMILY_ARG(SequenceList), INT_ARG)
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            return BuildCSRGraphFromLists(args.adt<CSRGraph>(0), args.value(1), args.adt<SequenceList>(2),
+                                          args.adt<SequenceList>(3), args.adt<SequenceList>(4), args.value(5) != 0);
+        }
+    };
+
+    SINGLETON_MEMBER(BuildWeightedCSRGraph)
+
+    class DestroyCSRGraph : public Function {
+    ENABLE_SINGLETON(DestroyCSRGraph)
+    SIGNATURE(ADT_ARG(CSRGraph))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pGraph = args.adt<CSRGraph>(0);
+            if (!pGraph->initialized) {
+                return DSCxx_ERROR;
+            }
+            pGraph->release();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DestroyCSRGraph)
+
+    class CSRGraphVertexCount : public Function {
+    ENABLE_SINGLETON(CSRGraphVertexCount)
+    SIGNATURE(ADT_ARG(CSRGraph))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pGraph = args.adt<CSRGraph>(0);
+            return pGraph->initialized ? pGraph->vexnum : DSCxx_ERROR;
+        }
+    };
+
+    SINGLETON_MEMBER(CSRGraphVertexCount)
+
+    class CSRGraphEdgeCount : public Function {
+    ENABLE_SINGLETON(CSRGraphEdgeCount)
+    SIGNATURE(ADT_ARG(CSRGraph))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pGraph = args.adt<CSRGraph>(0);
+            return pGraph->initialized ? pGraph->arcnum : DSCxx_ERROR;
+        }
+    };
+
+    SINGLETON_MEMBER(CSRGraphEdgeCount)
+
+    // 顶点 v 的出度（无向图为度）
+    class CSRGraphOutDegree : public Function {
+    ENABLE_SINGLETON(CSRGraphOutDegree)
+    SIGNATURE(ADT_ARG(CSRGraph), INT_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pGraph = args.adt<CSRGraph>(0);
+            int v = args.value(1);
+            if (!pGraph->initialized || v < 1 || v > pGraph->vexnum) {
+                return DSCxx_ERROR;
+            }
+            return pGraph->outDegree(v - 1);
+        }
+    };
+
+    SINGLETON_MEMBER(CSRGraphOutDegree)
+
+    // 从顶点 s 出发广度优先搜索，各顶点到 s 的边数存入线性表 Dist（原有内容被覆盖，不可达的为 -1），返回可达的顶点数
+    // Threads 为使用的线程数，为 0 时使用全部硬件线程
+    class BFSInCSRGraph : public Function {
+    ENABLE_SINGLETON(BFSInCSRGraph)
+    SIGNATURE(ADT_ARG(CSRGraph), INT_ARG, ADT_ARG(SequenceList), INT_ARG)
+    SNAPSHOT_ARGS(2)
+    VALUE_STATUS_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pGraph = args.adt<CSRGraph>(0);
+            int s = args.value(1);
+            auto pDist = args.adt<SequenceList>(2);
+            int threads = args.value(3);
+            if (!pGraph->initialized || s < 1 || s > pGraph->vexnum || threads < 0) {
+                return DSCxx_ERROR;
+            }
+            vector<ElemType> dist((size_t) pGraph->vexnum);
+            int reached = CSRGraphBFS(*pGraph, s - 1, dist.data(), CSRGraphThreads(threads), true);
+            if (reached < 0) {
+                return DSCxx_INFEASIBLE;
+            }
+            if (ResizeSequenceList(pDist, pGraph->vexnum) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            memcpy(pDist->elem, dist.data(), dist.size() * sizeof(ElemType));
+            return reached;
+        }
+    };
+
+    SINGLETON_MEMBER(BFSInCSRGraph)
+
+    // 从顶点 s 出发求到其余各顶点的最短路径长度，存入线性表 Dist（不可达的为 -1）；d 为堆的叉数，为 0 时使用默认的 4 叉堆
+    class DijkstraInCSRGraph : public Function {
+    ENABLE_SINGLETON(DijkstraInCSRGraph)
+    SIGNATURE(ADT_ARG(CSRGraph), INT_ARG, ADT_ARG(SequenceList), INT_ARG)
+    SNAPSHOT_ARGS(2)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pGraph = args.adt<CSRGraph>(0);
+            int s = args.value(1);
+            auto pDist = args.adt<SequenceList>(2);
+            int d = args.value(3) == 0 ? PRIORITY_QUEUE_DEFAULT_ARITY : args.value(3);
+            if (!pGraph->initialized || s < 1 || s > pGraph->vexnum || d < 2 || d > PRIORITY_QUEUE_MAX_ARITY) {
+                return DSCxx_ERROR;
+            }
+            vector<ElemType> dist((size_t) pGraph->vexnum);
+            Status result = ShortestPath_DIJ(*pGraph, s - 1, dist.data(), d);
+            if (result != DSCxx_OK) {
+                return result;
+            }
+            if (ResizeSequenceList(pDist, pGraph->vexnum) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            memcpy(pDist->elem, dist.data(), dist.size() * sizeof(ElemType));
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DijkstraInCSRGraph)
+
+    // 求连通分量（有向图为弱连通分量），各顶点所在分量的编号存入线性表 Comp，返回分量个数
+    class ConnectedComponentsInCSRGraph : public Function {
+    ENABLE_SINGLETON(ConnectedComponentsInCSRGraph)
+    SIGNATURE(ADT_ARG(CSRGraph), ADT_ARG(SequenceList), INT_ARG)
+    SNAPSHOT_ARGS(1)
+    VALUE_STATUS_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pGraph = args.adt<CSRGraph>(0);
+            auto pComp = args.adt<SequenceList>(1);
+            int threads = args.value(2);
+            if (!pGraph->initialized || threads < 0) {
+                return DSCxx_ERROR;
+            }
+            vector<ElemType> comp((size_t) pGraph->vexnum);
+            int count = CSRGraphComponents(*pGraph, comp.data(), CSRGraphThreads(threads));
+            if (count < 0) {
+                return DSCxx_INFEASIBLE;
+            }
+            if (ResizeSequenceList(pComp, pGraph->vexnum) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            memcpy(pComp->elem, comp.data(), comp.size() * sizeof(ElemType));
+            return count;
+        }
+    };
+
+    SINGLETON_MEMBER(ConnectedComponentsInCSRGraph)
+}
@@ -0,0 +1,501 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "SequenceList.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace DataStructure_Cxx {
+
+#define COMPRESSED_BLOCK_SIZE 128       // 每块的元素个数，最后不满一块的元素不压缩
+
+    // 压缩块的头部：块内的最小值、最大值用于查找时整块跳过，不需要解码
+    // 块内非递减时存储相邻元素之差（差分编码），否则存储与最小值之差（frame of reference），
+    // 两种情况下都只用 width 位存储每个差值（位压缩），有序的 ID 序列通常只需要几位
+    struct CompressedBlock {
+        ElemType min;
+        ElemType max;
+        ElemType first;     // 块内第一个元素，差分编码的起点
+        uint32_t offset;    // 压缩数据在 data 中的起始字节
+        uint8_t width;      // 每个差值占用的位数（0 ~ 32），压缩数据共 16 * width 字节
+        bool delta;         // 是否为差分编码
+    };
+
+    // 压缩数据采用 4 路交错的布局：第 k 个差值属于第 k % 4 路，每一路的 32 个差值各自连续地位压缩成 width 个 32 位字，
+    // 4 路的第 m 个字相邻存放，所以一条 128 位的 SIMD 指令可以同时解出相邻的 4 个差值
+    inline void PackCompressedBlock(const uint32_t *deltas, int width, uint8_t *out) {
+        uint32_t words[4 * 32] = {};
+        for (int i = 0; i < 32 && width > 0; ++i) {
+            int bit = i * width, m = bit >> 5, shift = bit & 31;
+            for (int lane = 0; lane < 4; ++lane) {
+                uint32_t v = deltas[4 * i + lane];
+                words[4 * m + lane] |= v << shift;
+                if (shift + width > 32) {
+                    words[4 * (m + 1) + lane] |= v >> (32 - shift);
+                }
+            }
+        }
+        memcpy(out, words, 16 * width);
+    }
+
+    inline void UnpackCompressedBlock(const uint8_t *in, int width, uint32_t *out) {
+        if (width == 0) {
+            memset(out, 0, COMPRESSED_BLOCK_SIZE * sizeof(uint32_t));
+            return;
+        }
+        uint32_t mask = (width == 32) ? 0xffffffffu : (1u << width) - 1;
+#ifdef __SSE2__
+        const __m128i vmask = _mm_set1_epi32((int) mask);
+        for (int i = 0; i < 32; ++i) {
+            int bit = i * width, m = bit >> 5, shift = bit & 31;
+            auto word = _mm_loadu_si128((const __m128i *) (in + 16 * m));
+            auto x = _mm_srl_epi32(word, _mm_cvtsi32_si128(shift));
+            if (shift + width > 32) {
+                auto next = _mm_loadu_si128((const __m128i *) (in + 16 * (m + 1)));
+                x = _mm_or_si128(x, _mm_sll_epi32(next, _mm_cvtsi32_si128(32 - shift)));
+            }
+            _mm_storeu_si128((__m128i *) (out + 4 * i), _mm_and_si128(x, vmask));
+        }
+#else
+        uint32_t words[4 * 32];
+        memcpy(words, in, 16 * width);
+        for (int i = 0; i < 32; ++i) {
+            int bit = i * width, m = bit >> 5, shift = bit & 31;
+            for (int lane = 0; lane < 4; ++lane) {
+                uint32_t x = words[4 * m + lane] >> shift;
+                if (shift + width > 32) {
+                    x |= words[4 * (m + 1) + lane] << (32 - shift);
+                }
+                out[4 * i + lane] = x & mask;
+            }
+        }
+#endif
+    }
+
+    // 压缩一整块元素，压缩数据追加到 data 的末尾
+    inline void EncodeCompressedBlock(const ElemType *values, CompressedBlock &block, vector<uint8_t> &data) {
+        uint32_t deltas[COMPRESSED_BLOCK_SIZE];
+        block.min = block.max = block.first = values[0];
+        block.delta = true;
+        for (int k = 1; k < COMPRESSED_BLOCK_SIZE; ++k) {
+            if (values[k] < block.min) block.min = values[k];
+            if (values[k] > block.max) block.max = values[k];
+            if (values[k] < values[k - 1]) block.delta = false;
+        }
+        // 差值按 32 位无符号数计算，解码时同样按模 2^32 相加，不会溢出
+        uint32_t bits = 0;
+        for (int k = 0; k < COMPRESSED_BLOCK_SIZE; ++k) {
+            uint32_t base = block.delta ? (uint32_t) (k > 0 ? values[k - 1] : values[0]) : (uint32_t) block.min;
+            deltas[k] = (uint32_t) values[k] - base;
+            bits |= deltas[k];
+        }
+        int width = 0;
+        while (width < 32 && (bits >> width) != 0) ++width;
+        block.width = (uint8_t) width;
+        block.offset = (uint32_t) data.size();
+        data.resize(data.size() + 16 * width);
+        PackCompressedBlock(deltas, width, data.data() + block.offset);
+    }
+
+    // 解码一整块元素：先用 SIMD 解出差值，再求前缀和（差分编码）或者加上最小值
+    inline void DecodeCompressedBlock(const CompressedBlock &block, const uint8_t *data, ElemType *out) {
+        auto values = reinterpret_cast<uint32_t *>(out);
+        UnpackCompressedBlock(data + block.offset, block.width, values);
+        if (block.delta) {
+#ifdef __SSE2__
+            // 每次求 4 个元素的前缀和，再加上前一组最后一个元素的值
+            auto carry = _mm_set1_epi32(block.first);
+            for (int k = 0; k < COMPRESSED_BLOCK_SIZE; k += 4) {
+                auto v = _mm_loadu_si128((const __m128i *) (values + k));
+                v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+                v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+                v = _mm_add_epi32(v, carry);
+                _mm_storeu_si128((__m128i *) (values + k), v);
+                carry = _mm_shuffle_epi32(v, 0xff);
+            }
+#else
+            uint32_t sum = (uint32_t) block.first;
+            for (int k = 0; k < COMPRESSED_BLOCK_SIZE; ++k) {
+                sum += values[k];
+                values[k] = sum;
+            }
+#endif
+        }
+        else {
+            uint32_t base = (uint32_t) block.min;
+            for (int k = 0; k < COMPRESSED_BLOCK_SIZE; ++k) {
+                values[k] += base;
+            }
+        }
+    }
+
+    // 压缩的整数序列：每 COMPRESSED_BLOCK_SIZE 个元素压缩为一块，只支持在尾部追加，
+    // 按位序取值时直接跳到所在的块解码，定位时根据块的最小值、最大值跳过不可能包含目标的块
+    class CompressedSequenceList : public ADTObject {
+    public:
+        bool initialized = false;
+        vector<CompressedBlock> blocks;
+        vector<uint8_t> data;
+        ElemType tail[COMPRESSED_BLOCK_SIZE];   // 尚未凑满一块的元素，以原样存放
+        int tailLength = 0;
+        int length = 0;
+        bool sorted = true;                     // 所有元素是否按值非递减排列，为 true 时定位可以二分查找块
+
+        ADTObject *copy() override {
+            auto pastedObj = new CompressedSequenceList;
+            pastedObj->initialized = initialized;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "CompressedSequenceList";
+        }
+
+        ADTObject *clone() override {
+            auto clonedObj = new CompressedSequenceList;
+            clonedObj->initialized = initialized;
+            clonedObj->blocks = blocks;
+            clonedObj->data = data;
+            memcpy(clonedObj->tail, tail, tailLength * sizeof(ElemType));
+            clonedObj->tailLength = tailLength;
+            clonedObj->length = length;
+            clonedObj->sorted = sorted;
+            return clonedObj;
+        }
+
+        void release() override {
+            vector<CompressedBlock>().swap(blocks);
+            vector<uint8_t>().swap(data);
+            tailLength = length = 0;
+            sorted = true;
+            initialized = false;
+        }
+
+        // 格式：是否已初始化、是否有序、各块的头部、压缩数据、未压缩的尾部元素
+        void serialize(string &out) override {
+            putU8(out, initialized);
+            putU8(out, sorted);
+            putU32(out, (uint32_t) blocks.size());
+            for (auto &block : blocks) {
+                putI32(out, block.min);
+                putI32(out, block.max);
+                putI32(out, block.first);
+                putU32(out, block.offset);
+                putU8(out, block.width);
+                putU8(out, block.delta);
+            }
+            putString(out, string((const char *) data.data(), data.size()));
+            putI32(out, tailLength);
+            putI32Array(out, tail, tailLength);
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            initialized = in.getU8() != 0;
+            sorted = in.getU8() != 0;
+            uint32_t count = in.getU32();
+            if (!in.ok || !in.require((size_t) count * 18)) return false;
+            blocks.resize(count);
+            for (auto &block : blocks) {
+                block.min = in.getI32();
+                block.max = in.getI32();
+                block.first = in.getI32();
+                block.offset = in.getU32();
+                block.width = in.getU8();
+                block.delta = in.getU8() != 0;
+            }
+            string bytes = in.getString();
+            data.assign(bytes.begin(), bytes.end());
+            tailLength = in.getI32();
+            if (!in.ok || tailLength < 0 || tailLength >= COMPRESSED_BLOCK_SIZE) return false;
+            for (auto &block : blocks) {
+                if (block.width > 32 || (size_t) block.offset + 16 * block.width > data.size()) return false;
+            }
+            length = (int) blocks.size() * COMPRESSED_BLOCK_SIZE + tailLength;
+            return in.getI32Array(tail, tailLength);
+        }
+
+        void append(ElemType e) {
+            if (length > 0 && e < last()) {
+                sorted = false;
+            }
+            tail[tailLength++] = e;
+            ++length;
+            if (tailLength == COMPRESSED_BLOCK_SIZE) {
+                blocks.emplace_back();
+                EncodeCompressedBlock(tail, blocks.back(), data);
+                tailLength = 0;
+            }
+        }
+
+        // append 的逆操作（批处理回滚时使用）：尾部为空时先把最后一块解码回尾部，sorted 由调用者恢复
+        void removeLast() {
+            if (tailLength == 0) {
+                DecodeCompressedBlock(blocks.back(), data.data(), tail);
+                data.resize(blocks.back().offset);
+                blocks.pop_back();
+                tailLength = COMPRESSED_BLOCK_SIZE;
+            }
+            --tailLength;
+            --length;
+        }
+
+        ElemType last() const {
+            return (tailLength > 0) ? tail[tailLength - 1] : blocks.back().max;
+        }
+
+        // 取第 index 个元素（从 0 开始）：直接计算所在的块，只解码这一块
+        ElemType at(int index) const {
+            int b = index / COMPRESSED_BLOCK_SIZE;
+            if (b == (int) blocks.size()) {
+                return tail[index % COMPRESSED_BLOCK_SIZE];
+            }
+            ElemType values[COMPRESSED_BLOCK_SIZE];
+            DecodeCompressedBlock(blocks[b], data.data(), values);
+            return values[index % COMPRESSED_BLOCK_SIZE];
+        }
+
+        // 查找第一个值为 e 的元素的下标，不存在时返回 -1
+        int locate(ElemType e) const {
+            ElemType values[COMPRESSED_BLOCK_SIZE];
+            size_t b = 0;
+            if (sorted) {
+                // 有序时各块的最大值非递减，二分查找第一个最大值不小于 e 的块，只需解码这一块
+                size_t lo = 0, hi = blocks.size();
+                while (lo < hi) {
+                    size_t mid = (lo + hi) / 2;
+                    if (blocks[mid].max < e) lo = mid + 1;
+                    else hi = mid;
+                }
+                b = lo;
+            }
+            for (; b < blocks.size(); ++b) {
+                auto &block = blocks[b];
+                if (e < block.min || e > block.max) {
+                    if (sorted && e < block.min) return -1;
+                    continue;
+                }
+                DecodeCompressedBlock(block, data.data(), values);
+                for (int k = 0; k < COMPRESSED_BLOCK_SIZE; ++k) {
+                    if (values[k] == e) return (int) b * COMPRESSED_BLOCK_SIZE + k;
+                }
+            }
+            for (int k = 0; k < tailLength; ++k) {
+                if (tail[k] == e) return (int) blocks.size() * COMPRESSED_BLOCK_SIZE + k;
+            }
+            return -1;
+        }
+
+        // 按顺序解码全部元素写入 out
+        void decodeAll(ElemType *out) const {
+            for (size_t b = 0; b < blocks.size(); ++b) {
+                DecodeCompressedBlock(blocks[b], data.data(), out + b * COMPRESSED_BLOCK_SIZE);
+            }
+            memcpy(out + blocks.size() * COMPRESSED_BLOCK_SIZE, tail, tailLength * sizeof(ElemType));
+        }
+
+        // 占用的存储空间（字节）：块头部、压缩数据以及未压缩的尾部元素
+        size_t storageBytes() const {
+            return blocks.size() * sizeof(CompressedBlock) + data.size() + tailLength * sizeof(ElemType);
+        }
+    };
+
+    class InitCompressedSequenceList : public Function {
+    ENABLE_SINGLETON(InitCompressedSequenceList)
+    SIGNATURE(ADT_ARG(CompressedSequenceList))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<CompressedSequenceList>(0);
+            pList->release();
+            pList->initialized = true;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(InitCompressedSequenceList)
+
+    class DestroyCompressedSequenceList : public Function {
+    ENABLE_SINGLETON(DestroyCompressedSequenceList)
+    SIGNATURE(ADT_ARG(CompressedSequenceList))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<CompressedSequenceList>(0);
+            if (!pList->initialized) {
+                return DSCxx_ERROR;
+            }
+            pList->release();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DestroyCompressedSequenceList)
+
+    class CompressedSequenceListLength : public Function {
+    ENABLE_SINGLETON(CompressedSequenceListLength)
+    SIGNATURE(ADT_ARG(CompressedSequenceList))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<CompressedSequenceList>(0);
+            if (!pList->initialized) {
+                return DSCxx_ERROR;
+            }
+            return pList->length;
+        }
+    };
+
+    SINGLETON_MEMBER(CompressedSequenceListLength)
+
+    class CompressedSequenceListAppend : public Function {
+    ENABLE_SINGLETON(CompressedSequenceListAppend)
+    SIGNATURE(ADT_ARG(CompressedSequenceList), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<CompressedSequenceList>(0);
+            if (!pList->initialized || pList->length == INT32_MAX) {
+                return DSCxx_ERROR;
+            }
+            pList->append(*args.var(1));
+            return DSCxx_OK;
+        }
+
+        // 逆操作：去掉追加的元素，并恢复原来的有序标记
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pList = args.adt<CompressedSequenceList>(0);
+            int length = pList->length;
+            bool sorted = pList->sorted;
+            steps.push_back({ 0, [length, sorted](ADTObject *obj) {
+                auto pList = static_cast<CompressedSequenceList *>(obj);
+                if (pList->length > length) pList->removeLast();
+                pList->sorted = sorted;
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(CompressedSequenceListAppend)
+
+    class GetElemInCompressedSequenceList : public Function {
+    ENABLE_SINGLETON(GetElemInCompressedSequenceList)
+    SIGNATURE(ADT_ARG(CompressedSequenceList), INT_ARG, VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<CompressedSequenceList>(0);
+            if (!pList->initialized) {
+                return DSCxx_ERROR;
+            }
+            int i = args.value(1);
+            if (i < 1 || i > pList->length) {
+                return DSCxx_ERROR;
+            }
+            *args.var(2) = pList->at(i - 1);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(GetElemInCompressedSequenceList)
+
+    // 返回第一个值与变量相等的元素的位序，不存在时返回 0
+    class LocateElemInCompressedSequenceList : public Function {
+    ENABLE_SINGLETON(LocateElemInCompressedSequenceList)
+    SIGNATURE(ADT_ARG(CompressedSequenceList), VAR_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<CompressedSequenceList>(0);
+            if (!pList->initialized) {
+                return DSCxx_ERROR;
+            }
+            return pList->locate(*args.var(1)) + 1;
+        }
+    };
+
+    SINGLETON_MEMBER(LocateElemInCompressedSequenceList)
+
+    // 用线性表的全部元素重新构造压缩序列，被取消时压缩序列保持不变
+    class CompressSequenceList : public Function {
+    ENABLE_SINGLETON(CompressSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList), ADT_ARG(CompressedSequenceList))
+    SNAPSHOT_ARGS(1)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pSource = args.adt<SequenceList>(0);
+            auto pTarget = args.adt<CompressedSequenceList>(1);
+            if (pSource->elem == nullptr) {
+                return DSCxx_ERROR;
+            }
+            CompressedSequenceList built;
+            built.initialized = true;
+            built.blocks.reserve(pSource->length / COMPRESSED_BLOCK_SIZE);
+            for (int i = 0; i < pSource->length; ++i) {
+                if (i % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return DSCxx_INFEASIBLE;
+                }
+                built.append(pSource->elem[i]);
+            }
+            pTarget->blocks.swap(built.blocks);
+            pTarget->data.swap(built.data);
+            memcpy(pTarget->tail, built.tail, built.tailLength * sizeof(ElemType));
+            pTarget->tailLength = built.tailLength;
+            pTarget->length = built.length;
+            pTarget->sorted = built.sorted;
+            pTarget->initialized = true;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(CompressSequenceList)
+
+    // 将压缩序列的全部元素解码到线性表中（覆盖原有内容）；目标为有序线性表而序列无序时返回 ERROR
+    class DecompressSequenceList : public Function {
+    ENABLE_SINGLETON(DecompressSequenceList)
+    SIGNATURE(ADT_ARG(CompressedSequenceList), ADT_FAMILY_ARG(SequenceList))
+    SNAPSHOT_ARGS(1)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pSource = args.adt<CompressedSequenceList>(0);
+            auto pTarget = args.adt<SequenceList>(1);
+            if (!pSource->initialized || (pTarget->sorted && !pSource->sorted)) {
+                return DSCxx_ERROR;
+            }
+            if (ResizeSequenceList(pTarget, pSource->length) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            pSource->decodeAll(pTarget->elem);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DecompressSequenceList)
+}
@@ -18,24 +18,89 @@
 
 #include "Interactor.h"
 #include "SequenceList.hpp"
+#include "SortedSequenceList.hpp"
+#include "CompressedSequenceList.hpp"
+#include "SequenceListView.hpp"
+#include "PersistentVector.hpp"
+#include "SharedSequenceList.hpp"
 
 using namespace DataStructure_Cxx;
 
+// 线性表的全部指令，由 ADTLoader.hpp 汇总到编译期生成的指令表中
+#define LIST_INSTRUCTIONS \
+    LoadFunc(InitSequenceList) \
+    LoadFunc(DestroySequenceList) \
+    LoadFunc(ClearSequenceList) \
+    LoadFunc(IsSequenceListEmpty) \
+    LoadFunc(SequenceListLength) \
+    LoadFunc(GetElemInSequenceList) \
+    LoadFunc(LocateElemInSequenceList) \
+    LoadFunc(PriorElemInSequenceList) \
+    LoadFunc(NextElemInSequenceList) \
+    LoadFunc(SequenceListInsert) \
+    LoadFunc(SequenceListDelete) \
+    LoadFunc(SequenceListTraverse) \
+    LoadFunc(UnionSequenceList) \
+    LoadFunc(MergeSequenceList) \
+    LoadFunc(MapSequenceList) \
+    LoadFunc(UnmapSequenceList) \
+    LoadFunc(ShrinkSequenceList) \
+    LoadFunc(SortSequenceList) \
+    LoadFunc(SortedSequenceListInsert) \
+    LoadFunc(LowerBoundInSortedSequenceList) \
+    LoadFunc(UpperBoundInSortedSequenceList) \
+    LoadFunc(CountRangeInSortedSequenceList) \
+    LoadFunc(InitCompressedSequenceList) \
+    LoadFunc(DestroyCompressedSequenceList) \
+    LoadFunc(CompressedSequenceListLength) \
+    LoadFunc(CompressedSequenceListAppend) \
+    LoadFunc(GetElemInCompressedSequenceList) \
+    LoadFunc(LocateElemInCompressedSequenceList) \
+    LoadFunc(CompressSequenceList) \
+    LoadFunc(DecompressSequenceList) \
+    LoadFunc(ViewSequenceList) \
+    LoadFunc(ReverseSequenceListView) \
+    LoadFunc(StrideSequenceListView) \
+    LoadFunc(SequenceListViewLength) \
+    LoadFunc(GetElemInSequenceListView) \
+    LoadFunc(LocateElemInSequenceListView) \
+    LoadFunc(SumOfSequenceListView) \
+    LoadFunc(MaxInSequenceListView) \
+    LoadFunc(MinInSequenceListView) \
+    LoadFunc(CopySequenceListView) \
+    LoadFunc(MergeSequenceListViews) \
+    LoadFunc(InitPersistentVector) \
+    LoadFunc(DestroyPersistentVector) \
+    LoadFunc(PersistentVectorLength) \
+    LoadFunc(GetElemInPersistentVector) \
+    LoadFunc(PersistentVectorAppend) \
+    LoadFunc(PersistentVectorSet) \
+    LoadFunc(AppendSequenceListToPersistentVector) \
+    LoadFunc(PersistentVectorToSequenceList) \
+    LoadFunc(PersistentVectorSnapshot) \
+    LoadFunc(PersistentVectorRestore) \
+    LoadFunc(ReleasePersistentVectorVersion) \
+    LoadFunc(PublishSequenceList) \
+    LoadFunc(UpdateSharedSequenceList) \
+    LoadFunc(AttachSequenceList) \
+    LoadFunc(RefreshSharedSequenceList) \
+    LoadFunc(SharedSequenceListChanged) \
+    LoadFunc(DetachSequenceList)
+
 void loadList() {
     auto pSequenceList = new SequenceList;
     Interactor::instance()->addAdtType("SequenceList", pSequenceList);
-    LoadFunc(InitSequenceList);
-    LoadFunc(DestroySequenceList);
-    LoadFunc(ClearSequenceList);
-    LoadFunc(IsSequenceListEmpty);
-    LoadFunc(SequenceListLength);
-    LoadFunc(GetElemInSequenceList);
-    LoadFunc(LocateElemInSequenceList);
-    LoadFunc(PriorElemInSequenceList);
-    LoadFunc(NextElemInSequenceList);
-    LoadFunc(SequenceListInsert);
-    LoadFunc(SequenceListDelete);
-    LoadFunc(SequenceListTraverse);
-    LoadFunc(UnionSequenceList);
-    LoadFunc(MergeSequenceList);
+    auto pSortedSequenceList = new SortedSequenceList;
+    Interactor::instance()->addAdtType("SortedSequenceList", pSortedSequenceList,
+                                       ADTTypeId<SequenceList>::value);
+    auto pCompressedSequenceList = new CompressedSequenceList;
+    Interactor::instance()->addAdtType("CompressedSequenceList", pCompressedSequenceList);
+    auto pSharedSequenceList = new SharedSequenceList;
+    Interactor::instance()->addAdtType("SharedSequenceList", pSharedSequenceList,
+                                       ADTTypeId<SequenceList>::value);
+    // 视图在所有线性表（包括各派生类型）之后注册，恢复检查点快照时基础线性表已经存在
+    auto pSequenceListView = new SequenceListView;
+    Interactor::instance()->addAdtType("SequenceListView", pSequenceListView);
+    auto pPersistentVector = new PersistentVector;
+    Interactor::instance()->addAdtType("PersistentVector", pPersistentVector);
 }
\ No newline at end of file
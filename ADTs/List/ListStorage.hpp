@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+
+#include <cstddef>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define LIST_MAPPED_STORAGE_SUPPORTED
+#endif
+
+namespace DataStructure_Cxx {
+
+#define LIST_HUGE_PAGE_SIZE (2 * 1024 * 1024)   // 映射超过该大小时请求透明大页
+
+    // 线性表的存储空间默认在堆上用 malloc/realloc 分配，超大的线性表每次扩充都可能复制整个数组。
+    // 映射存储（mapped，需通过 MapSequenceList 显式启用，目前只支持 Linux）直接用 mmap 向系统申请，
+    // 扩充时用 mremap 重新映射页表而不复制数据，缩减时把尾部的整页归还给系统，
+    // 较大的映射还会通过 madvise 请求透明大页以减少 TLB 缺失。
+    // 映射存储的容量总是整页，即 capacity * sizeof(ElemType) 恰好就是映射的大小
+
+    inline bool ListMappedStorageSupported() {
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // 能够容纳 size 个元素的实际容量
+    inline int ListStorageCapacity(int size, bool mapped) {
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+        if (mapped) {
+            static const size_t page = (size_t) sysconf(_SC_PAGESIZE);
+            size_t bytes = ((size_t) size * sizeof(ElemType) + page - 1) / page * page;
+            return (int) (bytes / sizeof(ElemType));
+        }
+#endif
+        return size;
+    }
+
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+    inline void AdviseListHugePages(void *addr, size_t bytes) {
+#ifdef MADV_HUGEPAGE
+        if (bytes >= LIST_HUGE_PAGE_SIZE) {
+            madvise(addr, bytes, MADV_HUGEPAGE);
+        }
+#endif
+    }
+#endif
+
+    // 分配至少能容纳 size 个元素的存储空间，实际容量通过 capacity 返回
+    inline ElemType *AllocListStorage(int size, bool mapped, int &capacity) {
+        capacity = ListStorageCapacity(size, mapped);
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+        if (mapped) {
+            size_t bytes = (size_t) capacity * sizeof(ElemType);
+            void *addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (addr == MAP_FAILED) exit(DSCxx_OVERFLOW);
+            AdviseListHugePages(addr, bytes);
+            return (ElemType *) addr;
+        }
+#endif
+        auto elem = (ElemType *) malloc((size_t) capacity * sizeof(ElemType));
+        if (!elem) exit(DSCxx_OVERFLOW);
+        return elem;
+    }
+
+    // 将容量为 oldCapacity 的存储空间调整为至少能容纳 size 个元素（可扩充也可缩减），前 min(旧容量, size) 个元素保持不变
+    inline ElemType *ReallocListStorage(ElemType *elem, int oldCapacity, int size, bool mapped, int &capacity) {
+        if (elem == nullptr) {
+            return AllocListStorage(size, mapped, capacity);
+        }
+        capacity = ListStorageCapacity(size, mapped);
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+        if (mapped) {
+            size_t oldBytes = (size_t) oldCapacity * sizeof(ElemType);
+            size_t bytes = (size_t) capacity * sizeof(ElemType);
+            if (bytes == oldBytes) return elem;
+            void *addr = mremap(elem, oldBytes, bytes, MREMAP_MAYMOVE);
+            if (addr == MAP_FAILED) exit(DSCxx_OVERFLOW);
+            if (bytes > oldBytes) {
+                AdviseListHugePages(addr, bytes);
+            }
+            return (ElemType *) addr;
+        }
+#endif
+        auto newBase = (ElemType *) realloc(elem, (size_t) capacity * sizeof(ElemType));
+        if (!newBase) exit(DSCxx_OVERFLOW);
+        return newBase;
+    }
+
+    inline void FreeListStorage(ElemType *elem, int capacity, bool mapped) {
+        if (elem == nullptr) return;
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+        if (mapped) {
+            munmap(elem, (size_t) capacity * sizeof(ElemType));
+            return;
+        }
+#endif
+        free(elem);
+    }
+}
@@ -0,0 +1,604 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "SequenceList.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace DataStructure_Cxx {
+
+#define PERSISTENT_VECTOR_BITS  5
+#define PERSISTENT_VECTOR_WIDTH (1 << PERSISTENT_VECTOR_BITS)   // 每个结点 32 路
+#define PERSISTENT_VECTOR_MASK  (PERSISTENT_VECTOR_WIDTH - 1)
+
+    // 持久化向量的结点带有引用计数（被多少个父结点或者版本引用），叶结点存放 32 个元素，内部结点存放 32 个孩子
+    // 孩子是叶结点还是内部结点由所在的层决定：第 0 层为叶结点，根所在的层为版本的 shift
+    struct PersistentVectorNode {
+        atomic<int> refs{1};
+    };
+
+    struct PersistentVectorLeaf : public PersistentVectorNode {
+        ElemType elems[PERSISTENT_VECTOR_WIDTH];
+    };
+
+    struct PersistentVectorBranch : public PersistentVectorNode {
+        PersistentVectorNode *children[PERSISTENT_VECTOR_WIDTH] = {};
+    };
+
+    inline PersistentVectorLeaf *LeafOf(PersistentVectorNode *node) {
+        return static_cast<PersistentVectorLeaf *>(node);
+    }
+
+    inline PersistentVectorBranch *BranchOf(PersistentVectorNode *node) {
+        return static_cast<PersistentVectorBranch *>(node);
+    }
+
+    inline void RetainPersistentVectorNode(PersistentVectorNode *node) {
+        if (node != nullptr) node->refs.fetch_add(1, memory_order_relaxed);
+    }
+
+    // 引用计数减为 0 时释放结点，并递归地释放它的孩子
+    inline void ReleasePersistentVectorNode(PersistentVectorNode *node, int level) {
+        if (node == nullptr || node->refs.fetch_sub(1, memory_order_acq_rel) != 1) return;
+        if (level == 0) {
+            delete LeafOf(node);
+            return;
+        }
+        for (auto child : BranchOf(node)->children) {
+            ReleasePersistentVectorNode(child, level - PERSISTENT_VECTOR_BITS);
+        }
+        delete BranchOf(node);
+    }
+
+    // 取得 slot 指向的结点的可修改版本：只被这里引用的结点直接修改，否则复制一份（孩子的引用计数加一）替换到 slot 中
+    inline PersistentVectorNode *EditablePersistentVectorNode(PersistentVectorNode *&slot, int level) {
+        if (slot->refs.load(memory_order_acquire) == 1) return slot;
+        PersistentVectorNode *copied;
+        if (level == 0) {
+            auto leaf = new PersistentVectorLeaf;
+            memcpy(leaf->elems, LeafOf(slot)->elems, sizeof(leaf->elems));
+            copied = leaf;
+        }
+        else {
+            auto branch = new PersistentVectorBranch;
+            memcpy(branch->children, BranchOf(slot)->children, sizeof(branch->children));
+            for (auto child : branch->children) {
+                RetainPersistentVectorNode(child);
+            }
+            copied = branch;
+        }
+        ReleasePersistentVectorNode(slot, level);
+        slot = copied;
+        return copied;
+    }
+
+    // 持久化向量的一个版本：根结点 + 尾部缓冲（最后不满 32 个的元素单独存放在一个叶结点中，追加时不需要访问树）
+    // 版本之间共享没有修改过的结点，修改只复制从根到目标叶结点的路径
+    struct PersistentVectorVersion {
+        PersistentVectorNode *root = nullptr;   // 为空表示该版本不存在（未初始化或已释放）
+        PersistentVectorNode *tail = nullptr;
+        int size = 0;
+        int shift = PERSISTENT_VECTOR_BITS;
+
+        // 尾部缓冲中第一个元素的下标
+        int tailOffset() const {
+            return (size < PERSISTENT_VECTOR_WIDTH) ? 0 : ((size - 1) >> PERSISTENT_VECTOR_BITS) << PERSISTENT_VECTOR_BITS;
+        }
+
+        ElemType at(int i) const {
+            if (i >= tailOffset()) {
+                return LeafOf(tail)->elems[i & PERSISTENT_VECTOR_MASK];
+            }
+            auto node = root;
+            for (int level = shift; level > 0; level -= PERSISTENT_VECTOR_BITS) {
+                node = BranchOf(node)->children[(i >> level) & PERSISTENT_VECTOR_MASK];
+            }
+            return LeafOf(node)->elems[i & PERSISTENT_VECTOR_MASK];
+        }
+
+        void retain() const {
+            RetainPersistentVectorNode(root);
+            RetainPersistentVectorNode(tail);
+        }
+
+        void release() {
+            ReleasePersistentVectorNode(root, shift);
+            ReleasePersistentVectorNode(tail, 0);
+            root = tail = nullptr;
+            size = 0;
+            shift = PERSISTENT_VECTOR_BITS;
+        }
+
+        static PersistentVectorNode *newPath(int level, PersistentVectorNode *node) {
+            if (level == 0) return node;
+            auto branch = new PersistentVectorBranch;
+            branch->children[0] = newPath(level - PERSISTENT_VECTOR_BITS, node);
+            return branch;
+        }
+
+        // 将已满的尾部缓冲挂到树上（size 为挂上之后树中的元素个数）
+        void pushTail(PersistentVectorNode *&slot, int level, PersistentVectorNode *tailNode) {
+            auto parent = BranchOf(EditablePersistentVectorNode(slot, level));
+            int sub = ((size - 1) >> level) & PERSISTENT_VECTOR_MASK;
+            if (level == PERSISTENT_VECTOR_BITS) {
+                parent->children[sub] = tailNode;
+            }
+            else if (parent->children[sub] != nullptr) {
+                pushTail(parent->children[sub], level - PERSISTENT_VECTOR_BITS, tailNode);
+            }
+            else {
+                parent->children[sub] = newPath(level - PERSISTENT_VECTOR_BITS, tailNode);
+            }
+        }
+
+        void push(ElemType e) {
+            int tailCount = size - tailOffset();
+            if (tail != nullptr && tailCount < PERSISTENT_VECTOR_WIDTH) {
+                LeafOf(EditablePersistentVectorNode(tail, 0))->elems[tailCount] = e;
+                ++size;
+                return;
+            }
+            if (tail != nullptr) {
+                // 根已满时增加一层
+                if ((size >> PERSISTENT_VECTOR_BITS) > (1 << shift)) {
+                    auto newRoot = new PersistentVectorBranch;
+                    newRoot->children[0] = root;
+                    newRoot->children[1] = newPath(shift, tail);
+                    root = newRoot;
+                    shift += PERSISTENT_VECTOR_BITS;
+                }
+                else {
+                    pushTail(root, shift, tail);
+                }
+            }
+            tail = new PersistentVectorLeaf;
+            LeafOf(tail)->elems[0] = e;
+            ++size;
+        }
+
+        void set(int i, ElemType e) {
+            if (i >= tailOffset()) {
+                LeafOf(EditablePersistentVectorNode(tail, 0))->elems[i & PERSISTENT_VECTOR_MASK] = e;
+                return;
+            }
+            auto slot = &root;
+            for (int level = shift; level > 0; level -= PERSISTENT_VECTOR_BITS) {
+                auto branch = BranchOf(EditablePersistentVectorNode(*slot, level));
+                slot = &branch->children[(i >> level) & PERSISTENT_VECTOR_MASK];
+            }
+            LeafOf(EditablePersistentVectorNode(*slot, 0))->elems[i & PERSISTENT_VECTOR_MASK] = e;
+        }
+    };
+
+    // 持久化向量：当前版本（head）可以修改，snapshot 以 O(1) 的代价保存当前版本并返回版本号（从 1 开始），
+    // 之后对 head 的修改不会影响已保存的版本；没有被任何快照共享的结点直接原地修改，不产生复制
+    class PersistentVector : public ADTObject {
+    public:
+        PersistentVectorVersion head;
+        vector<PersistentVectorVersion> versions;   // 版本号为 k 的版本存放在 versions[k - 1]
+
+        ADTObject *copy() override {
+            return new PersistentVector;
+        }
+
+        string str() override {
+            return "PersistentVector";
+        }
+
+        // 深拷贝只需要共享所有结点
+        ADTObject *clone() override {
+            auto clonedObj = new PersistentVector;
+            clonedObj->head = head;
+            head.retain();
+            clonedObj->versions = versions;
+            for (auto &version : versions) {
+                version.retain();
+            }
+            return clonedObj;
+        }
+
+        void release() override {
+            head.release();
+            for (auto &version : versions) {
+                version.release();
+            }
+            versions.clear();
+        }
+
+        ~PersistentVector() override {
+            release();
+        }
+
+        // version 为 0 时表示当前版本，不存在时返回 nullptr
+        PersistentVectorVersion *find(int version) {
+            if (version == 0) return head.root != nullptr ? &head : nullptr;
+            if (version < 0 || version > (int) versions.size() || versions[version - 1].root == nullptr) {
+                return nullptr;
+            }
+            return &versions[version - 1];
+        }
+
+        // 所有版本引用到的不同结点，用于统计共享之后实际占用的存储空间
+        void collectNodes(unordered_set<PersistentVectorNode *> &leaves, unordered_set<PersistentVectorNode *> &branches) {
+            vector<pair<PersistentVectorNode *, int>> stack;
+            auto visit = [&](const PersistentVectorVersion &v) {
+                if (v.root == nullptr) return;
+                if (v.tail != nullptr) leaves.insert(v.tail);
+                stack.push_back({ v.root, v.shift });
+                while (!stack.empty()) {
+                    auto node = stack.back().first;
+                    int level = stack.back().second;
+                    stack.pop_back();
+                    if (level == 0) {
+                        leaves.insert(node);
+                        continue;
+                    }
+                    if (!branches.insert(node).second) continue;
+                    for (auto child : BranchOf(node)->children) {
+                        if (child != nullptr) stack.push_back({ child, level - PERSISTENT_VECTOR_BITS });
+                    }
+                }
+            };
+            visit(head);
+            for (auto &version : versions) {
+                visit(version);
+            }
+        }
+
+        // 格式：结点数、各结点（孩子总在父结点之前写出，共享的结点只写一次）、版本数（含 head）、各版本的根、尾部、长度、shift
+        // 结点的编号从 1 开始，0 表示空
+        void serialize(string &out) override {
+            unordered_map<PersistentVectorNode *, uint32_t> ids;
+            string nodes;
+            auto emit = [&](PersistentVectorNode *node, int level, auto &self) -> uint32_t {
+                if (node == nullptr) return 0;
+                auto iter = ids.find(node);
+                if (iter != ids.end()) return iter->second;
+                if (level == 0) {
+                    putU8(nodes, 0);
+                    putI32Array(nodes, LeafOf(node)->elems, PERSISTENT_VECTOR_WIDTH);
+                }
+                else {
+                    uint32_t childIds[PERSISTENT_VECTOR_WIDTH];
+                    for (int k = 0; k < PERSISTENT_VECTOR_WIDTH; ++k) {
+                        childIds[k] = self(BranchOf(node)->children[k], level - PERSISTENT_VECTOR_BITS, self);
+                    }
+                    putU8(nodes, (uint8_t) level);
+                    for (auto id : childIds) {
+                        putU32(nodes, id);
+                    }
+                }
+                uint32_t id = (uint32_t) ids.size() + 1;
+                ids[node] = id;
+                return id;
+            };
+            string header;
+            auto writeVersion = [&](const PersistentVectorVersion &v) {
+                putU32(header, emit(v.root, v.shift, emit));
+                putU32(header, emit(v.tail, 0, emit));
+                putI32(header, v.size);
+                putI32(header, v.shift);
+            };
+            writeVersion(head);
+            for (auto &version : versions) {
+                writeVersion(version);
+            }
+            putU32(out, (uint32_t) ids.size());
+            out += nodes;
+            putU32(out, (uint32_t) versions.size() + 1);
+            out += header;
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            uint32_t count = in.getU32();
+            vector<PersistentVectorNode *> nodes;
+            vector<int> levels;
+            bool ok = in.ok;
+            for (uint32_t i = 0; i < count && ok; ++i) {
+                int level = in.getU8();
+                if (level == 0) {
+                    auto leaf = new PersistentVectorLeaf;
+                    leaf->refs = 0;
+                    ok = in.getI32Array(leaf->elems, PERSISTENT_VECTOR_WIDTH);
+                    nodes.push_back(leaf);
+                }
+                else {
+                    auto branch = new PersistentVectorBranch;
+                    branch->refs = 0;
+                    nodes.push_back(branch);
+                    for (int k = 0; k < PERSISTENT_VECTOR_WIDTH && ok; ++k) {
+                        uint32_t id = in.getU32();
+                        // 孩子必须已经读出，并且恰好位于下一层
+                        ok = in.ok && id <= i && (id == 0 || levels[id - 1] == level - PERSISTENT_VECTOR_BITS);
+                        if (ok && id != 0) {
+                            branch->children[k] = nodes[id - 1];
+                            RetainPersistentVectorNode(nodes[id - 1]);
+                        }
+                    }
+                }
+                levels.push_back(level);
+            }
+            uint32_t versionCount = ok ? in.getU32() : 0;
+            ok = ok && in.ok && versionCount >= 1;
+            for (uint32_t v = 0; v < versionCount && ok; ++v) {
+                uint32_t rootId = in.getU32(), tailId = in.getU32();
+                PersistentVectorVersion version;
+                version.size = in.getI32();
+                version.shift = in.getI32();
+                ok = in.ok && rootId <= count && tailId <= count && version.size >= 0
+                     && (rootId == 0 || levels[rootId - 1] == version.shift)
+                     && (tailId == 0 || levels[tailId - 1] == 0)
+                     && (rootId != 0 || (tailId == 0 && version.size == 0));
+                if (!ok) break;
+                version.root = rootId ? nodes[rootId - 1] : nullptr;
+                version.tail = tailId ? nodes[tailId - 1] : nullptr;
+                version.retain();
+                if (v == 0) head = version;
+                else versions.push_back(version);
+            }
+            // 没有被任何结点或版本引用的结点（只可能出现在损坏的数据中）直接删除
+            for (size_t i = 0; i < nodes.size(); ++i) {
+                if (nodes[i]->refs.load() == 0) {
+                    nodes[i]->refs = 1;
+                    ReleasePersistentVectorNode(nodes[i], levels[i]);
+                }
+            }
+            return ok;
+        }
+    };
+
+    class InitPersistentVector : public Function {
+    ENABLE_SINGLETON(InitPersistentVector)
+    SIGNATURE(ADT_ARG(PersistentVector))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVector = args.adt<PersistentVector>(0);
+            pVector->release();
+            pVector->head.root = new PersistentVectorBranch;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(InitPersistentVector)
+
+    // 释放当前版本和所有保存的版本
+    class DestroyPersistentVector : public Function {
+    ENABLE_SINGLETON(DestroyPersistentVector)
+    SIGNATURE(ADT_ARG(PersistentVector))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVector = args.adt<PersistentVector>(0);
+            if (pVector->head.root == nullptr) {
+                return DSCxx_ERROR;
+            }
+            pVector->release();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DestroyPersistentVector)
+
+    // 以下指令中的 version 为 0 时表示当前版本，否则为 PersistentVectorSnapshot 返回的版本号
+    class PersistentVectorLength : public Function {
+    ENABLE_SINGLETON(PersistentVectorLength)
+    SIGNATURE(ADT_ARG(PersistentVector), VAR_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVersion = args.adt<PersistentVector>(0)->find(*args.var(1));
+            if (pVersion == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pVersion->size;
+        }
+    };
+
+    SINGLETON_MEMBER(PersistentVectorLength)
+
+    class GetElemInPersistentVector : public Function {
+    ENABLE_SINGLETON(GetElemInPersistentVector)
+    SIGNATURE(ADT_ARG(PersistentVector), VAR_ARG, INT_ARG, VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVersion = args.adt<PersistentVector>(0)->find(*args.var(1));
+            int i = args.value(2);
+            if (pVersion == nullptr || i < 1 || i > pVersion->size) {
+                return DSCxx_ERROR;
+            }
+            *args.var(3) = pVersion->at(i - 1);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(GetElemInPersistentVector)
+
+    class PersistentVectorAppend : public Function {
+    ENABLE_SINGLETON(PersistentVectorAppend)
+    SIGNATURE(ADT_ARG(PersistentVector), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVector = args.adt<PersistentVector>(0);
+            if (pVector->head.root == nullptr || pVector->head.size == INT_MAX) {
+                return DSCxx_ERROR;
+            }
+            pVector->head.push(*args.var(1));
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(PersistentVectorAppend)
+
+    // 修改当前版本中位序为 i 的元素
+    class PersistentVectorSet : public Function {
+    ENABLE_SINGLETON(PersistentVectorSet)
+    SIGNATURE(ADT_ARG(PersistentVector), INT_ARG, VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVector = args.adt<PersistentVector>(0);
+            int i = args.value(1);
+            if (pVector->head.root == nullptr || i < 1 || i > pVector->head.size) {
+                return DSCxx_ERROR;
+            }
+            pVector->head.set(i - 1, *args.var(2));
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(PersistentVectorSet)
+
+    // 把线性表中的所有元素追加到当前版本的末尾
+    class AppendSequenceListToPersistentVector : public Function {
+    ENABLE_SINGLETON(AppendSequenceListToPersistentVector)
+    SIGNATURE(ADT_ARG(PersistentVector), ADT_FAMILY_ARG(SequenceList))
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVector = args.adt<PersistentVector>(0);
+            auto pList = args.adt<SequenceList>(1);
+            if (pVector->head.root == nullptr || pList->elem == nullptr
+                || pList->length > INT_MAX - pVector->head.size) {
+                return DSCxx_ERROR;
+            }
+            for (int i = 0; i < pList->length; ++i) {
+                if (i % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return DSCxx_INFEASIBLE;
+                }
+                pVector->head.push(pList->elem[i]);
+            }
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(AppendSequenceListToPersistentVector)
+
+    // 将某个版本的全部元素写入线性表 Target（原有的内容被覆盖），便于用线性表的指令比较两个版本
+    class PersistentVectorToSequenceList : public Function {
+    ENABLE_SINGLETON(PersistentVectorToSequenceList)
+    SIGNATURE(ADT_ARG(PersistentVector), VAR_ARG, ADT_ARG(SequenceList))
+    SNAPSHOT_ARGS(2)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVersion = args.adt<PersistentVector>(0)->find(*args.var(1));
+            auto pTarget = args.adt<SequenceList>(2);
+            if (pVersion == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (ResizeSequenceList(pTarget, pVersion->size) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            // 逐个叶结点复制，每 32 个元素只需从根走一次
+            for (int base = 0; base < pVersion->size; base += PERSISTENT_VECTOR_WIDTH) {
+                if (base % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    pTarget->length = base;     // 只保留已经复制的部分
+                    return DSCxx_INFEASIBLE;
+                }
+                PersistentVectorNode *node = pVersion->tail;
+                if (base < pVersion->tailOffset()) {
+                    node = pVersion->root;
+                    for (int level = pVersion->shift; level > 0; level -= PERSISTENT_VECTOR_BITS) {
+                        node = BranchOf(node)->children[(base >> level) & PERSISTENT_VECTOR_MASK];
+                    }
+                }
+                int n = (pVersion->size - base < PERSISTENT_VECTOR_WIDTH) ? pVersion->size - base : PERSISTENT_VECTOR_WIDTH;
+                memcpy(pTarget->elem + base, LeafOf(node)->elems, n * sizeof(ElemType));
+            }
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(PersistentVectorToSequenceList)
+
+    // 保存当前版本，用 version 返回版本号，O(1)
+    class PersistentVectorSnapshot : public Function {
+    ENABLE_SINGLETON(PersistentVectorSnapshot)
+    SIGNATURE(ADT_ARG(PersistentVector), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVector = args.adt<PersistentVector>(0);
+            if (pVector->head.root == nullptr) {
+                return DSCxx_ERROR;
+            }
+            pVector->head.retain();
+            pVector->versions.push_back(pVector->head);
+            *args.var(1) = (ElemType) pVector->versions.size();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(PersistentVectorSnapshot)
+
+    // 以某个保存的版本作为当前版本（当前版本的修改被丢弃，保存的版本不受影响），O(1)
+    class PersistentVectorRestore : public Function {
+    ENABLE_SINGLETON(PersistentVectorRestore)
+    SIGNATURE(ADT_ARG(PersistentVector), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVector = args.adt<PersistentVector>(0);
+            int version = *args.var(1);
+            auto pVersion = pVector->find(version);
+            if (pVersion == nullptr || version == 0) {
+                return DSCxx_ERROR;
+            }
+            pVersion->retain();
+            auto restored = *pVersion;
+            pVector->head.release();
+            pVector->head = restored;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(PersistentVectorRestore)
+
+    // 释放保存的版本，只被它引用的结点随之释放；版本号不会被复用
+    class ReleasePersistentVectorVersion : public Function {
+    ENABLE_SINGLETON(ReleasePersistentVectorVersion)
+    SIGNATURE(ADT_ARG(PersistentVector), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pVector = args.adt<PersistentVector>(0);
+            int version = *args.var(1);
+            auto pVersion = pVector->find(version);
+            if (pVersion == nullptr || version == 0) {
+                return DSCxx_ERROR;
+            }
+            pVersion->release();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(ReleasePersistentVectorVersion)
+}
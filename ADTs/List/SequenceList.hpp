@@ -18,93 +18,52 @@
 
 #include "Common.h"
 #include "Interactor.h"
-#include "ListPreDef.hpp"
-
-#include <cstdlib>
-#include <functional>
+#include "SequenceListCore.hpp"
 
 namespace DataStructure_Cxx {
-    class SequenceList : public ADTObject {
-    public:
-        ElemType *elem = nullptr;   // 存储空间基址
-        int length;                 // 当前实际的长度（即有多少非空的元素）
-        int listsize;               // 当前分配的存储容量（以 sizeof(ElemType) 为单位）
-        ADTObject *copy() override {
-            auto pastedObj = new SequenceList;
-            pastedObj->elem = elem;
-            pastedObj->length = length;
-            pastedObj->listsize = listsize;
-            return pastedObj;
-        }
-
-        string str() override {
-            return "SequenceList";
-        }
-    };
+    // 线性表的指令：解码参数之后直接调用 SequenceListCore.hpp 中的类型化接口
 
     class InitSequenceList : public Function {
     ENABLE_SINGLETON(InitSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList))
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(1)
-            SequenceList *pList = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            pList->elem = (ElemType *) malloc(LIST_INIT_SIZE * sizeof(ElemType));
-            if (!pList->elem) exit(DSCxx_OVERFLOW);
-            pList->length = 0;
-            pList->listsize = LIST_INIT_SIZE;
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return InitList_Sq(*args.adt<SequenceList>(0));
         }
     };
     SINGLETON_MEMBER(InitSequenceList);
 
     class DestroySequenceList : public Function {
     ENABLE_SINGLETON(DestroySequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList))
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(1)
-            SequenceList *pList = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            if (pList->elem == nullptr) {
-                return DSCxx_ERROR;
-            }
-            free(pList->elem);
-            pList->elem = nullptr;
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return DestroyList_Sq(*args.adt<SequenceList>(0));
         }
     };
     SINGLETON_MEMBER(DestroySequenceList)
 
     class ClearSequenceList : public Function {
     ENABLE_SINGLETON(ClearSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList))
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(1)
-            // 清除操作实际上是：首先销毁，然后再初始化
-            DestroySequenceList::instance()->invoke(args);
-            InitSequenceList::instance()->invoke(args);
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return ClearList_Sq(*args.adt<SequenceList>(0));
         }
     };
     SINGLETON_MEMBER(ClearSequenceList)
 
     class IsSequenceListEmpty : public Function {
     ENABLE_SINGLETON(IsSequenceListEmpty)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList))
+    READ_ONLY_INSTRUCTION
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(1)
-            SequenceList *pList = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            if (pList->elem == nullptr) {
-                return DSCxx_ERROR;
-            }
-            // 直接判断 length 即可
-            if (pList->length == 0) {
-                return DSCxx_TRUE;
-            } else {
-                return DSCxx_FALSE;
-            }
+        Status invoke(const ArgBlock &args) override {
+            return ListEmpty_Sq(*args.adt<SequenceList>(0));
         }
     };
 
@@ -112,15 +71,12 @@ namespace DataStructure_Cxx {
 
     class SequenceListLength : public Function {
     ENABLE_SINGLETON(SequenceListLength)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList))
+    READ_ONLY_INSTRUCTION
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(1)
-            SequenceList *pList = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            if (pList->elem == nullptr) {
-                return DSCxx_ERROR;
-            }
-            return pList->length;
+        Status invoke(const ArgBlock &args) override {
+            return ListLength_Sq(*args.adt<SequenceList>(0));
         }
     };
 
@@ -128,21 +84,12 @@ namespace DataStructure_Cxx {
 
     class GetElemInSequenceList : public Function {
     ENABLE_SINGLETON(GetElemInSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList), INT_ARG, VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(3)
-            SequenceList *pList = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            if (pList->elem == nullptr) {
-                return DSCxx_ERROR;
-            }
-            int i = stoi(args[1]);
-            ElemType *pVar = (ElemType *) Interactor::instance()->getVariable(args[2]);
-            if (i < 1 || i > pList->length) {
-                return DSCxx_ERROR;
-            }
-            *pVar = *(pList->elem + i - 1);
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return GetElem_Sq(*args.adt<SequenceList>(0), args.value(1), *args.var(2));
         }
     };
 
@@ -153,24 +100,12 @@ namespace DataStructure_Cxx {
     // TODO: 实现可传入用户自定义判断准则的 Locate 方法
     class LocateElemInSequenceList : public Function {
     ENABLE_SINGLETON(LocateElemInSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList), VAR_ARG)
+    READ_ONLY_INSTRUCTION
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(2)
-            SequenceList *pList = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            if (pList->elem == nullptr) {
-                return DSCxx_ERROR;
-            }
-            ElemType *pVar = (ElemType *) Interactor::instance()->getVariable(args[1]);
-            // 查找第一个值与 pVar 相等的元素的位置
-            // 若找到，则返回该位置；否则返回 0
-            int i = 1;
-            auto p = pList->elem;
-            while (i <= pList->length && *p != *pVar) {
-                ++i;
-                ++p;
-            }
-            return (i <= pList->length) ? i : 0;
+        Status invoke(const ArgBlock &args) override {
+            return LocateElem_Sq(*args.adt<SequenceList>(0), *args.var(1));
         }
     };
 
@@ -178,23 +113,12 @@ namespace DataStructure_Cxx {
 
     class PriorElemInSequenceList : public Function {
     ENABLE_SINGLETON(PriorElemInSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList), VAR_ARG, VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(3)
-            SequenceList *pList = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            if (pList->elem == nullptr) {
-                return DSCxx_ERROR;
-            }
-            ElemType *pPre = (ElemType *) Interactor::instance()->getVariable(args[2]);
-            // 用 pPre 返回 pCur 在线性表中的前驱
-            // 先查找 pCur 的位置，然后再设定 pPre
-            int location = LocateElemInSequenceList::instance()->invoke({args[0], args[1]});
-            if (location <= 1) {
-                return DSCxx_ERROR;
-            }
-            *pPre = pList->elem[location - 2]; // 索引比位序小 1，前一个元素还需减 1，所以需要减 2
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return PriorElem_Sq(*args.adt<SequenceList>(0), *args.var(1), *args.var(2));
         }
     };
 
@@ -202,23 +126,12 @@ namespace DataStructure_Cxx {
 
     class NextElemInSequenceList : public Function {
     ENABLE_SINGLETON(NextElemInSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList), VAR_ARG, VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(3)
-            SequenceList *pList = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            if (pList->elem == nullptr) {
-                return DSCxx_ERROR;
-            }
-            ElemType *pNext = (ElemType *) Interactor::instance()->getVariable(args[2]);
-            // 用 pPre 返回 pCur 在线性表中的前驱
-            // 先查找 pCur 的位置，然后再设定 pPre
-            int location = LocateElemInSequenceList::instance()->invoke({args[0], args[1]});
-            if (location <= 1) {
-                return DSCxx_ERROR;
-            }
-            *pNext = pList->elem[location]; // 位序比索引大 1，后一个元素还需加 1，正好抵消
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return NextElem_Sq(*args.adt<SequenceList>(0), *args.var(1), *args.var(2));
         }
     };
 
@@ -226,129 +139,103 @@ namespace DataStructure_Cxx {
 
     class SequenceListInsert : public Function {
     ENABLE_SINGLETON(SequenceListInsert)
+    SIGNATURE(ADT_ARG(SequenceList), INT_ARG, VAR_ARG)
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(3)
-            SequenceList *pList = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            if (pList->elem == nullptr) {
-                return DSCxx_ERROR;
-            }
-            int i = stoi(args[1]);
-            ElemType *pVar = (ElemType *) Interactor::instance()->getVariable(args[2]);
-            // 执行插入后，新插入的元素在新的线性表中的位置为 i，所以 i 最小为 1，最大可为 length + 1
-            if (i < 1 || i > pList->length + 1) {
-                return DSCxx_ERROR;
-            }
-            // 如果存储空间已满，则需要先增加分配，再插入元素
-            if (pList->length >= pList->listsize) {
-                auto newBase = (ElemType *) realloc(pList->elem,
-                                                    (pList->listsize + LISTINCREMENT) * sizeof(ElemType));
-                if (!newBase) exit(DSCxx_OVERFLOW);
-                pList->elem = newBase;
-                pList->listsize += LISTINCREMENT;
-            }
-            // 获取插入位置
-            auto q = &(pList->elem[i - 1]); // 位置 i 对应的索引为 i - 1，所以需将 i - 1 及其后的元素全部后移一位
-            for (auto p = &(pList->elem[pList->length - 1]); p >= q; --p) {
-                *(p + 1) = *p;
-            }
-            *q = *pVar;
-            ++pList->length;
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return ListInsert_Sq(*args.adt<SequenceList>(0), args.value(1), *args.var(2));
+        }
+
+        // 逆操作：插入成功（长度增加）时删除位置 i 上的元素；还原存储版本号，插入之前建立的视图仍然有效
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pList = args.adt<SequenceList>(0);
+            int length = pList->length;
+            int i = args.value(1);
+            uint64_t version = pList->storageVersion;
+            steps.push_back({ 0, [length, i, version](ADTObject *obj) {
+                auto &L = *static_cast<SequenceList *>(obj);
+                ElemType e;
+                if (L.length > length) ListDelete_Sq(L, i, e);
+                L.storageVersion = version;
+            } });
+            return true;
         }
     };
 
     SINGLETON_MEMBER(SequenceListInsert)
 
+    // 删除不会破坏元素的顺序，所以也接受有序线性表；插入则只接受普通的线性表
     class SequenceListDelete : public Function {
     ENABLE_SINGLETON(SequenceListDelete)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList), INT_ARG, VAR_ARG)
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(3)
-            SequenceList *pList = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            if (pList->elem == nullptr) {
-                return DSCxx_ERROR;
-            }
-            int i = stoi(args[1]);
-            // 删除的元素会用 pVar 返回
-            ElemType *pVar = (ElemType *) Interactor::instance()->getVariable(args[2]);
-            if (i < 1 || i > pList->length) {
-                return DSCxx_ERROR;
-            }
-            auto p = &(pList->elem[i - 1]);
-            *pVar = *p;
-            auto q = pList->elem + pList->length - 1;
-            for (++p; p <= q; ++p) {
-                *(p - 1) = *p;
+        Status invoke(const ArgBlock &args) override {
+            return ListDelete_Sq(*args.adt<SequenceList>(0), args.value(1), *args.var(2));
+        }
+
+        // 逆操作：删除成功（长度减少）时把删除的元素放回位置 i；有序线性表中相等的元素无法区分，按值插回即可
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pList = args.adt<SequenceList>(0);
+            int i = args.value(1);
+            if (pList->elem == nullptr || i < 1 || i > pList->length) {
+                return true; // 删除一定会失败，不修改线性表
             }
-            --pList->length;
-            return DSCxx_OK;
+            int length = pList->length;
+            ElemType e = pList->elem[i - 1];
+            uint64_t version = pList->storageVersion;
+            steps.push_back({ 0, [length, i, e, version](ADTObject *obj) {
+                auto &L = *static_cast<SequenceList *>(obj);
+                if (L.length >= length) return;
+                if (L.sorted) InsertSortedElem(&L, e);
+                else ListInsert_Sq(L, i, e);
+                L.storageVersion = version;
+            } });
+            return true;
         }
     };
 
     SINGLETON_MEMBER(SequenceListDelete)
 
-    // 因为暂不支持传入用户自定义函数，所以此方法为空实现
+    // 因为指令暂不支持传入用户自定义函数，所以此方法为空实现（类型化接口 ListTraverse_Sq 可以传入 visit）
     // TODO: 在支持传入用户自定义函数后，需要实现 Traverse 方法
     class SequenceListTraverse : public Function {
     ENABLE_SINGLETON(SequenceListTraverse)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList))
+    READ_ONLY_INSTRUCTION
 
     public:
-        Status invoke(const vector<string> &args) override {
+        Status invoke(const ArgBlock &args) override {
             return DSCxx_OK;
         }
     };
 
     SINGLETON_MEMBER(SequenceListTraverse)
 
-//    template<typename ElemType>
-//    Status ListTraverse_Sq(SqList<ElemType>& L, std::function<Status(ElemType&)> visit)
-//    {
-//        // 对顺序线性表中每个数据元素调用 visit()
-//        // 直接使用 for 循环遍历
-//        for (int i = 0; i < L.length; ++i) {
-//            if (visit(L.elem[i]) != OK) return ERROR;   // 一旦 visit() 失败，则操作失败
-//        }
-//        return OK;
-//    }
-
     class UnionSequenceList : public Function {
     ENABLE_SINGLETON(UnionSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList), ADT_FAMILY_ARG(SequenceList))
 
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(2)
-            SequenceList *pListTarget = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            SequenceList *pListSource = (SequenceList *) Interactor::instance()->getADT(args[1]);
-            if (pListSource->elem == nullptr || pListTarget->elem == nullptr) {
-                return DSCxx_ERROR;
-            }
-            // 将所有在线性表 Source 中但不在 Target 中的数据元素插入到 Target 中
-            // 这里先创建一些临时变量用于调用符合 Function 规范的函数，最后记得要删除这些变量
-            Interactor::instance()->createVariable("_e");
-            Interactor::instance()->createVariable("_len");
-            ElemType *_len = Interactor::instance()->getVariable("_len");
-
-            // 此处本可以直接使用 length 成员，但出于演示目的使用了 Length 函数
-            //*_len = pListTarget->length;
-            //auto sourceLen = pListSource->length;
-            *_len = SequenceListLength::instance()->invoke({args[0]});
-            auto sourceLen = SequenceListLength::instance()->invoke({args[1]});
-
-            for (int i = 1; i <= sourceLen; ++i) {
-                GetElemInSequenceList::instance()->invoke({args[1], to_string(i), "_e"});
-                // 如果 Target 中不存在和 _e 相同（相等）的元素，则将其插入到 Target 的尾部
-                if (!LocateElemInSequenceList::instance()->invoke({args[0], "_e"})) {
-                    SequenceListInsert::instance()->invoke({args[0], "_len", "_e"});
-                }
-            }
+        Status invoke(const ArgBlock &args) override {
+            return Union_Sq(*args.adt<SequenceList>(0), *args.adt<SequenceList>(1));
+        }
 
-            // 最后记得删除创建的临时变量
-            Interactor::instance()->deleteVariable("_e");
-            Interactor::instance()->deleteVariable("_len");
-            return DSCxx_OK;
+        // 逆操作：Target 为普通线性表时新元素只追加在尾部，恢复原来的长度即可；有序的 Target 会在中间插入，只能保存快照
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pTarget = args.adt<SequenceList>(0);
+            if (pTarget->sorted) {
+                steps.push_back({ 0, nullptr });
+                return true;
+            }
+            int length = pTarget->length;
+            uint64_t version = pTarget->storageVersion;
+            steps.push_back({ 0, [length, version](ADTObject *obj) {
+                auto pTarget = static_cast<SequenceList *>(obj);
+                pTarget->length = length;
+                pTarget->storageVersion = version;
+            } });
+            return true;
         }
     };
 
@@ -356,69 +243,53 @@ namespace DataStructure_Cxx {
 
     class MergeSequenceList : public Function {
     ENABLE_SINGLETON(MergeSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList), ADT_FAMILY_ARG(SequenceList), ADT_FAMILY_ARG(SequenceList))
+    SNAPSHOT_ARGS(2)
 
     public:
-        Status invoke(const vector<string> &args) override {
-            SequenceList *pListSourceA = (SequenceList *) Interactor::instance()->getADT(args[0]);
-            SequenceList *pListSourceB = (SequenceList *) Interactor::instance()->getADT(args[1]);
-            SequenceList *pListTarget = (SequenceList *) Interactor::instance()->getADT(args[2]);
-            // 已知线性表 SourceA 和 SourceB 中的数据元素按值非递减排列
-            // 归并 SourceA 和 SourceB 得到新的线性表 Target，Target 的数据元素也按值非递减排列
-            InitSequenceList::instance()->invoke({args[2]});
-
-            // 创建临时变量
-            Interactor::instance()->createVariable("_i");
-            auto _i = Interactor::instance()->getVariable("_i");
-            Interactor::instance()->createVariable("_j");
-            auto _j = Interactor::instance()->getVariable("_j");
-            Interactor::instance()->createVariable("_k");
-            auto _k = Interactor::instance()->getVariable("_k");
-            Interactor::instance()->createVariable("_ai");
-            auto _ai = Interactor::instance()->getVariable("_ai");
-            Interactor::instance()->createVariable("_bj");
-            auto _bj = Interactor::instance()->getVariable("_bj");
-
-            *_i = *_j = 1;
-            *_k = 0;
-
-            auto aLen = pListSourceA->length;
-            auto bLen = pListSourceB->length;
-
-            // 首先将 SourceA 和 SourceB 中较小的元素按顺序插入到 Target 中
-            while ((*_i <= aLen) && (*_j <= bLen)) {
-                GetElemInSequenceList::instance()->invoke({args[0], "_i", "_ai"});
-                GetElemInSequenceList::instance()->invoke({args[1], "_j", "_bj"});
-                ++*_k; // 递增在 Target 中插入位置的索引值
-                if (*_ai <= *_bj) {
-                    SequenceListInsert::instance()->invoke({args[2], "_k", "_ai"});
-                    ++*_i; // 递增当前在 SourceA 中定位的索引值
-                } else {
-                    SequenceListInsert::instance()->invoke({args[2], "_k", "_bj"});
-                    ++*_j; // 递增当前在 SourceB 中定位的索引值
-                }
-            }
+        Status invoke(const ArgBlock &args) override {
+            return MergeList_Sq(*args.adt<SequenceList>(0), *args.adt<SequenceList>(1), *args.adt<SequenceList>(2));
+        }
+    };
+    SINGLETON_MEMBER(MergeSequenceList)
 
-            // 如果还有剩余元素，则也将其插入 Target 中
-            while (*_i <= aLen) {
-                ++*_i;
-                ++*_k;
-                GetElemInSequenceList::instance()->invoke({args[0], "_i", "_ai"});
-                SequenceListInsert::instance()->invoke({args[2], "_k", "_ai"});
-            }
-            while (*_j <= bLen) {
-                ++*_j;
-                ++*_k;
-                GetElemInSequenceList::instance()->invoke({args[1], "_j", "_bj"});
-                SequenceListInsert::instance()->invoke({args[2], "_k", "_bj"});
-            }
+    // 改用映射存储（参见 ListStorage.hpp），当前平台不支持时返回 INFEASIBLE
+    class MapSequenceList : public Function {
+    ENABLE_SINGLETON(MapSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList))
 
-            // 删除临时变量
-            Interactor::instance()->deleteVariable("_i");
-            Interactor::instance()->deleteVariable("_j");
-            Interactor::instance()->deleteVariable("_k");
-            return DSCxx_OK;
+    public:
+        Status invoke(const ArgBlock &args) override {
+            return MapList_Sq(*args.adt<SequenceList>(0));
         }
     };
-    SINGLETON_MEMBER(MergeSequenceList)
 
-}
\ No newline at end of file
+    SINGLETON_MEMBER(MapSequenceList)
+
+    // 改回堆上的存储
+    class UnmapSequenceList : public Function {
+    ENABLE_SINGLETON(UnmapSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            return UnmapList_Sq(*args.adt<SequenceList>(0));
+        }
+    };
+
+    SINGLETON_MEMBER(UnmapSequenceList)
+
+    // 将存储容量缩减到刚好容纳现有元素
+    class ShrinkSequenceList : public Function {
+    ENABLE_SINGLETON(ShrinkSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            return ShrinkList_Sq(*args.adt<SequenceList>(0));
+        }
+    };
+
+    SINGLETON_MEMBER(ShrinkSequenceList)
+
+}
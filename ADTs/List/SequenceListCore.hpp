@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "ListPreDef.hpp"
+#include "ListStorage.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace DataStructure_Cxx {
+    // 存储空间的版本号：全局递增，每个线性表对象创建时以及每次重新分配、释放存储空间时都取一个新值，
+    // 引用线性表的视图（参见 SequenceListView.hpp）据此判断基址是否已经失效
+    inline uint64_t NextListStorageVersion() {
+        static atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    class SequenceList : public ADTObject {
+    public:
+        ElemType *elem = nullptr;   // 存储空间基址
+        int length;                 // 当前实际的长度（即有多少非空的元素）
+        int listsize;               // 当前分配的存储容量（以 sizeof(ElemType) 为单位）
+        bool sorted = false;        // 元素是否始终按值非递减排列（只有 SortedSequenceList 为 true）
+        bool mapped = false;        // 是否使用映射存储（参见 ListStorage.hpp）
+        bool external = false;      // 存储空间属于外部（例如其他进程发布的共享内存，参见 SharedSequenceList.hpp），只读
+        uint64_t storageVersion = NextListStorageVersion();
+
+        // 修改 elem 之后调用
+        void storageChanged() {
+            storageVersion = NextListStorageVersion();
+        }
+
+        ADTObject *copy() override {
+            auto pastedObj = new SequenceList;
+            pastedObj->elem = elem;
+            pastedObj->length = length;
+            pastedObj->listsize = listsize;
+            pastedObj->mapped = mapped;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "SequenceList";
+        }
+
+        ADTObject *clone() override {
+            auto clonedObj = new SequenceList;
+            clonedObj->length = length;
+            clonedObj->listsize = listsize;
+            clonedObj->mapped = mapped;
+            if (elem != nullptr) {
+                clonedObj->elem = AllocListStorage(listsize, mapped, clonedObj->listsize);
+                memcpy(clonedObj->elem, elem, length * sizeof(ElemType));
+            }
+            return clonedObj;
+        }
+
+        void release() override {
+            FreeListStorage(elem, listsize, mapped);
+            elem = nullptr;
+            storageChanged();
+        }
+
+        // 格式：是否已初始化、是否使用映射存储、长度、各元素（派生的 SortedSequenceList 同样适用）
+        void serialize(string& out) override {
+            putU8(out, elem != nullptr);
+            putU8(out, mapped);
+            putI32(out, elem != nullptr ? length : 0);
+            if (elem != nullptr) {
+                putI32Array(out, elem, length);
+            }
+        }
+
+        bool deserialize(BinaryReader& in) override {
+            bool initialized = in.getU8() != 0;
+            mapped = in.getU8() != 0 && ListMappedStorageSupported();
+            int size = in.getI32();
+            if (!in.ok || size < 0 || !in.require((size_t)size * sizeof(int32_t))) return false;
+            if (!initialized) return true;
+            int capacity = (size > LIST_INIT_SIZE) ? size : LIST_INIT_SIZE;
+            elem = AllocListStorage(capacity, mapped, listsize);
+            storageChanged();
+            length = size;
+            return in.getI32Array(elem, size);
+        }
+    };
+
+    // 将线性表的长度直接设置为 length（必要时扩充存储容量），供批量写入结果的指令使用
+    // 新增位置上的元素值未定义，调用者需要自行填充
+    inline Status ResizeSequenceList(SequenceList *pList, int length) {
+        if (length < 0 || pList->external) {
+            return DSCxx_ERROR;
+        }
+        if (pList->elem == nullptr || pList->listsize < length) {
+            int newSize = (length > LIST_INIT_SIZE) ? length : LIST_INIT_SIZE;
+            pList->elem = ReallocListStorage(pList->elem, pList->listsize, newSize, pList->mapped, pList->listsize);
+            pList->storageChanged();
+        }
+        pList->length = length;
+        return DSCxx_OK;
+    }
+
+    // 存储空间已满时扩充存储容量：堆上的存储每次增加 LISTINCREMENT 个元素，
+    // 映射存储扩充时不复制数据，按当前容量的一半增长，以减少系统调用的次数
+    inline void GrowSequenceList(SequenceList *pList) {
+        int increment = LISTINCREMENT;
+        if (pList->mapped && pList->listsize / 2 > increment) {
+            increment = pList->listsize / 2;
+        }
+        pList->elem = ReallocListStorage(pList->elem, pList->listsize, pList->listsize + increment,
+                                         pList->mapped, pList->listsize);
+        pList->storageChanged();
+    }
+
+    // 在按值非递减排列的 n 个元素中查找第一个不小于 key（Upper 为 true 时为大于 key）的元素的下标，不存在时返回 n
+    // 无分支的二分查找：循环次数只取决于 n，比较结果通过条件传送更新 base，不会出现分支预测失败
+    template<bool Upper>
+    inline int SortedBound(const ElemType *elem, int n, ElemType key) {
+        if (n <= 0) return 0;
+        const ElemType *base = elem;
+        while (n > 1) {
+            int half = n / 2;
+            base = (Upper ? base[half] <= key : base[half] < key) ? base + half : base;
+            n -= half;
+        }
+        return (int) (base - elem) + (Upper ? *base <= key : *base < key);
+    }
+
+    // 在有序线性表中插入元素 e 并保持有序（插在所有相等元素之后），返回插入的位序
+    inline int InsertSortedElem(SequenceList *pList, ElemType e) {
+        int index = SortedBound<true>(pList->elem, pList->length, e);
+        if (pList->length >= pList->listsize) {
+            GrowSequenceList(pList);
+        }
+        memmove(pList->elem + index + 1, pList->elem + index, (pList->length - index) * sizeof(ElemType));
+        pList->elem[index] = e;
+        ++pList->length;
+        return index + 1;
+    }
+
+    // 两个线性表都有序时的并集：按归并的方式线性地扫描一遍，Source 中不在 Target 中的元素按序插入，结果仍然有序
+    inline Status UnionSortedSequenceList(SequenceList *pTarget, const SequenceList *pSource) {
+        int na = pTarget->length, nb = pSource->length;
+        int size = (na + nb > LIST_INIT_SIZE) ? na + nb : LIST_INIT_SIZE;
+        auto c = AllocListStorage(size, pTarget->mapped, size);
+        const ElemType *a = pTarget->elem, *b = pSource->elem;
+        int i = 0, k = 0;
+        for (int j = 0; j < nb; ++j) {
+            if (j % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                FreeListStorage(c, size, pTarget->mapped);
+                return DSCxx_INFEASIBLE;
+            }
+            ElemType v = b[j];
+            while (i < na && a[i] < v) c[k++] = a[i++];
+            // v 已经在 Target 中，或者与刚插入的 Source 元素相同（c 有序，只需看最后一个）
+            if ((i < na && a[i] == v) || (k > 0 && c[k - 1] == v)) continue;
+            c[k++] = v;
+        }
+        memcpy(c + k, a + i, (na - i) * sizeof(ElemType));
+        k += na - i;
+        FreeListStorage(pTarget->elem, pTarget->listsize, pTarget->mapped);
+        pTarget->elem = c;
+        pTarget->storageChanged();
+        pTarget->length = k;
+        pTarget->listsize = size;
+        return DSCxx_OK;
+    }
+
+    // 两个线性表都有序时的归并：直接在数组上线性归并，不再逐个元素调用 GetElem、Insert
+    inline Status MergeSortedSequenceList(const SequenceList *pA, const SequenceList *pB, SequenceList *pTarget) {
+        int na = pA->length, nb = pB->length;
+        int size = (na + nb > LIST_INIT_SIZE) ? na + nb : LIST_INIT_SIZE;
+        auto c = AllocListStorage(size, pTarget->mapped, size);
+        const ElemType *a = pA->elem, *b = pB->elem;
+        int i = 0, j = 0, k = 0;
+        while (i < na && j < nb) {
+            if (k % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                FreeListStorage(c, size, pTarget->mapped);
+                return DSCxx_INFEASIBLE;
+            }
+            c[k++] = (a[i] <= b[j]) ? a[i++] : b[j++];
+        }
+        memcpy(c + k, a + i, (na - i) * sizeof(ElemType));
+        k += na - i;
+        memcpy(c + k, b + j, (nb - j) * sizeof(ElemType));
+        k += nb - j;
+        // 目标可能就是某个输入，所以归并完成之后才释放它原来的存储空间
+        FreeListStorage(pTarget->elem, pTarget->listsize, pTarget->mapped);
+        pTarget->elem = c;
+        pTarget->storageChanged();
+        pTarget->length = k;
+        pTarget->listsize = size;
+        return DSCxx_OK;
+    }
+
+    // 以下为线性表的类型化接口：直接以对象、整数和元素为参数，不经过 Interactor 的解析、查找和分派，
+    // 可以在其他程序中直接调用（参见 DSCxx.hpp）；函数名沿用教材中的写法，Interactor 中的指令只是它们的包装
+    // 位序都从 1 开始，对未初始化的线性表操作时返回 DSCxx_ERROR，修改存储空间属于外部的线性表时同样返回 DSCxx_ERROR
+
+    inline Status InitList_Sq(SequenceList &L) {
+        if (L.external) {
+            return DSCxx_ERROR;
+        }
+        L.elem = AllocListStorage(LIST_INIT_SIZE, L.mapped, L.listsize);
+        L.storageChanged();
+        L.length = 0;
+        return DSCxx_OK;
+    }
+
+    inline Status DestroyList_Sq(SequenceList &L) {
+        if (L.elem == nullptr || L.external) {
+            return DSCxx_ERROR;
+        }
+        FreeListStorage(L.elem, L.listsize, L.mapped);
+        L.elem = nullptr;
+        L.storageChanged();
+        return DSCxx_OK;
+    }
+
+    inline Status ClearList_Sq(SequenceList &L) {
+        // 清除操作实际上是：首先销毁，然后再初始化
+        DestroyList_Sq(L);
+        return InitList_Sq(L);
+    }
+
+    inline Status ListEmpty_Sq(const SequenceList &L) {
+        if (L.elem == nullptr) {
+            return DSCxx_ERROR;
+        }
+        // 直接判断 length 即可
+        return (L.length == 0) ? DSCxx_TRUE : DSCxx_FALSE;
+    }
+
+    inline Status ListLength_Sq(const SequenceList &L) {
+        if (L.elem == nullptr) {
+            return DSCxx_ERROR;
+        }
+        return L.length;
+    }
+
+    inline Status GetElem_Sq(const SequenceList &L, int i, ElemType &e) {
+        TRACE_FINE_SCOPE("GetElem_Sq", i);
+        if (L.elem == nullptr || i < 1 || i > L.length) {
+            return DSCxx_ERROR;
+        }
+        e = L.elem[i - 1];
+        return DSCxx_OK;
+    }
+
+    // 查找第一个值与 e 相等的元素的位序，不存在时返回 0
+    inline Status LocateElem_Sq(const SequenceList &L, ElemType e) {
+        TRACE_FINE_SCOPE("LocateElem_Sq", e);
+        if (L.elem == nullptr) {
+            return DSCxx_ERROR;
+        }
+        if (L.sorted) {
+            // 有序线性表使用无分支的二分查找
+            int index = SortedBound<false>(L.elem, L.length, e);
+            return (index < L.length && L.elem[index] == e) ? index + 1 : 0;
+        }
+        int i = 1;
+        auto p = L.elem;
+        while (i <= L.length && *p != e) {
+            ++i;
+            ++p;
+        }
+        return (i <= L.length) ? i : 0;
+    }
+
+    // 用 pre 返回 cur 在线性表中的前驱：先查找 cur 的位置，然后再设定 pre
+    inline Status PriorElem_Sq(const SequenceList &L, ElemType cur, ElemType &pre) {
+        int location = LocateElem_Sq(L, cur);
+        if (location <= 1) {
+            return DSCxx_ERROR;
+        }
+        pre = L.elem[location - 2]; // 索引比位序小 1，前一个元素还需减 1，所以需要减 2
+        return DSCxx_OK;
+    }
+
+    inline Status NextElem_Sq(const SequenceList &L, ElemType cur, ElemType &next) {
+        int location = LocateElem_Sq(L, cur);
+        // 不存在或者是最后一个元素时没有后继
+        if (location == 0 || location == L.length) {
+            return DSCxx_ERROR;
+        }
+        next = L.elem[location]; // 位序比索引大 1，后一个元素还需加 1，正好抵消
+        return DSCxx_OK;
+    }
+
+    // 按位序插入会破坏有序线性表的顺序，所以对有序线性表返回 DSCxx_ERROR（应使用 InsertSortedElem）
+    inline Status ListInsert_Sq(SequenceList &L, int i, ElemType e) {
+        TRACE_FINE_SCOPE("ListInsert_Sq", i, e);
+        // 执行插入后，新插入的元素在新的线性表中的位置为 i，所以 i 最小为 1，最大可为 length + 1
+        if (L.elem == nullptr || L.external || L.sorted || i < 1 || i > L.length + 1) {
+            return DSCxx_ERROR;
+        }
+        // 如果存储空间已满，则需要先增加分配，再插入元素
+        if (L.length >= L.listsize) {
+            GrowSequenceList(&L);
+        }
+        // 获取插入位置
+        auto q = &(L.elem[i - 1]); // 位置 i 对应的索引为 i - 1，所以需将 i - 1 及其后的元素全部后移一位
+        for (auto p = &(L.elem[L.length - 1]); p >= q; --p) {
+            *(p + 1) = *p;
+        }
+        *q = e;
+        ++L.length;
+        return DSCxx_OK;
+    }
+
+    // 删除的元素用 e 返回
+    inline Status ListDelete_Sq(SequenceList &L, int i, ElemType &e) {
+        TRACE_FINE_SCOPE("ListDelete_Sq", i);
+        if (L.elem == nullptr || L.external || i < 1 || i > L.length) {
+            return DSCxx_ERROR;
+        }
+        auto p = &(L.elem[i - 1]);
+        e = *p;
+        auto q = L.elem + L.length - 1;
+        for (++p; p <= q; ++p) {
+            *(p - 1) = *p;
+        }
+        --L.length;
+        return DSCxx_OK;
+    }
+
+    // 对顺序线性表中每个数据元素调用 visit()，一旦 visit() 失败，则操作失败
+    template<typename Visit>
+    inline Status ListTraverse_Sq(SequenceList &L, Visit visit) {
+        if (L.elem == nullptr) {
+            return DSCxx_ERROR;
+        }
+        for (int i = 0; i < L.length; ++i) {
+            if (visit(L.elem[i]) != DSCxx_OK) return DSCxx_ERROR;
+        }
+        return DSCxx_OK;
+    }
+
+    // 将所有在线性表 Source 中但不在 Target 中的数据元素插入到 Target 中
+    inline Status Union_Sq(SequenceList &target, const SequenceList &source) {
+        TRACE_SCOPE("Union_Sq", target.length, source.length);
+        if (source.elem == nullptr || target.elem == nullptr || target.external) {
+            return DSCxx_ERROR;
+        }
+        if (target.sorted && source.sorted) {
+            return UnionSortedSequenceList(&target, &source);
+        }
+        if (target.sorted) {
+            // 只有 Target 有序时，二分查找每个元素并有序插入，保持 Target 的有序性
+            for (int i = 0; i < source.length; ++i) {
+                if ((i + 1) % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return DSCxx_INFEASIBLE;
+                }
+                ElemType e = source.elem[i];
+                int index = SortedBound<false>(target.elem, target.length, e);
+                if (index == target.length || target.elem[index] != e) {
+                    InsertSortedElem(&target, e);
+                }
+            }
+            return DSCxx_OK;
+        }
+        ElemType e = 0;
+        int len = ListLength_Sq(target);
+        int sourceLen = ListLength_Sq(source);
+        for (int i = 1; i <= sourceLen; ++i) {
+            // 在后台执行时，每处理完一块数据检查一次是否已被取消
+            if (i % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                return DSCxx_INFEASIBLE;
+            }
+            GetElem_Sq(source, i, e);
+            // 如果 Target 中不存在和 e 相同（相等）的元素，则将其插入到 Target 的尾部
+            if (!LocateElem_Sq(target, e)) {
+                ListInsert_Sq(target, ++len, e);
+            }
+        }
+        return DSCxx_OK;
+    }
+
+    // 已知线性表 SourceA 和 SourceB 中的数据元素按值非递减排列
+    // 归并 SourceA 和 SourceB 得到新的线性表 Target，Target 的数据元素也按值非递减排列
+    inline Status MergeList_Sq(const SequenceList &a, const SequenceList &b, SequenceList &target) {
+        TRACE_SCOPE("MergeList_Sq", a.length, b.length);
+        if (target.external) {
+            return DSCxx_ERROR;
+        }
+        if (a.elem == nullptr || b.elem == nullptr) {
+            return DSCxx_ERROR;
+        }
+        if (a.sorted && b.sorted) {
+            // 两者都是有序线性表时，有序性由其本身保证，可以直接在数组上线性归并
+            return MergeSortedSequenceList(&a, &b, &target);
+        }
+        if (target.sorted) {
+            // 普通线性表的有序性无法保证，不能写入有序线性表
+            return DSCxx_ERROR;
+        }
+        InitList_Sq(target);
+
+        int i = 1, j = 1, k = 0;
+        ElemType ai = 0, bj = 0;   // 两个线性表都已初始化，GetElem_Sq 总会写入，初始化只为消除编译器的警告
+        auto aLen = a.length;
+        auto bLen = b.length;
+
+        Status result = DSCxx_OK;
+        // 首先将 SourceA 和 SourceB 中较小的元素按顺序插入到 Target 中
+        while ((i <= aLen) && (j <= bLen)) {
+            // 在后台执行时，每处理完一块数据检查一次是否已被取消
+            if (k % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                result = DSCxx_INFEASIBLE;
+                break;
+            }
+            GetElem_Sq(a, i, ai);
+            GetElem_Sq(b, j, bj);
+            ++k; // 递增在 Target 中插入位置的索引值
+            if (ai <= bj) {
+                ListInsert_Sq(target, k, ai);
+                ++i; // 递增当前在 SourceA 中定位的索引值
+            } else {
+                ListInsert_Sq(target, k, bj);
+                ++j; // 递增当前在 SourceB 中定位的索引值
+            }
+        }
+
+        // 如果还有剩余元素，则也将其插入 Target 中（被取消时不再处理）
+        if (result != DSCxx_OK) {
+            i = aLen + 1;
+            j = bLen + 1;
+        }
+        while (i <= aLen) {
+            GetElem_Sq(a, i++, ai);
+            ListInsert_Sq(target, ++k, ai);
+        }
+        while (j <= bLen) {
+            GetElem_Sq(b, j++, bj);
+            ListInsert_Sq(target, ++k, bj);
+        }
+        return result;
+    }
+
+    // 改用映射存储（参见 ListStorage.hpp），已有的元素被移动到新的映射中；也可以在初始化之前调用
+    // 当前平台不支持映射存储时返回 INFEASIBLE
+    inline Status MapList_Sq(SequenceList &L) {
+        if (L.external) {
+            return DSCxx_ERROR;
+        }
+        if (!ListMappedStorageSupported()) {
+            return DSCxx_INFEASIBLE;
+        }
+        if (L.mapped) {
+            return DSCxx_OK;
+        }
+        if (L.elem != nullptr) {
+            int capacity;
+            auto newBase = AllocListStorage(L.listsize, true, capacity);
+            memcpy(newBase, L.elem, L.length * sizeof(ElemType));
+            FreeListStorage(L.elem, L.listsize, false);
+            L.elem = newBase;
+            L.listsize = capacity;
+            L.storageChanged();
+        }
+        L.mapped = true;
+        return DSCxx_OK;
+    }
+
+    // 改回堆上的存储
+    inline Status UnmapList_Sq(SequenceList &L) {
+        if (L.external) {
+            return DSCxx_ERROR;
+        }
+        if (!L.mapped) {
+            return DSCxx_OK;
+        }
+        if (L.elem != nullptr) {
+            int capacity;
+            auto newBase = AllocListStorage(L.listsize, false, capacity);
+            memcpy(newBase, L.elem, L.length * sizeof(ElemType));
+            FreeListStorage(L.elem, L.listsize, true);
+            L.elem = newBase;
+            L.listsize = capacity;
+            L.storageChanged();
+        }
+        L.mapped = false;
+        return DSCxx_OK;
+    }
+
+    // 将存储容量缩减到刚好容纳现有元素（不少于 LIST_INIT_SIZE），多余的空间归还给系统
+    inline Status ShrinkList_Sq(SequenceList &L) {
+        if (L.elem == nullptr || L.external) {
+            return DSCxx_ERROR;
+        }
+        int size = (L.length > LIST_INIT_SIZE) ? L.length : LIST_INIT_SIZE;
+        if (ListStorageCapacity(size, L.mapped) < L.listsize) {
+            L.elem = ReallocListStorage(L.elem, L.listsize, size, L.mapped, L.listsize);
+            L.storageChanged();
+        }
+        return DSCxx_OK;
+    }
+}
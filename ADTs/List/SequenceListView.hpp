@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "SequenceList.hpp"
+
+#include <climits>
+
+namespace DataStructure_Cxx {
+
+    // 线性表的视图：引用某个线性表中的一段元素，不复制数据
+    // 视图中的第 k 个元素（从 0 开始）为基础线性表中下标为 from + k * step 的元素，step 为负数时逆序访问
+    // 视图通过句柄引用基础线性表，并记录创建时的存储版本号（参见 SequenceList::storageVersion），
+    // 基础线性表被删除、存储空间被重新分配或者长度缩短到视图范围以内时，视图即失效，之后的访问都返回 INFEASIBLE
+    class SequenceListView : public ADTObject {
+    public:
+        bool bound = false;         // 是否已经引用了某个线性表
+        ADTHandle base;
+        string baseName;
+        uint64_t baseVersion = 0;
+        int from = 0;
+        int count = 0;
+        int step = 1;
+
+        ADTObject *copy() override {
+            auto pastedObj = new SequenceListView;
+            pastedObj->bound = bound;
+            pastedObj->base = base;
+            pastedObj->baseName = baseName;
+            pastedObj->baseVersion = baseVersion;
+            pastedObj->from = from;
+            pastedObj->count = count;
+            pastedObj->step = step;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "SequenceListView";
+        }
+
+        ADTObject *clone() override {
+            return copy();
+        }
+
+        void release() override {
+            bound = false;
+        }
+
+        // 视图覆盖的最大下标
+        int lastIndex() const {
+            return (step > 0) ? from + (count - 1) * step : from;
+        }
+
+        // 取得基础线性表，视图失效时返回 nullptr
+        SequenceList *resolve() const {
+            if (!bound) return nullptr;
+            auto pList = static_cast<SequenceList *>(Interactor::instance()->findADT(base));
+            if (pList == nullptr || pList->elem == nullptr || pList->storageVersion != baseVersion) {
+                return nullptr;
+            }
+            if (count > 0 && lastIndex() >= pList->length) {
+                return nullptr;
+            }
+            return pList;
+        }
+
+        // 格式：状态（0 未绑定，1 有效，2 已失效）、基础线性表的名称、from、count、step
+        // 恢复时按名称重新绑定，已失效的视图恢复后仍然失效
+        void serialize(string &out) override {
+            putU8(out, !bound ? 0 : (resolve() != nullptr ? 1 : 2));
+            putString(out, baseName);
+            putI32(out, from);
+            putI32(out, count);
+            putI32(out, step);
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            int state = in.getU8();
+            baseName = in.getString();
+            from = in.getI32();
+            count = in.getI32();
+            step = in.getI32();
+            if (!in.ok || state > 2) return false;
+            bound = state != 0;
+            if (state == 1) {
+                base = Interactor::instance()->findADTHandle(baseName);
+                auto pList = static_cast<SequenceList *>(Interactor::instance()->findADT(base));
+                baseVersion = (pList != nullptr) ? pList->storageVersion : 0;
+            }
+            return true;
+        }
+
+        // 持有 registryMutex 时调用，不能再通过 findADT 加锁
+        ADTObject *dependency(string &name) override {
+            if (!bound) return nullptr;
+            name = baseName;
+            return Interactor::instance()->resolveADT(base);
+        }
+    };
+
+    inline ElemType ViewElemAt(const SequenceList *pList, const SequenceListView *pView, int k) {
+        return pList->elem[pView->from + k * pView->step];
+    }
+
+    // 引用线性表中位序为 [from, to) 的元素，from == to 时为空视图
+    class ViewSequenceList : public Function {
+    ENABLE_SINGLETON(ViewSequenceList)
+    SIGNATURE(ADT_ARG(SequenceListView), ADT_FAMILY_ARG(SequenceList), INT_ARG, INT_ARG)
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pView = args.adt<SequenceListView>(0);
+            auto pList = args.adt<SequenceList>(1);
+            int from = args.value(2), to = args.value(3);
+            if (pList->elem == nullptr || from < 1 || from > to || to > pList->length + 1) {
+                return DSCxx_ERROR;
+            }
+            string name;
+            auto handle = Interactor::instance()->findADTHandle(pList, name);
+            if (handle.type == UINT32_MAX) {
+                return DSCxx_ERROR;
+            }
+            pView->bound = true;
+            pView->base = handle;
+            pView->baseName = name;
+            pView->baseVersion = pList->storageVersion;
+            pView->from = from - 1;
+            pView->count = to - from;
+            pView->step = 1;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(ViewSequenceList)
+
+    // 将视图变为逆序，再次调用恢复原来的顺序
+    class ReverseSequenceListView : public Function {
+    ENABLE_SINGLETON(ReverseSequenceListView)
+    SIGNATURE(ADT_ARG(SequenceListView))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pView = args.adt<SequenceListView>(0);
+            if (pView->resolve() == nullptr) {
+                return pView->bound ? DSCxx_INFEASIBLE : DSCxx_ERROR;
+            }
+            if (pView->count > 0) {
+                pView->from += (pView->count - 1) * pView->step;
+            }
+            pView->step = -pView->step;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(ReverseSequenceListView)
+
+    // 每隔 k 个元素取一个（从视图的第一个元素开始），k 为 1 时不变
+    class StrideSequenceListView : public Function {
+    ENABLE_SINGLETON(StrideSequenceListView)
+    SIGNATURE(ADT_ARG(SequenceListView), INT_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pView = args.adt<SequenceListView>(0);
+            int k = args.value(1);
+            if (pView->resolve() == nullptr) {
+                return pView->bound ? DSCxx_INFEASIBLE : DSCxx_ERROR;
+            }
+            if (k < 1 || (long long) pView->step * k > INT_MAX || (long long) pView->step * k < -INT_MAX) {
+                return DSCxx_ERROR;
+            }
+            pView->count = (pView->count + k - 1) / k;
+            pView->step *= k;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(StrideSequenceListView)
+
+    class SequenceListViewLength : public Function {
+    ENABLE_SINGLETON(SequenceListViewLength)
+    SIGNATURE(ADT_ARG(SequenceListView))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pView = args.adt<SequenceListView>(0);
+            if (pView->resolve() == nullptr) {
+                return pView->bound ? DSCxx_INFEASIBLE : DSCxx_ERROR;
+            }
+            return pView->count;
+        }
+    };
+
+    SINGLETON_MEMBER(SequenceListViewLength)
+
+    class GetElemInSequenceListView : public Function {
+    ENABLE_SINGLETON(GetElemInSequenceListView)
+    SIGNATURE(ADT_ARG(SequenceListView), INT_ARG, VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pView = args.adt<SequenceListView>(0);
+            auto pList = pView->resolve();
+            if (pList == nullptr) {
+                return pView->bound ? DSCxx_INFEASIBLE : DSCxx_ERROR;
+            }
+            int i = args.value(1);
+            if (i < 1 || i > pView->count) {
+                return DSCxx_ERROR;
+            }
+            *args.var(2) = ViewElemAt(pList, pView, i - 1);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(GetElemInSequenceListView)
+
+    // 返回元素在视图中的位序，不存在时返回 0
+    class LocateElemInSequenceListView : public Function {
+    ENABLE_SINGLETON(LocateElemInSequenceListView)
+    SIGNATURE(ADT_ARG(SequenceListView), VAR_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pView = args.adt<SequenceListView>(0);
+            auto pList = pView->resolve();
+            if (pList == nullptr) {
+                return pView->bound ? DSCxx_INFEASIBLE : DSCxx_ERROR;
+            }
+            ElemType e = *args.var(1);
+            for (int k = 0; k < pView->count; ++k) {
+                if (ViewElemAt(pList, pView, k) == e) return k + 1;
+            }
+            return 0;
+        }
+    };
+
+    SINGLETON_MEMBER(LocateElemInSequenceListView)
+
+    // 视图中所有元素的和，超出 ElemType 的范围时返回 OVERFLOW
+    class SumOfSequenceListView : public Function {
+    ENABLE_SINGLETON(SumOfSequenceListView)
+    SIGNATURE(ADT_ARG(SequenceListView), VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pView = args.adt<SequenceListView>(0);
+            auto pList = pView->resolve();
+            if (pList == nullptr) {
+                return pView->bound ? DSCxx_INFEASIBLE : DSCxx_ERROR;
+            }
+            long long sum = 0;
+            for (int k = 0; k < pView->count; ++k) {
+                if (k % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return DSCxx_INFEASIBLE;
+                }
+                sum += ViewElemAt(pList, pView, k);
+            }
+            if (sum > INT_MAX || sum < INT_MIN) {
+                return DSCxx_OVERFLOW;
+            }
+            *args.var(1) = (ElemType) sum;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(SumOfSequenceListView)
+
+    // 视图中的最小值（Max 为 false）或最大值，视图为空时返回 ERROR
+    template<bool Max>
+    inline Status ExtremeOfSequenceListView(const SequenceListView *pView, ElemType &e) {
+        auto pList = pView->resolve();
+        if (pList == nullptr) {
+            return pView->bound ? DSCxx_INFEASIBLE : DSCxx_ERROR;
+        }
+        if (pView->count == 0) {
+            return DSCxx_ERROR;
+        }
+        ElemType best = ViewElemAt(pList, pView, 0);
+        for (int k = 1; k < pView->count; ++k) {
+            ElemType v = ViewElemAt(pList, pView, k);
+            if (Max ? v > best : v < best) best = v;
+        }
+        e = best;
+        return DSCxx_OK;
+    }
+
+    class MaxInSequenceListView : public Function {
+    ENABLE_SINGLETON(MaxInSequenceListView)
+    SIGNATURE(ADT_ARG(SequenceListView), VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            return ExtremeOfSequenceListView<true>(args.adt<SequenceListView>(0), *args.var(1));
+        }
+    };
+
+    SINGLETON_MEMBER(MaxInSequenceListView)
+
+    class MinInSequenceListView : public Function {
+    ENABLE_SINGLETON(MinInSequenceListView)
+    SIGNATURE(ADT_ARG(SequenceListView), VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            return ExtremeOfSequenceListView<false>(args.adt<SequenceListView>(0), *args.var(1));
+        }
+    };
+
+    SINGLETON_MEMBER(MinInSequenceListView)
+
+    // 将视图中的元素复制到线性表 Target 中（Target 原有的内容被覆盖），Target 为有序线性表时视图必须非递减
+    class CopySequenceListView : public Function {
+    ENABLE_SINGLETON(CopySequenceListView)
+    SIGNATURE(ADT_ARG(SequenceListView), ADT_FAMILY_ARG(SequenceList))
+    SNAPSHOT_ARGS(1)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pView = args.adt<SequenceListView>(0);
+            auto pTarget = args.adt<SequenceList>(1);
+            auto pList = pView->resolve();
+            if (pList == nullptr) {
+                return pView->bound ? DSCxx_INFEASIBLE : DSCxx_ERROR;
+            }
+            vector<ElemType> buffer(pView->count);
+            for (int k = 0; k < pView->count; ++k) {
+                if (k % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return DSCxx_INFEASIBLE;
+                }
+                buffer[k] = ViewElemAt(pList, pView, k);
+                if (pTarget->sorted && k > 0 && buffer[k] < buffer[k - 1]) {
+                    return DSCxx_ERROR;
+                }
+            }
+            // Target 可能就是基础线性表，所以先复制到缓冲区中
+            if (ResizeSequenceList(pTarget, pView->count) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            memcpy(pTarget->elem, buffer.data(), buffer.size() * sizeof(ElemType));
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(CopySequenceListView)
+
+    // 已知视图 A 和 B 中的元素按值非递减排列，归并得到 Target，例如把同一个线性表的前后两半归并
+    class MergeSequenceListViews : public Function {
+    ENABLE_SINGLETON(MergeSequenceListViews)
+    SIGNATURE(ADT_ARG(SequenceListView), ADT_ARG(SequenceListView), ADT_FAMILY_ARG(SequenceList))
+    SNAPSHOT_ARGS(2)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pA = args.adt<SequenceListView>(0);
+            auto pB = args.adt<SequenceListView>(1);
+            auto pTarget = args.adt<SequenceList>(2);
+            auto pListA = pA->resolve(), pListB = pB->resolve();
+            if (pListA == nullptr || pListB == nullptr) {
+                return (pA->bound && pB->bound) ? DSCxx_INFEASIBLE : DSCxx_ERROR;
+            }
+            int na = pA->count, nb = pB->count;
+            if (pTarget->sorted) {
+                // 视图的有序性无法保证，写入有序线性表之前需要先检查一遍
+                for (int k = 1; k < na; ++k) {
+                    if (ViewElemAt(pListA, pA, k) < ViewElemAt(pListA, pA, k - 1)) return DSCxx_ERROR;
+                }
+                for (int k = 1; k < nb; ++k) {
+                    if (ViewElemAt(pListB, pB, k) < ViewElemAt(pListB, pB, k - 1)) return DSCxx_ERROR;
+                }
+            }
+            // Target 可能就是某个视图的基础线性表，所以先归并到缓冲区中
+            vector<ElemType> buffer(na + nb);
+            int i = 0, j = 0, k = 0;
+            while (i < na && j < nb) {
+                if (k % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return DSCxx_INFEASIBLE;
+                }
+                ElemType a = ViewElemAt(pListA, pA, i), b = ViewElemAt(pListB, pB, j);
+                if (a <= b) {
+                    buffer[k++] = a;
+                    ++i;
+                }
+                else {
+                    buffer[k++] = b;
+                    ++j;
+                }
+            }
+            while (i < na) buffer[k++] = ViewElemAt(pListA, pA, i++);
+            while (j < nb) buffer[k++] = ViewElemAt(pListB, pB, j++);
+            if (ResizeSequenceList(pTarget, k) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            memcpy(pTarget->elem, buffer.data(), k * sizeof(ElemType));
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(MergeSequenceListViews)
+}
@@ -0,0 +1,447 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "SequenceList.hpp"
+
+#include <cstring>
+#include <thread>
+
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+namespace DataStructure_Cxx {
+
+#define SHARED_LIST_MAGIC "DSCXSHM1"
+#define SHARED_LIST_REFRESH_SPINS (1 << 16)    // 读取时等待写入方完成一次发布的最大尝试次数
+
+    // 共享内存区域的头部，元素紧随其后存放；区域的大小只增不减，所以读取方已有的映射总是有效的
+    // sequence 为顺序锁（seqlock）的计数：写入方修改前后各加 1，为奇数时表示正在写入
+    struct SharedListHeader {
+        char magic[8];
+        atomic<uint32_t> sequence;
+        atomic<int32_t> length;
+        atomic<int32_t> capacity;
+        atomic<uint32_t> retired;   // 写入方已撤销发布（或者同名区域已被重新发布）
+        char reserved[40];
+    };
+
+    static_assert(sizeof(SharedListHeader) == 64, "SharedListHeader must occupy exactly 64 bytes");
+    static_assert(ATOMIC_INT_LOCK_FREE == 2, "Shared memory requires lock-free atomics");
+
+    // 共享线性表：存储空间位于 POSIX 共享内存（shm_open + mmap）中，其他进程按名称附加后直接读取，不复制数据
+    // 同一区域只有一个写入方（发布它的进程），通过 UpdateSharedSequenceList 以顺序锁的方式整体更新；
+    // 读取方先 RefreshSharedSequenceList 取得一致的长度和容量，读完之后用 SharedSequenceListChanged 检查
+    // 读取期间是否发生了修改，返回 TRUE 时应刷新后重读。
+    // 它注册为 SequenceList 的派生类型，取值、定位、遍历等只读指令可以直接使用；存储空间属于外部（external），
+    // 插入、删除等修改线性表的指令都返回 ERROR。共享线性表不能参与事务（不支持 clone），目前只支持 Linux
+    class SharedSequenceList : public SequenceList {
+    public:
+        enum Mode : uint8_t { Detached, Writer, Reader };
+
+        Mode mode = Detached;
+        string regionName;
+        int fd = -1;
+        void *mapping = nullptr;
+        size_t mappedBytes = 0;
+        uint32_t seenSequence = 0;  // 最近一次发布或刷新时的顺序锁计数
+
+        SharedSequenceList() {
+            external = true;
+        }
+
+        ~SharedSequenceList() override {
+            detach();
+        }
+
+        ADTObject *copy() override {
+            return new SharedSequenceList;
+        }
+
+        string str() override {
+            return "SharedSequenceList";
+        }
+
+        // 共享区域属于其他进程也能看到的外部状态，回滚时无法只在本进程中撤销，所以不提供快照；
+        // 批处理中修改共享线性表的命令会因此被拒绝（参见 Interactor::logADTModification）
+        ADTObject *clone() override {
+            throw UnimplementedException();
+        }
+
+        void release() override {
+            detach();
+        }
+
+        // 格式：模式、区域名称，写入方还包含长度和各元素；恢复时写入方重新发布，读取方重新附加（区域已不存在时保持未附加）
+        void serialize(string &out) override {
+            putU8(out, mode);
+            putString(out, regionName);
+            if (mode == Writer) {
+                putI32(out, length);
+                putI32Array(out, elem, length);
+            }
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            auto state = (Mode) in.getU8();
+            string name = in.getString();
+            if (!in.ok || state > Reader) return false;
+            if (state == Writer) {
+                int size = in.getI32();
+                if (!in.ok || size < 0 || !in.require((size_t) size * sizeof(int32_t))) return false;
+                vector<ElemType> elems((size_t) size);
+                if (!in.getI32Array(elems.data(), size)) return false;
+                publish(name, elems.data(), size);
+            }
+            else if (state == Reader) {
+                attach(name);
+            }
+            return true;
+        }
+
+        static string RegionPath(const string &name) {
+            return "/dscxx." + name;
+        }
+
+        SharedListHeader *header() const {
+            return (SharedListHeader *) mapping;
+        }
+
+        // 容纳 n 个元素的区域大小，向上取整到整页
+        static size_t RegionBytes(int n, int &capacity) {
+            int headerElems = (int) (sizeof(SharedListHeader) / sizeof(ElemType));
+            capacity = ListStorageCapacity(n + headerElems, true) - headerElems;
+            return sizeof(SharedListHeader) + (size_t) capacity * sizeof(ElemType);
+        }
+
+        // 更新线性表的字段，使其引用映射中的元素
+        void bindElems(int len, int capacity) {
+            auto newElem = (ElemType *) ((char *) mapping + sizeof(SharedListHeader));
+            if (newElem != elem || capacity != listsize) {
+                elem = newElem;
+                storageChanged();
+            }
+            length = len;
+            listsize = capacity;
+        }
+
+        // 创建名为 name 的区域并写入 n 个元素；同名区域已存在时先将其标记为撤销再替换，已附加的读取方仍保留原来的映射
+        Status publish(const string &name, const ElemType *src, int n) {
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+            string path = RegionPath(name);
+            int staleFd = shm_open(path.c_str(), O_RDWR, 0);
+            if (staleFd >= 0) {
+                struct stat st;
+                if (fstat(staleFd, &st) == 0 && (size_t) st.st_size >= sizeof(SharedListHeader)) {
+                    void *stale = mmap(nullptr, sizeof(SharedListHeader), PROT_READ | PROT_WRITE, MAP_SHARED, staleFd, 0);
+                    if (stale != MAP_FAILED) {
+                        ((SharedListHeader *) stale)->retired.store(1, memory_order_release);
+                        munmap(stale, sizeof(SharedListHeader));
+                    }
+                }
+                close(staleFd);
+                shm_unlink(path.c_str());
+            }
+            fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+            if (fd < 0) {
+                return DSCxx_INFEASIBLE;
+            }
+            int capacity;
+            size_t bytes = RegionBytes(n > LIST_INIT_SIZE ? n : LIST_INIT_SIZE, capacity);
+            if (ftruncate(fd, (off_t) bytes) != 0) {
+                close(fd);
+                shm_unlink(path.c_str());
+                fd = -1;
+                return DSCxx_OVERFLOW;
+            }
+            mapping = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                close(fd);
+                shm_unlink(path.c_str());
+                fd = -1;
+                return DSCxx_OVERFLOW;
+            }
+            mappedBytes = bytes;
+            mode = Writer;
+            regionName = name;
+            // 新建的区域内容全为 0，写完元素之后才写入 magic，读取方不会附加到尚未写完的区域
+            auto pHeader = header();
+            bindElems(0, capacity);
+            memcpy(elem, src, (size_t) n * sizeof(ElemType));
+            pHeader->length.store(n, memory_order_relaxed);
+            pHeader->capacity.store(capacity, memory_order_relaxed);
+            pHeader->sequence.store(0, memory_order_relaxed);
+            atomic_thread_fence(memory_order_release);
+            memcpy(pHeader->magic, SHARED_LIST_MAGIC, sizeof(pHeader->magic));
+            seenSequence = 0;
+            length = n;
+            return DSCxx_OK;
+#else
+            return DSCxx_INFEASIBLE;
+#endif
+        }
+
+        // 只读地附加到名为 name 的区域
+        Status attach(const string &name) {
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+            fd = shm_open(RegionPath(name).c_str(), O_RDONLY, 0);
+            if (fd < 0) {
+                return DSCxx_INFEASIBLE;
+            }
+            struct stat st;
+            if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(SharedListHeader)) {
+                close(fd);
+                fd = -1;
+                return DSCxx_INFEASIBLE;
+            }
+            mapping = mmap(nullptr, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                close(fd);
+                fd = -1;
+                return DSCxx_INFEASIBLE;
+            }
+            mappedBytes = (size_t) st.st_size;
+            mode = Reader;
+            regionName = name;
+            if (memcmp(header()->magic, SHARED_LIST_MAGIC, sizeof(header()->magic)) != 0) {
+                detach();
+                return DSCxx_INFEASIBLE;
+            }
+            atomic_thread_fence(memory_order_acquire);
+            return refresh();
+#else
+            return DSCxx_INFEASIBLE;
+#endif
+        }
+
+        // 读取方：等待写入方完成当前的修改，取得一致的长度和容量，容量增大时重新映射
+        // 写入方长时间没有完成（例如在写入中途退出）时返回 INFEASIBLE
+        Status refresh() {
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+            auto pHeader = header();
+            for (int spin = 0; spin < SHARED_LIST_REFRESH_SPINS; ++spin) {
+                uint32_t before = pHeader->sequence.load(memory_order_acquire);
+                if (before & 1) {
+                    this_thread::yield();
+                    continue;
+                }
+                int len = pHeader->length.load(memory_order_relaxed);
+                int capacity = pHeader->capacity.load(memory_order_relaxed);
+                atomic_thread_fence(memory_order_acquire);
+                if (pHeader->sequence.load(memory_order_relaxed) != before) continue;
+                size_t bytes = sizeof(SharedListHeader) + (size_t) capacity * sizeof(ElemType);
+                if (bytes > mappedBytes) {
+                    // 写入方总是先扩大区域再发布新的容量，所以此时区域至少有 bytes 字节
+                    void *addr = mremap(mapping, mappedBytes, bytes, MREMAP_MAYMOVE);
+                    if (addr == MAP_FAILED) {
+                        return DSCxx_OVERFLOW;
+                    }
+                    mapping = addr;
+                    mappedBytes = bytes;
+                    pHeader = header();
+                }
+                bindElems(len, capacity);
+                seenSequence = before;
+                return DSCxx_OK;
+            }
+            return DSCxx_INFEASIBLE;
+#else
+            return DSCxx_INFEASIBLE;
+#endif
+        }
+
+        // 写入方：以 n 个元素整体替换区域中的内容，容量不足时先扩大区域（容量至少加倍），src 不能指向区域本身
+        Status update(const ElemType *src, int n) {
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+            auto pHeader = header();
+            int capacity = listsize;
+            if (n > capacity) {
+                size_t bytes = RegionBytes(n > capacity * 2 ? n : capacity * 2, capacity);
+                if (ftruncate(fd, (off_t) bytes) != 0) {
+                    return DSCxx_OVERFLOW;
+                }
+                void *addr = mremap(mapping, mappedBytes, bytes, MREMAP_MAYMOVE);
+                if (addr == MAP_FAILED) {
+                    return DSCxx_OVERFLOW;
+                }
+                mapping = addr;
+                mappedBytes = bytes;
+                pHeader = header();
+                bindElems(length, capacity);
+            }
+            uint32_t sequence = pHeader->sequence.load(memory_order_relaxed);
+            pHeader->sequence.store(sequence + 1, memory_order_relaxed);
+            atomic_thread_fence(memory_order_release);
+            memcpy(elem, src, (size_t) n * sizeof(ElemType));
+            pHeader->length.store(n, memory_order_relaxed);
+            pHeader->capacity.store(capacity, memory_order_relaxed);
+            pHeader->sequence.store(sequence + 2, memory_order_release);
+            seenSequence = sequence + 2;
+            length = n;
+            return DSCxx_OK;
+#else
+            return DSCxx_INFEASIBLE;
+#endif
+        }
+
+        // 自上次发布或刷新之后，区域是否被修改过（包括正在修改、已撤销）
+        bool changed() const {
+            auto pHeader = header();
+            atomic_thread_fence(memory_order_acquire);
+            return pHeader->sequence.load(memory_order_relaxed) != seenSequence ||
+                   pHeader->retired.load(memory_order_relaxed) != 0;
+        }
+
+        // 解除映射；写入方同时撤销发布，已附加的读取方可以继续读取最后一次发布的内容
+        void detach() {
+#ifdef LIST_MAPPED_STORAGE_SUPPORTED
+            if (mode == Detached) return;
+            if (mode == Writer) {
+                header()->retired.store(1, memory_order_release);
+                shm_unlink(RegionPath(regionName).c_str());
+            }
+            munmap(mapping, mappedBytes);
+            close(fd);
+#endif
+            mode = Detached;
+            regionName.clear();
+            fd = -1;
+            mapping = nullptr;
+            mappedBytes = 0;
+            elem = nullptr;
+            length = listsize = 0;
+            storageChanged();
+        }
+    };
+
+    // 将线性表 List 的元素发布到名为 Name 的共享内存区域，由本进程的共享线性表 Shared 作为唯一的写入方
+    // Shared 已发布或已附加时返回 ERROR，无法创建区域时返回 INFEASIBLE
+    class PublishSequenceList : public Function {
+    ENABLE_SINGLETON(PublishSequenceList)
+    SIGNATURE(ADT_ARG(SharedSequenceList), ADT_FAMILY_ARG(SequenceList), NAME_ARG)
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pShared = args.adt<SharedSequenceList>(0);
+            auto pList = args.adt<SequenceList>(1);
+            if (pShared->mode != SharedSequenceList::Detached || pList->elem == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pShared->publish(args.name(2), pList->elem, pList->length);
+        }
+    };
+
+    SINGLETON_MEMBER(PublishSequenceList)
+
+    // 用线性表 List 的元素整体替换 Shared 发布的内容，只有写入方可以调用
+    class UpdateSharedSequenceList : public Function {
+    ENABLE_SINGLETON(UpdateSharedSequenceList)
+    SIGNATURE(ADT_ARG(SharedSequenceList), ADT_FAMILY_ARG(SequenceList))
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pShared = args.adt<SharedSequenceList>(0);
+            auto pList = args.adt<SequenceList>(1);
+            if (pShared->mode != SharedSequenceList::Writer || pList->elem == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (pList == pShared) {
+                return DSCxx_OK;
+            }
+            return pShared->update(pList->elem, pList->length);
+        }
+    };
+
+    SINGLETON_MEMBER(UpdateSharedSequenceList)
+
+    // 只读地附加到其他进程发布的名为 Name 的区域，不复制数据；区域不存在时返回 INFEASIBLE
+    class AttachSequenceList : public Function {
+    ENABLE_SINGLETON(AttachSequenceList)
+    SIGNATURE(ADT_ARG(SharedSequenceList), NAME_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pShared = args.adt<SharedSequenceList>(0);
+            if (pShared->mode != SharedSequenceList::Detached) {
+                return DSCxx_ERROR;
+            }
+            return pShared->attach(args.name(1));
+        }
+    };
+
+    SINGLETON_MEMBER(AttachSequenceList)
+
+    // 读取方取得写入方最近一次发布的长度（必要时重新映射），之后的读取都针对这一版本
+    class RefreshSharedSequenceList : public Function {
+    ENABLE_SINGLETON(RefreshSharedSequenceList)
+    SIGNATURE(ADT_ARG(SharedSequenceList))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pShared = args.adt<SharedSequenceList>(0);
+            if (pShared->mode != SharedSequenceList::Reader) {
+                return DSCxx_ERROR;
+            }
+            return pShared->refresh();
+        }
+    };
+
+    SINGLETON_MEMBER(RefreshSharedSequenceList)
+
+    // 自上次刷新之后写入方是否修改过（或者正在修改、已撤销）区域：是则返回 TRUE，此前读到的数据可能不一致
+    class SharedSequenceListChanged : public Function {
+    ENABLE_SINGLETON(SharedSequenceListChanged)
+    SIGNATURE(ADT_ARG(SharedSequenceList))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pShared = args.adt<SharedSequenceList>(0);
+            if (pShared->mode == SharedSequenceList::Detached) {
+                return DSCxx_ERROR;
+            }
+            return pShared->changed() ? DSCxx_TRUE : DSCxx_FALSE;
+        }
+    };
+
+    SINGLETON_MEMBER(SharedSequenceListChanged)
+
+    class DetachSequenceList : public Function {
+    ENABLE_SINGLETON(DetachSequenceList)
+    SIGNATURE(ADT_ARG(SharedSequenceList))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pShared = args.adt<SharedSequenceList>(0);
+            if (pShared->mode == SharedSequenceList::Detached) {
+                return DSCxx_ERROR;
+            }
+            pShared->detach();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DetachSequenceList)
+}
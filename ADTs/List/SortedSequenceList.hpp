@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "SequenceList.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace DataStructure_Cxx {
+    // 有序线性表：元素始终按值非递减排列
+    // 它注册为 SequenceList 的派生类型，初始化、销毁、取值、删除、定位（自动使用二分查找）以及并集、归并
+    // 等不会破坏顺序的 SequenceList 指令都可以直接使用；按位序插入等指令则不接受有序线性表
+    class SortedSequenceList : public SequenceList {
+    public:
+        SortedSequenceList() {
+            sorted = true;
+        }
+
+        ADTObject *copy() override {
+            auto pastedObj = new SortedSequenceList;
+            pastedObj->elem = elem;
+            pastedObj->length = length;
+            pastedObj->listsize = listsize;
+            pastedObj->mapped = mapped;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "SortedSequenceList";
+        }
+
+        ADTObject *clone() override {
+            auto clonedObj = new SortedSequenceList;
+            clonedObj->length = length;
+            clonedObj->listsize = listsize;
+            clonedObj->mapped = mapped;
+            if (elem != nullptr) {
+                clonedObj->elem = AllocListStorage(listsize, mapped, clonedObj->listsize);
+                memcpy(clonedObj->elem, elem, length * sizeof(ElemType));
+            }
+            return clonedObj;
+        }
+    };
+
+    // 将普通线性表 Source 中的元素排序后存入有序线性表 Target（Target 原有的元素被覆盖）
+    class SortSequenceList : public Function {
+    ENABLE_SINGLETON(SortSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList), ADT_ARG(SortedSequenceList))
+    SNAPSHOT_ARGS(1)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pSource = args.adt<SequenceList>(0);
+            auto pTarget = args.adt<SortedSequenceList>(1);
+            if (pSource->elem == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (pSource == pTarget) {
+                return DSCxx_OK;
+            }
+            if (ResizeSequenceList(pTarget, pSource->length) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            memcpy(pTarget->elem, pSource->elem, pSource->length * sizeof(ElemType));
+            if (!pSource->sorted) {
+                std::sort(pTarget->elem, pTarget->elem + pTarget->length);
+            }
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(SortSequenceList)
+
+    // 有序插入：插在所有与之相等的元素之后，返回插入的位序
+    class SortedSequenceListInsert : public Function {
+    ENABLE_SINGLETON(SortedSequenceListInsert)
+    SIGNATURE(ADT_ARG(SortedSequenceList), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SortedSequenceList>(0);
+            if (pList->elem == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return InsertSortedElem(pList, *args.var(1));
+        }
+
+        // 逆操作：插入成功时删除一个与 e 相等的元素（相等的元素无法区分，删除哪一个结果都相同）
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pList = args.adt<SortedSequenceList>(0);
+            int length = pList->length;
+            ElemType e = *args.var(1);
+            uint64_t version = pList->storageVersion;
+            steps.push_back({ 0, [length, e, version](ADTObject *obj) {
+                auto &L = *static_cast<SortedSequenceList *>(obj);
+                ElemType removed;
+                if (L.length > length) ListDelete_Sq(L, LocateElem_Sq(L, e), removed);
+                L.storageVersion = version;
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(SortedSequenceListInsert)
+
+    // 返回第一个不小于 e 的元素的位序，所有元素都小于 e 时返回 length + 1
+    class LowerBoundInSortedSequenceList : public Function {
+    ENABLE_SINGLETON(LowerBoundInSortedSequenceList)
+    SIGNATURE(ADT_ARG(SortedSequenceList), VAR_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SortedSequenceList>(0);
+            if (pList->elem == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return SortedBound<false>(pList->elem, pList->length, *args.var(1)) + 1;
+        }
+    };
+
+    SINGLETON_MEMBER(LowerBoundInSortedSequenceList)
+
+    // 返回第一个大于 e 的元素的位序，所有元素都不大于 e 时返回 length + 1
+    class UpperBoundInSortedSequenceList : public Function {
+    ENABLE_SINGLETON(UpperBoundInSortedSequenceList)
+    SIGNATURE(ADT_ARG(SortedSequenceList), VAR_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SortedSequenceList>(0);
+            if (pList->elem == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return SortedBound<true>(pList->elem, pList->length, *args.var(1)) + 1;
+        }
+    };
+
+    SINGLETON_MEMBER(UpperBoundInSortedSequenceList)
+
+    // 返回值在闭区间 [low, high] 中的元素个数，只需两次二分查找
+    class CountRangeInSortedSequenceList : public Function {
+    ENABLE_SINGLETON(CountRangeInSortedSequenceList)
+    SIGNATURE(ADT_ARG(SortedSequenceList), VAR_ARG, VAR_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SortedSequenceList>(0);
+            if (pList->elem == nullptr) {
+                return DSCxx_ERROR;
+            }
+            ElemType low = *args.var(1), high = *args.var(2);
+            if (low > high) {
+                return 0;
+            }
+            return SortedBound<true>(pList->elem, pList->length, high) -
+                   SortedBound<false>(pList->elem, pList->length, low);
+        }
+    };
+
+    SINGLETON_MEMBER(CountRangeInSortedSequenceList)
+}
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace DataStructure_Cxx {
+
+#define DEQUE_INIT_SIZE 16              // 双端队列存储空间的初始分配量，必须为 2 的幂
+#define DEQUE_MAX_SIZE  (1 << 30)       // 存储容量的上限
+
+    // 双端队列：循环队列（参见教材 3.4.3）的双端版本，两端的插入、删除以及按位序取值都是 O(1)
+    // 容量始终为 2 的幂，下标取模只需按位与；队列满时容量加倍，环绕的两段元素各复制一次后变为连续存放
+    class Deque : public ADTObject {
+    public:
+        ElemType *base = nullptr;   // 存储空间基址
+        int capacity = 0;
+        int front = 0;              // 队头元素的下标
+        int length = 0;
+
+        ADTObject *copy() override {
+            auto pastedObj = new Deque;
+            pastedObj->base = base;
+            pastedObj->capacity = capacity;
+            pastedObj->front = front;
+            pastedObj->length = length;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "Deque";
+        }
+
+        // 深拷贝时顺便把元素整理为从下标 0 开始连续存放
+        ADTObject *clone() override {
+            auto clonedObj = new Deque;
+            clonedObj->length = length;
+            if (base == nullptr) return clonedObj;
+            clonedObj->capacity = capacity;
+            clonedObj->base = AllocDequeStorage(capacity);
+            copyTo(clonedObj->base);
+            return clonedObj;
+        }
+
+        void release() override {
+            free(base);
+            base = nullptr;
+        }
+
+        // 格式：是否已初始化、长度、从队头到队尾的各元素
+        void serialize(string &out) override {
+            putU8(out, base != nullptr);
+            putI32(out, base != nullptr ? length : 0);
+            for (int i = 0; i < length && base != nullptr; ++i) {
+                putI32(out, at(i));
+            }
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            bool initialized = in.getU8() != 0;
+            int size = in.getI32();
+            if (!in.ok || size < 0 || size > DEQUE_MAX_SIZE || !in.require((size_t) size * sizeof(int32_t))) {
+                return false;
+            }
+            if (!initialized) return true;
+            capacity = DEQUE_INIT_SIZE;
+            while (capacity < size) capacity <<= 1;
+            base = AllocDequeStorage(capacity);
+            front = 0;
+            length = size;
+            return in.getI32Array(base, size);
+        }
+
+        static ElemType *AllocDequeStorage(int capacity) {
+            auto elem = (ElemType *) malloc((size_t) capacity * sizeof(ElemType));
+            if (!elem) exit(DSCxx_OVERFLOW);
+            return elem;
+        }
+
+        // 第 i 个元素（从 0 开始）
+        ElemType &at(int i) {
+            return base[(front + i) & (capacity - 1)];
+        }
+
+        // 将全部元素按从队头到队尾的顺序复制到 out 中，环绕的两段各复制一次
+        void copyTo(ElemType *out) const {
+            int first = (length < capacity - front) ? length : capacity - front;
+            memcpy(out, base + front, first * sizeof(ElemType));
+            memcpy(out + first, base, (length - first) * sizeof(ElemType));
+        }
+
+        // 队列满时容量加倍，空间不足时返回 false
+        bool reserveOne() {
+            if (length < capacity) return true;
+            if (capacity >= DEQUE_MAX_SIZE) return false;
+            auto newBase = AllocDequeStorage(capacity * 2);
+            copyTo(newBase);
+            free(base);
+            base = newBase;
+            capacity *= 2;
+            front = 0;
+            return true;
+        }
+    };
+
+    class InitDeque : public Function {
+    ENABLE_SINGLETON(InitDeque)
+    SIGNATURE(ADT_ARG(Deque))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            free(pDeque->base);
+            pDeque->base = Deque::AllocDequeStorage(DEQUE_INIT_SIZE);
+            pDeque->capacity = DEQUE_INIT_SIZE;
+            pDeque->front = 0;
+            pDeque->length = 0;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(InitDeque)
+
+    class DestroyDeque : public Function {
+    ENABLE_SINGLETON(DestroyDeque)
+    SIGNATURE(ADT_ARG(Deque))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr) {
+                return DSCxx_ERROR;
+            }
+            pDeque->release();
+            pDeque->capacity = pDeque->front = pDeque->length = 0;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DestroyDeque)
+
+    // 清空队列但保留已分配的存储空间
+    class ClearDeque : public Function {
+    ENABLE_SINGLETON(ClearDeque)
+    SIGNATURE(ADT_ARG(Deque))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr) {
+                return DSCxx_ERROR;
+            }
+            pDeque->front = pDeque->length = 0;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(ClearDeque)
+
+    class IsDequeEmpty : public Function {
+    ENABLE_SINGLETON(IsDequeEmpty)
+    SIGNATURE(ADT_ARG(Deque))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pDeque->length == 0 ? DSCxx_TRUE : DSCxx_FALSE;
+        }
+    };
+
+    SINGLETON_MEMBER(IsDequeEmpty)
+
+    class DequeLength : public Function {
+    ENABLE_SINGLETON(DequeLength)
+    SIGNATURE(ADT_ARG(Deque))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pDeque->length;
+        }
+    };
+
+    SINGLETON_MEMBER(DequeLength)
+
+    // 按位序取值，队头元素的位序为 1
+    class GetElemInDeque : public Function {
+    ENABLE_SINGLETON(GetElemInDeque)
+    SIGNATURE(ADT_ARG(Deque), INT_ARG, VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            int i = args.value(1);
+            if (pDeque->base == nullptr || i < 1 || i > pDeque->length) {
+                return DSCxx_ERROR;
+            }
+            *args.var(2) = pDeque->at(i - 1);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(GetElemInDeque)
+
+    class DequePushFront : public Function {
+    ENABLE_SINGLETON(DequePushFront)
+    SIGNATURE(ADT_ARG(Deque), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (!pDeque->reserveOne()) {
+                return DSCxx_OVERFLOW;
+            }
+            pDeque->front = (pDeque->front - 1) & (pDeque->capacity - 1);
+            pDeque->base[pDeque->front] = *args.var(1);
+            ++pDeque->length;
+            return DSCxx_OK;
+        }
+
+        // 逆操作：插入成功时删除队头元素（扩容后元素变为从下标 0 开始连续存放，之后的操作只按位序访问，结果相同）
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            int length = args.adt<Deque>(0)->length;
+            steps.push_back({ 0, [length](ADTObject *obj) {
+                auto pDeque = static_cast<Deque *>(obj);
+                if (pDeque->length <= length) return;
+                pDeque->front = (pDeque->front + 1) & (pDeque->capacity - 1);
+                --pDeque->length;
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(DequePushFront)
+
+    class DequePushBack : public Function {
+    ENABLE_SINGLETON(DequePushBack)
+    SIGNATURE(ADT_ARG(Deque), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (!pDeque->reserveOne()) {
+                return DSCxx_OVERFLOW;
+            }
+            pDeque->at(pDeque->length++) = *args.var(1);
+            return DSCxx_OK;
+        }
+
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            int length = args.adt<Deque>(0)->length;
+            steps.push_back({ 0, [length](ADTObject *obj) {
+                auto pDeque = static_cast<Deque *>(obj);
+                if (pDeque->length > length) --pDeque->length;
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(DequePushBack)
+
+    // 删除队头元素，并用 e 返回其值，队列为空时返回 ERROR
+    class DequePopFront : public Function {
+    ENABLE_SINGLETON(DequePopFront)
+    SIGNATURE(ADT_ARG(Deque), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr || pDeque->length == 0) {
+                return DSCxx_ERROR;
+            }
+            *args.var(1) = pDeque->base[pDeque->front];
+            pDeque->front = (pDeque->front + 1) & (pDeque->capacity - 1);
+            --pDeque->length;
+            return DSCxx_OK;
+        }
+
+        // 逆操作：删除成功时把原来的队头元素放回（删除不会缩容，所以不需要重新分配）
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr || pDeque->length == 0) {
+                return true;
+            }
+            int length = pDeque->length;
+            ElemType e = pDeque->at(0);
+            steps.push_back({ 0, [length, e](ADTObject *obj) {
+                auto pDeque = static_cast<Deque *>(obj);
+                if (pDeque->length >= length) return;
+                pDeque->front = (pDeque->front - 1) & (pDeque->capacity - 1);
+                pDeque->base[pDeque->front] = e;
+                ++pDeque->length;
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(DequePopFront)
+
+    class DequePopBack : public Function {
+    ENABLE_SINGLETON(DequePopBack)
+    SIGNATURE(ADT_ARG(Deque), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr || pDeque->length == 0) {
+                return DSCxx_ERROR;
+            }
+            *args.var(1) = pDeque->at(--pDeque->length);
+            return DSCxx_OK;
+        }
+
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr || pDeque->length == 0) {
+                return true;
+            }
+            int length = pDeque->length;
+            ElemType e = pDeque->at(length - 1);
+            steps.push_back({ 0, [length, e](ADTObject *obj) {
+                auto pDeque = static_cast<Deque *>(obj);
+                if (pDeque->length < length) pDeque->at(pDeque->length++) = e;
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(DequePopBack)
+
+    // 取队头、队尾元素但不删除
+    class DequeFront : public Function {
+    ENABLE_SINGLETON(DequeFront)
+    SIGNATURE(ADT_ARG(Deque), VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr || pDeque->length == 0) {
+                return DSCxx_ERROR;
+            }
+            *args.var(1) = pDeque->at(0);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DequeFront)
+
+    class DequeBack : public Function {
+    ENABLE_SINGLETON(DequeBack)
+    SIGNATURE(ADT_ARG(Deque), VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pDeque = args.adt<Deque>(0);
+            if (pDeque->base == nullptr || pDeque->length == 0) {
+                return DSCxx_ERROR;
+            }
+            *args.var(1) = pDeque->at(pDeque->length - 1);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DequeBack)
+}
@@ -0,0 +1,523 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "List/SequenceList.hpp"
+
+#include <vector>
+
+namespace DataStructure_Cxx {
+
+#define PRIORITY_QUEUE_DEFAULT_ARITY 4  // 默认为 4 叉堆：一个结点的孩子正好占 16 字节，通常位于同一缓存行
+#define PRIORITY_QUEUE_MAX_ARITY 64
+
+    // 优先队列：隐式的 d 叉堆（参见教材 10.4.3 的堆排序，这里推广为 d 叉），下标为 i 的结点的孩子为 d * i + 1 ~ d * i + d
+    // 与二叉堆相比，d 叉堆的高度更低，上浮更快；下沉时每层要比较 d 个孩子，但它们在内存中相邻
+    // 每个元素入队时得到一个句柄，可以通过句柄修改它的优先级；出队后句柄被回收，之后可能分配给新的元素
+    class PriorityQueue : public ADTObject {
+    public:
+        bool initialized = false;
+        int arity = PRIORITY_QUEUE_DEFAULT_ARITY;
+        bool maxHeap = false;           // 为 true 时堆顶为最大值，否则为最小值
+        vector<ElemType> keys;          // 堆中的元素，下沉时只需扫描这个数组
+        vector<int> handles;            // 与 keys 一一对应的句柄
+        vector<int> position;           // 句柄 -> 元素在堆中的下标，已回收的句柄为 -1
+        vector<int> freeHandles;
+
+        ADTObject *copy() override {
+            auto pastedObj = new PriorityQueue;
+            pastedObj->initialized = initialized;
+            pastedObj->arity = arity;
+            pastedObj->maxHeap = maxHeap;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "PriorityQueue";
+        }
+
+        ADTObject *clone() override {
+            auto clonedObj = new PriorityQueue;
+            clonedObj->initialized = initialized;
+            clonedObj->arity = arity;
+            clonedObj->maxHeap = maxHeap;
+            clonedObj->keys = keys;
+            clonedObj->handles = handles;
+            clonedObj->position = position;
+            clonedObj->freeHandles = freeHandles;
+            return clonedObj;
+        }
+
+        void release() override {
+            vector<ElemType>().swap(keys);
+            vector<int>().swap(handles);
+            vector<int>().swap(position);
+            vector<int>().swap(freeHandles);
+            initialized = false;
+        }
+
+        // 格式：是否已初始化、d、是否为大顶堆、元素个数、各元素及其句柄、已分配的句柄数、回收的句柄（保持顺序，重放时分配的句柄才会一致）
+        void serialize(string &out) override {
+            putU8(out, initialized);
+            putI32(out, arity);
+            putU8(out, maxHeap);
+            putU32(out, (uint32_t) keys.size());
+            putI32Array(out, keys.data(), (int) keys.size());
+            putI32Array(out, handles.data(), (int) handles.size());
+            putU32(out, (uint32_t) position.size());
+            putU32(out, (uint32_t) freeHandles.size());
+            putI32Array(out, freeHandles.data(), (int) freeHandles.size());
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            initialized = in.getU8() != 0;
+            arity = in.getI32();
+            maxHeap = in.getU8() != 0;
+            uint32_t n = in.getU32();
+            if (!in.ok || arity < 2 || arity > PRIORITY_QUEUE_MAX_ARITY || !in.require((size_t) n * 8)) return false;
+            keys.resize(n);
+            handles.resize(n);
+            if (!in.getI32Array(keys.data(), (int) n) || !in.getI32Array(handles.data(), (int) n)) return false;
+            uint32_t handleCount = in.getU32();
+            uint32_t freeCount = in.getU32();
+            if (!in.ok || handleCount != n + freeCount || !in.require((size_t) freeCount * 4)) return false;
+            freeHandles.resize(freeCount);
+            if (!in.getI32Array(freeHandles.data(), (int) freeCount)) return false;
+            position.assign(handleCount, -1);
+            for (uint32_t i = 0; i < n; ++i) {
+                if (handles[i] < 0 || (uint32_t) handles[i] >= handleCount) return false;
+                position[handles[i]] = (int) i;
+            }
+            return true;
+        }
+
+        bool before(ElemType a, ElemType b) const {
+            return maxHeap ? a > b : a < b;
+        }
+
+        // 将下标为 i 的元素上浮到合适的位置：路径上的元素依次下移，最后只写一次
+        void siftUp(int i) {
+            ElemType key = keys[i];
+            int handle = handles[i];
+            while (i > 0) {
+                int parent = (i - 1) / arity;
+                if (!before(key, keys[parent])) break;
+                keys[i] = keys[parent];
+                handles[i] = handles[parent];
+                position[handles[i]] = i;
+                i = parent;
+            }
+            keys[i] = key;
+            handles[i] = handle;
+            position[handle] = i;
+        }
+
+        void siftDown(int i) {
+            int n = (int) keys.size();
+            ElemType key = keys[i];
+            int handle = handles[i];
+            while (true) {
+                int first = arity * i + 1;
+                if (first >= n) break;
+                int last = (first + arity < n) ? first + arity : n;
+                int best = first;
+                for (int c = first + 1; c < last; ++c) {
+                    if (before(keys[c], keys[best])) best = c;
+                }
+                if (!before(keys[best], key)) break;
+                keys[i] = keys[best];
+                handles[i] = handles[best];
+                position[handles[i]] = i;
+                i = best;
+            }
+            keys[i] = key;
+            handles[i] = handle;
+            position[handle] = i;
+        }
+
+        // siftUp 的逆操作（批处理回滚时使用）：把下标为 to 的元素放回它上浮之前所在的后代 from，
+        // 路径上被它挤下来的元素各自回到原来的父结点，堆恢复为上浮之前的布局（而不只是同样的元素集合）
+        void unsiftUp(int to, int from) {
+            int path[32];   // d >= 2 时堆的高度不超过 31
+            int depth = 0;
+            for (int i = from; i != to; i = (i - 1) / arity) {
+                path[depth++] = i;
+            }
+            ElemType key = keys[to];
+            int handle = handles[to];
+            while (depth > 0) {
+                int i = path[--depth];
+                int parent = (i - 1) / arity;
+                keys[parent] = keys[i];
+                handles[parent] = handles[i];
+                position[handles[parent]] = parent;
+            }
+            keys[from] = key;
+            handles[from] = handle;
+            position[handle] = from;
+        }
+
+        // siftDown 的逆操作：把下标为 to 的元素放回它下沉之前所在的祖先 from，路径上的元素各自回到原来的孩子
+        void unsiftDown(int to, int from) {
+            ElemType key = keys[to];
+            int handle = handles[to];
+            for (int i = to; i != from; ) {
+                int parent = (i - 1) / arity;
+                keys[i] = keys[parent];
+                handles[i] = handles[parent];
+                position[handles[i]] = i;
+                i = parent;
+            }
+            keys[from] = key;
+            handles[from] = handle;
+            position[handle] = from;
+        }
+
+        int allocateHandle() {
+            if (!freeHandles.empty()) {
+                int handle = freeHandles.back();
+                freeHandles.pop_back();
+                return handle;
+            }
+            position.push_back(-1);
+            return (int) position.size() - 1;
+        }
+
+        int push(ElemType e) {
+            int handle = allocateHandle();
+            keys.push_back(e);
+            handles.push_back(handle);
+            siftUp((int) keys.size() - 1);
+            return handle;
+        }
+
+        ElemType pop() {
+            ElemType top = keys[0];
+            position[handles[0]] = -1;
+            freeHandles.push_back(handles[0]);
+            keys[0] = keys.back();
+            handles[0] = handles.back();
+            keys.pop_back();
+            handles.pop_back();
+            if (!keys.empty()) siftDown(0);
+            return top;
+        }
+
+        // 将句柄为 handle 的元素改为 e 并上浮，调用者需保证 e 不低于原来的优先级
+        void decreaseKey(int handle, ElemType e) {
+            int i = position[handle];
+            keys[i] = e;
+            siftUp(i);
+        }
+
+        // 自底向上建堆（Floyd），O(n)：第 k 个元素的句柄为 k - 1，原有的元素和句柄全部丢弃
+        // 先在临时的堆中构造，完成之后才换入，被取消时原来的堆保持不变，返回 false
+        bool heapify(const ElemType *elem, int n) {
+            PriorityQueue built;
+            built.arity = arity;
+            built.maxHeap = maxHeap;
+            built.keys.assign(elem, elem + n);
+            built.handles.resize(n);
+            built.position.resize(n);
+            for (int k = 0; k < n; ++k) {
+                built.handles[k] = built.position[k] = k;
+            }
+            for (int i = (n > 1) ? (n - 2) / arity : -1, k = 0; i >= 0; --i, ++k) {
+                if (k % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return false;
+                }
+                built.siftDown(i);
+            }
+            keys.swap(built.keys);
+            handles.swap(built.handles);
+            position.swap(built.position);
+            freeHandles.swap(built.freeHandles);
+            return true;
+        }
+    };
+
+    // d 为 0 时使用默认的 4 叉堆，max 不为 0 时为大顶堆（出队的是最大值）
+    class InitPriorityQueue : public Function {
+    ENABLE_SINGLETON(InitPriorityQueue)
+    SIGNATURE(ADT_ARG(PriorityQueue), INT_ARG, INT_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            int d = args.value(1) == 0 ? PRIORITY_QUEUE_DEFAULT_ARITY : args.value(1);
+            if (d < 2 || d > PRIORITY_QUEUE_MAX_ARITY) {
+                return DSCxx_ERROR;
+            }
+            pQueue->release();
+            pQueue->initialized = true;
+            pQueue->arity = d;
+            pQueue->maxHeap = args.value(2) != 0;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(InitPriorityQueue)
+
+    class DestroyPriorityQueue : public Function {
+    ENABLE_SINGLETON(DestroyPriorityQueue)
+    SIGNATURE(ADT_ARG(PriorityQueue))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            if (!pQueue->initialized) {
+                return DSCxx_ERROR;
+            }
+            pQueue->release();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DestroyPriorityQueue)
+
+    class PriorityQueueLength : public Function {
+    ENABLE_SINGLETON(PriorityQueueLength)
+    SIGNATURE(ADT_ARG(PriorityQueue))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            if (!pQueue->initialized) {
+                return DSCxx_ERROR;
+            }
+            return (Status) pQueue->keys.size();
+        }
+    };
+
+    SINGLETON_MEMBER(PriorityQueueLength)
+
+    // 元素 e 入队，并用 handle 返回它的句柄
+    class PriorityQueuePush : public Function {
+    ENABLE_SINGLETON(PriorityQueuePush)
+    SIGNATURE(ADT_ARG(PriorityQueue), VAR_ARG, VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            if (!pQueue->initialized) {
+                return DSCxx_ERROR;
+            }
+            *args.var(2) = pQueue->push(*args.var(1));
+            return DSCxx_OK;
+        }
+
+        // 逆操作：把新元素沿上浮的路径放回末尾后删除，并归还它的句柄（回收的句柄放回原处，之后分配的句柄不变）
+        // 入队时分配的句柄由入队之前的状态决定：优先取 freeHandles 的末尾，否则为新的句柄
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            int count = (int) pQueue->keys.size();
+            bool reused = !pQueue->freeHandles.empty();
+            int handle = reused ? pQueue->freeHandles.back() : (int) pQueue->position.size();
+            steps.push_back({ 0, [count, reused, handle](ADTObject *obj) {
+                auto pQueue = static_cast<PriorityQueue *>(obj);
+                if ((int) pQueue->keys.size() <= count) return;
+                pQueue->unsiftUp(pQueue->position[handle], count);
+                pQueue->keys.pop_back();
+                pQueue->handles.pop_back();
+                if (reused) {
+                    pQueue->position[handle] = -1;
+                    pQueue->freeHandles.push_back(handle);
+                }
+                else {
+                    pQueue->position.pop_back();
+                }
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(PriorityQueuePush)
+
+    // 删除堆顶元素（小顶堆为最小值，大顶堆为最大值），并用 e 返回其值，队列为空时返回 ERROR
+    class PriorityQueuePop : public Function {
+    ENABLE_SINGLETON(PriorityQueuePop)
+    SIGNATURE(ADT_ARG(PriorityQueue), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            if (!pQueue->initialized || pQueue->keys.empty()) {
+                return DSCxx_ERROR;
+            }
+            *args.var(1) = pQueue->pop();
+            return DSCxx_OK;
+        }
+
+        // 逆操作：原来的末尾元素在出队时移到堆顶再下沉，先把它沿原路放回堆顶、再移回末尾，然后放回出队的元素和句柄
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            if (!pQueue->initialized || pQueue->keys.empty()) {
+                return true;
+            }
+            int count = (int) pQueue->keys.size();
+            ElemType top = pQueue->keys[0];
+            int topHandle = pQueue->handles[0];
+            int lastHandle = pQueue->handles[count - 1];
+            steps.push_back({ 0, [count, top, topHandle, lastHandle](ADTObject *obj) {
+                auto pQueue = static_cast<PriorityQueue *>(obj);
+                if ((int) pQueue->keys.size() >= count) return;
+                if (count > 1) {
+                    pQueue->unsiftDown(pQueue->position[lastHandle], 0);
+                    pQueue->keys.push_back(pQueue->keys[0]);
+                    pQueue->handles.push_back(lastHandle);
+                    pQueue->position[lastHandle] = count - 1;
+                    pQueue->keys[0] = top;
+                    pQueue->handles[0] = topHandle;
+                }
+                else {
+                    pQueue->keys.push_back(top);
+                    pQueue->handles.push_back(topHandle);
+                }
+                pQueue->position[topHandle] = 0;
+                pQueue->freeHandles.pop_back();
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(PriorityQueuePop)
+
+    class PriorityQueuePeek : public Function {
+    ENABLE_SINGLETON(PriorityQueuePeek)
+    SIGNATURE(ADT_ARG(PriorityQueue), VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            if (!pQueue->initialized || pQueue->keys.empty()) {
+                return DSCxx_ERROR;
+            }
+            *args.var(1) = pQueue->keys[0];
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(PriorityQueuePeek)
+
+    // 将句柄为 handle 的元素的值改为 e，e 的优先级不能低于原来的值（小顶堆中不能更大，大顶堆中不能更小），
+    // 句柄无效或者优先级降低时返回 ERROR
+    class PriorityQueueDecreaseKey : public Function {
+    ENABLE_SINGLETON(PriorityQueueDecreaseKey)
+    SIGNATURE(ADT_ARG(PriorityQueue), VAR_ARG, VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            int handle = *args.var(1);
+            ElemType e = *args.var(2);
+            if (!pQueue->initialized || handle < 0 || handle >= (int) pQueue->position.size()) {
+                return DSCxx_ERROR;
+            }
+            int i = pQueue->position[handle];
+            if (i < 0 || pQueue->before(pQueue->keys[i], e)) {
+                return DSCxx_ERROR;
+            }
+            pQueue->decreaseKey(handle, e);
+            return DSCxx_OK;
+        }
+
+        // 逆操作：把元素沿上浮的路径放回原来的位置，并恢复原来的值
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            int handle = *args.var(1);
+            if (!pQueue->initialized || handle < 0 || handle >= (int) pQueue->position.size()
+                || pQueue->position[handle] < 0) {
+                return true;
+            }
+            int i = pQueue->position[handle];
+            ElemType key = pQueue->keys[i];
+            steps.push_back({ 0, [handle, i, key](ADTObject *obj) {
+                auto pQueue = static_cast<PriorityQueue *>(obj);
+                pQueue->unsiftUp(pQueue->position[handle], i);
+                pQueue->keys[i] = key;
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(PriorityQueueDecreaseKey)
+
+    // 由线性表中的元素建堆，原有的元素被丢弃；第 k 个元素的句柄为 k - 1
+    class HeapifyPriorityQueue : public Function {
+    ENABLE_SINGLETON(HeapifyPriorityQueue)
+    SIGNATURE(ADT_ARG(PriorityQueue), ADT_FAMILY_ARG(SequenceList))
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pQueue = args.adt<PriorityQueue>(0);
+            auto pList = args.adt<SequenceList>(1);
+            if (!pQueue->initialized || pList->elem == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pQueue->heapify(pList->elem, pList->length) ? DSCxx_OK : DSCxx_INFEASIBLE;
+        }
+    };
+
+    SINGLETON_MEMBER(HeapifyPriorityQueue)
+
+    // 将线性表中最大的 k 个元素按非递增的顺序写入 Target（原有的内容被覆盖），k 超过表长时取全部元素
+    // 用容量为 k 的 4 叉小顶堆扫描一遍，比堆顶大的元素替换堆顶，时间为 O(n log k)，额外空间为 O(k)
+    class TopKInSequenceList : public Function {
+    ENABLE_SINGLETON(TopKInSequenceList)
+    SIGNATURE(ADT_FAMILY_ARG(SequenceList), INT_ARG, ADT_ARG(SequenceList))
+    SNAPSHOT_ARGS(2)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SequenceList>(0);
+            int k = args.value(1);
+            auto pTarget = args.adt<SequenceList>(2);
+            if (pList->elem == nullptr || k < 0) {
+                return DSCxx_ERROR;
+            }
+            if (k > pList->length) k = pList->length;
+            PriorityQueue heap;
+            if (!heap.heapify(pList->elem, k)) {
+                return DSCxx_INFEASIBLE;
+            }
+            for (int i = k; i < pList->length && k > 0; ++i) {
+                if (i % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return DSCxx_INFEASIBLE;
+                }
+                if (pList->elem[i] > heap.keys[0]) {
+                    heap.keys[0] = pList->elem[i];
+                    heap.siftDown(0);
+                }
+            }
+            // Target 可能就是 List，所以扫描完成之后才写入
+            if (ResizeSequenceList(pTarget, k) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            for (int i = k - 1; i >= 0; --i) {
+                pTarget->elem[i] = heap.pop();
+            }
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(TopKInSequenceList)
+}
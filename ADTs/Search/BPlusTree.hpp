@@ -0,0 +1,679 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "List/SequenceList.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace DataStructure_Cxx {
+
+#define BPLUS_TREE_CACHE_LINE 64
+#define BPLUS_TREE_LEAF_CAPACITY 56         // 叶结点 256 字节（4 个缓存行）：两个兄弟指针、计数以及 56 个关键字
+#define BPLUS_TREE_INNER_CAPACITY 40        // 内部结点 512 字节（8 个缓存行），关键字集中在前 3 个缓存行中
+#define BPLUS_TREE_MAX_HEIGHT 16
+#define BPLUS_TREE_POOL_BLOCK_SIZE (64 * 1024)
+
+    // 关键字允许重复。分隔关键字 keys[i] 不大于右侧子树中的所有关键字、不小于左侧子树中的所有关键字，
+    // 删除只移除变空的结点而不做合并，分隔关键字始终保持这一性质
+    struct alignas(BPLUS_TREE_CACHE_LINE) BPlusTreeLeaf {
+        BPlusTreeLeaf *prev;
+        BPlusTreeLeaf *next;
+        int count;
+        ElemType keys[BPLUS_TREE_LEAF_CAPACITY];
+    };
+
+    struct alignas(BPLUS_TREE_CACHE_LINE) BPlusTreeInner {
+        int count;                                          // 关键字个数，子结点个数为 count + 1
+        ElemType keys[BPLUS_TREE_INNER_CAPACITY];
+        void *children[BPLUS_TREE_INNER_CAPACITY + 1];      // 高度为 1 时指向叶结点，否则指向内部结点
+    };
+
+    // 结点内查找：统计 keys[0, count) 中小于 key（Upper 为 true 时为不大于 key）的关键字个数
+    // 关键字有序，所以这个个数就是查找位置；使用 SSE2 时每次比较 4 个关键字，不需要逐个分支判断
+    template<bool Upper>
+    inline int BPlusTreeNodeSearch(const ElemType *keys, int count, ElemType key) {
+#ifdef __SSE2__
+        static const int bitCount[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+        __m128i target = _mm_set1_epi32(key);
+        int n = 0;
+        for (int i = 0; i < count; i += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i *) (keys + i));
+            int bits = Upper ? (~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, target))) & 0xF)
+                             : _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(v, target)));
+            if (count - i < 4) {
+                bits &= (1 << (count - i)) - 1;
+            }
+            n += bitCount[bits];
+            if (bits != 0xF) break;
+        }
+        return n;
+#else
+        int n = 0;
+        while (n < count && (Upper ? keys[n] <= key : keys[n] < key)) ++n;
+        return n;
+#endif
+    }
+
+    // B+ 树的结点池：结点按缓存行对齐，从大块内存中依次切分，删除的结点放回对应的空闲链表中复用
+    class BPlusTreePool {
+    private:
+        vector<void *> blocks;
+        char *cursor = nullptr;
+        size_t remaining = 0;
+        void *freeLeaves = nullptr;
+        void *freeInners = nullptr;
+
+        void *allocate(size_t size, void *&freeList) {
+            if (freeList != nullptr) {
+                void *node = freeList;
+                freeList = *(void **) node;
+                return node;
+            }
+            if (remaining < size) {
+                auto block = malloc(BPLUS_TREE_POOL_BLOCK_SIZE + BPLUS_TREE_CACHE_LINE);
+                if (!block) exit(DSCxx_OVERFLOW);
+                blocks.push_back(block);
+                auto address = (uintptr_t) block;
+                cursor = (char *) ((address + BPLUS_TREE_CACHE_LINE - 1) & ~(uintptr_t) (BPLUS_TREE_CACHE_LINE - 1));
+                remaining = BPLUS_TREE_POOL_BLOCK_SIZE;
+            }
+            void *node = cursor;
+            cursor += size;
+            remaining -= size;
+            return node;
+        }
+
+    public:
+        BPlusTreePool() = default;
+        BPlusTreePool(const BPlusTreePool &) = delete;
+        BPlusTreePool &operator=(const BPlusTreePool &) = delete;
+
+        ~BPlusTreePool() {
+            for (auto block : blocks) {
+                free(block);
+            }
+        }
+
+        BPlusTreeLeaf *newLeaf() {
+            auto leaf = (BPlusTreeLeaf *) allocate(sizeof(BPlusTreeLeaf), freeLeaves);
+            leaf->prev = leaf->next = nullptr;
+            leaf->count = 0;
+            return leaf;
+        }
+
+        BPlusTreeInner *newInner() {
+            auto inner = (BPlusTreeInner *) allocate(sizeof(BPlusTreeInner), freeInners);
+            inner->count = 0;
+            return inner;
+        }
+
+        void deleteLeaf(BPlusTreeLeaf *leaf) {
+            *(void **) leaf = freeLeaves;
+            freeLeaves = leaf;
+        }
+
+        void deleteInner(BPlusTreeInner *inner) {
+            *(void **) inner = freeInners;
+            freeInners = inner;
+        }
+    };
+
+    // 从根到叶的查找路径，插入时用于自底向上分裂，删除时用于摘除变空的结点
+    struct BPlusTreePath {
+        BPlusTreeInner *nodes[BPLUS_TREE_MAX_HEIGHT];
+        int index[BPLUS_TREE_MAX_HEIGHT];   // 在 nodes[d] 中走向的子结点下标
+        BPlusTreeLeaf *leaf;
+    };
+
+    class BPlusTree : public ADTObject {
+    public:
+        BPlusTreePool *pool = nullptr;
+        void *root = nullptr;
+        int height = 0;                 // 内部结点的层数，为 0 时根就是叶结点
+        int length = 0;
+        BPlusTreeLeaf *firstLeaf = nullptr;
+
+        ADTObject *copy() override {
+            auto pastedObj = new BPlusTree;
+            pastedObj->pool = pool;
+            pastedObj->root = root;
+            pastedObj->height = height;
+            pastedObj->length = length;
+            pastedObj->firstLeaf = firstLeaf;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "BPlusTree";
+        }
+
+        // 深拷贝时按顺序取出全部关键字，再批量构造一棵新树
+        ADTObject *clone() override {
+            auto clonedObj = new BPlusTree;
+            if (root == nullptr) return clonedObj;
+            vector<ElemType> keys;
+            keys.reserve(length);
+            for (auto leaf = firstLeaf; leaf != nullptr; leaf = leaf->next) {
+                keys.insert(keys.end(), leaf->keys, leaf->keys + leaf->count);
+            }
+            clonedObj->bulkLoad(keys.data(), (int) keys.size());
+            return clonedObj;
+        }
+
+        void release() override {
+            delete pool;
+            pool = nullptr;
+            root = nullptr;
+            firstLeaf = nullptr;
+            height = 0;
+            length = 0;
+        }
+
+        // 格式：是否已初始化、关键字个数、按顺序排列的全部关键字，恢复时批量构造
+        void serialize(string &out) override {
+            putU8(out, root != nullptr);
+            putI32(out, length);
+            for (auto leaf = firstLeaf; leaf != nullptr; leaf = leaf->next) {
+                putI32Array(out, leaf->keys, leaf->count);
+            }
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            bool initialized = in.getU8() != 0;
+            int n = in.getI32();
+            if (!in.ok || n < 0 || !in.require((size_t) n * sizeof(int32_t))) return false;
+            if (!initialized) return true;
+            vector<ElemType> keys(n);
+            if (!in.getI32Array(keys.data(), n)) return false;
+            for (int i = 1; i < n; ++i) {
+                if (keys[i] < keys[i - 1]) return false;
+            }
+            return bulkLoad(keys.data(), n);
+        }
+
+        void reset() {
+            release();
+            pool = new BPlusTreePool;
+            firstLeaf = pool->newLeaf();
+            root = firstLeaf;
+        }
+
+        // 用有序的关键字批量构造：叶结点依次填满，再逐层向上构造内部结点，每个结点只写一次
+        // 构造过程中检查是否被取消，被取消时原来的树保持不变，返回 false
+        bool bulkLoad(const ElemType *keys, int n) {
+            auto newPool = new BPlusTreePool;
+            vector<void *> level;
+            vector<ElemType> lows;      // 每个结点子树中的最小关键字，作为上一层的分隔关键字
+            BPlusTreeLeaf *prevLeaf = nullptr, *first = nullptr;
+            for (int i = 0; i < n || first == nullptr; i += BPLUS_TREE_LEAF_CAPACITY) {
+                if (i / BPLUS_TREE_LEAF_CAPACITY % (CANCELLATION_CHUNK_SIZE / 64) == 0 && CancellationToken::requested()) {
+                    delete newPool;
+                    return false;
+                }
+                auto leaf = newPool->newLeaf();
+                leaf->count = (n - i < BPLUS_TREE_LEAF_CAPACITY) ? n - i : BPLUS_TREE_LEAF_CAPACITY;
+                memcpy(leaf->keys, keys + i, leaf->count * sizeof(ElemType));
+                leaf->prev = prevLeaf;
+                if (prevLeaf != nullptr) prevLeaf->next = leaf;
+                else first = leaf;
+                prevLeaf = leaf;
+                level.push_back(leaf);
+                lows.push_back(leaf->count > 0 ? leaf->keys[0] : 0);
+            }
+            int newHeight = 0;
+            while (level.size() > 1) {
+                vector<void *> upper;
+                vector<ElemType> upperLows;
+                for (size_t i = 0; i < level.size(); i += BPLUS_TREE_INNER_CAPACITY + 1) {
+                    auto inner = newPool->newInner();
+                    size_t end = i + BPLUS_TREE_INNER_CAPACITY + 1;
+                    if (end > level.size()) end = level.size();
+                    for (size_t j = i; j < end; ++j) {
+                        inner->children[j - i] = level[j];
+                        if (j > i) inner->keys[j - i - 1] = lows[j];
+                    }
+                    inner->count = (int) (end - i - 1);
+                    upper.push_back(inner);
+                    upperLows.push_back(lows[i]);
+                }
+                level.swap(upper);
+                lows.swap(upperLows);
+                ++newHeight;
+            }
+            delete pool;
+            pool = newPool;
+            root = level[0];
+            height = newHeight;
+            length = n;
+            firstLeaf = first;
+            return true;
+        }
+
+        // 自根向下查找关键字 key 应在的叶结点并记录路径
+        // Upper 为 false 时走向可能包含第一个不小于 key 的关键字的叶结点，为 true 时走向 key 的插入位置
+        template<bool Upper>
+        void descend(ElemType key, BPlusTreePath &path) const {
+            void *node = root;
+            for (int d = 0; d < height; ++d) {
+                auto inner = (BPlusTreeInner *) node;
+                int i = BPlusTreeNodeSearch<Upper>(inner->keys, inner->count, key);
+                path.nodes[d] = inner;
+                path.index[d] = i;
+                node = inner->children[i];
+            }
+            path.leaf = (BPlusTreeLeaf *) node;
+        }
+
+        // 沿路径移动到下一个叶结点（同时更新路径），已经是最后一个叶结点时返回 false
+        bool nextLeaf(BPlusTreePath &path) const {
+            int d = height - 1;
+            while (d >= 0 && path.index[d] == path.nodes[d]->count) --d;
+            if (d < 0) return false;
+            void *node = path.nodes[d]->children[++path.index[d]];
+            for (++d; d < height; ++d) {
+                path.nodes[d] = (BPlusTreeInner *) node;
+                path.index[d] = 0;
+                node = path.nodes[d]->children[0];
+            }
+            path.leaf = (BPlusTreeLeaf *) node;
+            return true;
+        }
+
+        // 第一个不小于 key 的关键字所在的位置，不存在时 leaf 为 nullptr
+        void lowerBound(ElemType key, BPlusTreeLeaf *&leaf, int &pos) const {
+            BPlusTreePath path;
+            descend<false>(key, path);
+            leaf = path.leaf;
+            pos = BPlusTreeNodeSearch<false>(leaf->keys, leaf->count, key);
+            while (leaf != nullptr && pos == leaf->count) {
+                leaf = leaf->next;
+                pos = 0;
+            }
+        }
+
+        bool contains(ElemType key) const {
+            BPlusTreeLeaf *leaf;
+            int pos;
+            lowerBound(key, leaf, pos);
+            return leaf != nullptr && leaf->keys[pos] == key;
+        }
+
+        void insert(ElemType key) {
+            BPlusTreePath path;
+            descend<true>(key, path);
+            auto leaf = path.leaf;
+            int pos = BPlusTreeNodeSearch<true>(leaf->keys, leaf->count, key);
+            ++length;
+            if (leaf->count < BPLUS_TREE_LEAF_CAPACITY) {
+                memmove(leaf->keys + pos + 1, leaf->keys + pos, (leaf->count - pos) * sizeof(ElemType));
+                leaf->keys[pos] = key;
+                ++leaf->count;
+                return;
+            }
+            // 叶结点已满：分裂为两半，右半部分的第一个关键字作为分隔关键字插入父结点
+            ElemType all[BPLUS_TREE_LEAF_CAPACITY + 1];
+            memcpy(all, leaf->keys, pos * sizeof(ElemType));
+            all[pos] = key;
+            memcpy(all + pos + 1, leaf->keys + pos, (leaf->count - pos) * sizeof(ElemType));
+            auto right = pool->newLeaf();
+            int half = (BPLUS_TREE_LEAF_CAPACITY + 1) / 2;
+            leaf->count = half;
+            memcpy(leaf->keys, all, half * sizeof(ElemType));
+            right->count = BPLUS_TREE_LEAF_CAPACITY + 1 - half;
+            memcpy(right->keys, all + half, right->count * sizeof(ElemType));
+            right->prev = leaf;
+            right->next = leaf->next;
+            if (leaf->next != nullptr) leaf->next->prev = right;
+            leaf->next = right;
+
+            ElemType separator = right->keys[0];
+            void *child = right;
+            for (int d = height - 1; d >= 0; --d) {
+                auto inner = path.nodes[d];
+                int i = path.index[d];
+                if (inner->count < BPLUS_TREE_INNER_CAPACITY) {
+                    memmove(inner->keys + i + 1, inner->keys + i, (inner->count - i) * sizeof(ElemType));
+                    memmove(inner->children + i + 2, inner->children + i + 1, (inner->count - i) * sizeof(void *));
+                    inner->keys[i] = separator;
+                    inner->children[i + 1] = child;
+                    ++inner->count;
+                    return;
+                }
+                // 内部结点已满：中间的关键字上移，其余关键字和子结点平分到两个结点中
+                ElemType keys[BPLUS_TREE_INNER_CAPACITY + 1];
+                void *children[BPLUS_TREE_INNER_CAPACITY + 2];
+                memcpy(keys, inner->keys, i * sizeof(ElemType));
+                keys[i] = separator;
+                memcpy(keys + i + 1, inner->keys + i, (inner->count - i) * sizeof(ElemType));
+                memcpy(children, inner->children, (i + 1) * sizeof(void *));
+                children[i + 1] = child;
+                memcpy(children + i + 2, inner->children + i + 1, (inner->count - i) * sizeof(void *));
+                int mid = (BPLUS_TREE_INNER_CAPACITY + 1) / 2;
+                auto rightInner = pool->newInner();
+                inner->count = mid;
+                memcpy(inner->keys, keys, mid * sizeof(ElemType));
+                memcpy(inner->children, children, (mid + 1) * sizeof(void *));
+                rightInner->count = BPLUS_TREE_INNER_CAPACITY - mid;
+                memcpy(rightInner->keys, keys + mid + 1, rightInner->count * sizeof(ElemType));
+                memcpy(rightInner->children, children + mid + 1, (rightInner->count + 1) * sizeof(void *));
+                separator = keys[mid];
+                child = rightInner;
+            }
+            // 根结点也分裂了，树长高一层
+            auto newRoot = pool->newInner();
+            newRoot->count = 1;
+            newRoot->keys[0] = separator;
+            newRoot->children[0] = root;
+            newRoot->children[1] = child;
+            root = newRoot;
+            ++height;
+        }
+
+        // 删除一个等于 key 的关键字，不存在时返回 false
+        bool erase(ElemType key) {
+            BPlusTreePath path;
+            descend<false>(key, path);
+            int pos = BPlusTreeNodeSearch<false>(path.leaf->keys, path.leaf->count, key);
+            while (pos == path.leaf->count) {
+                if (!nextLeaf(path)) return false;
+                pos = 0;
+            }
+            auto leaf = path.leaf;
+            if (leaf->keys[pos] != key) return false;
+            memmove(leaf->keys + pos, leaf->keys + pos + 1, (leaf->count - pos - 1) * sizeof(ElemType));
+            --leaf->count;
+            --length;
+            if (leaf->count > 0 || height == 0) return true;
+
+            // 叶结点变空：从兄弟链表和父结点中摘除，父结点的子结点也全部被摘除时继续向上处理
+            if (leaf->prev != nullptr) leaf->prev->next = leaf->next;
+            else firstLeaf = leaf->next;
+            if (leaf->next != nullptr) leaf->next->prev = leaf->prev;
+            pool->deleteLeaf(leaf);
+            for (int d = height - 1; d >= 0; --d) {
+                auto inner = path.nodes[d];
+                int i = path.index[d];
+                if (inner->count == 0) {
+                    // 只剩下被摘除的这一个子结点，该结点也随之摘除；根结点被摘除说明整棵树已经空了
+                    pool->deleteInner(inner);
+                    if (d == 0) {
+                        firstLeaf = pool->newLeaf();
+                        root = firstLeaf;
+                        height = 0;
+                        return true;
+                    }
+                    continue;
+                }
+                int k = (i > 0) ? i - 1 : 0;    // 与被摘除的子结点一起删除的分隔关键字
+                memmove(inner->keys + k, inner->keys + k + 1, (inner->count - k - 1) * sizeof(ElemType));
+                memmove(inner->children + i, inner->children + i + 1, (inner->count - i) * sizeof(void *));
+                --inner->count;
+                break;
+            }
+            // 根结点只剩下一个子结点时降低树高
+            while (height > 0 && ((BPlusTreeInner *) root)->count == 0) {
+                auto oldRoot = (BPlusTreeInner *) root;
+                root = oldRoot->children[0];
+                pool->deleteInner(oldRoot);
+                --height;
+            }
+            return true;
+        }
+
+        // 统计值在闭区间 [low, high] 中的关键字个数：两次查找定位首尾，中间的叶结点只需累加计数
+        int countRange(ElemType low, ElemType high) const {
+            if (low > high) return 0;
+            BPlusTreeLeaf *first;
+            int firstPos;
+            lowerBound(low, first, firstPos);
+            if (first == nullptr || first->keys[firstPos] > high) return 0;
+            BPlusTreePath path;
+            descend<true>(high, path);
+            auto last = path.leaf;
+            int lastPos = BPlusTreeNodeSearch<true>(last->keys, last->count, high);
+            if (first == last) {
+                return (lastPos > firstPos) ? lastPos - firstPos : 0;
+            }
+            int count = first->count - firstPos;
+            for (auto leaf = first->next; leaf != last && leaf != nullptr; leaf = leaf->next) {
+                count += leaf->count;
+            }
+            return count + lastPos;
+        }
+    };
+
+    class InitBPlusTree : public Function {
+    ENABLE_SINGLETON(InitBPlusTree)
+    SIGNATURE(ADT_ARG(BPlusTree))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            args.adt<BPlusTree>(0)->reset();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(InitBPlusTree)
+
+    class DestroyBPlusTree : public Function {
+    ENABLE_SINGLETON(DestroyBPlusTree)
+    SIGNATURE(ADT_ARG(BPlusTree))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pTree = args.adt<BPlusTree>(0);
+            if (pTree->root == nullptr) {
+                return DSCxx_ERROR;
+            }
+            pTree->release();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DestroyBPlusTree)
+
+    class BPlusTreeLength : public Function {
+    ENABLE_SINGLETON(BPlusTreeLength)
+    SIGNATURE(ADT_ARG(BPlusTree))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pTree = args.adt<BPlusTree>(0);
+            if (pTree->root == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pTree->length;
+        }
+    };
+
+    SINGLETON_MEMBER(BPlusTreeLength)
+
+    // 用有序线性表中的全部元素批量构造 B+ 树（树中原有的关键字被替换），线性表无序时返回 ERROR
+    class BulkLoadBPlusTree : public Function {
+    ENABLE_SINGLETON(BulkLoadBPlusTree)
+    SIGNATURE(ADT_ARG(BPlusTree), ADT_FAMILY_ARG(SequenceList))
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pTree = args.adt<BPlusTree>(0);
+            auto pList = args.adt<SequenceList>(1);
+            if (pList->elem == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (!pList->sorted) {
+                for (int i = 1; i < pList->length; ++i) {
+                    if (pList->elem[i - 1] > pList->elem[i]) return DSCxx_ERROR;
+                }
+            }
+            return pTree->bulkLoad(pList->elem, pList->length) ? DSCxx_OK : DSCxx_INFEASIBLE;
+        }
+    };
+
+    SINGLETON_MEMBER(BulkLoadBPlusTree)
+
+    class BPlusTreeInsert : public Function {
+    ENABLE_SINGLETON(BPlusTreeInsert)
+    SIGNATURE(ADT_ARG(BPlusTree), VAR_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pTree = args.adt<BPlusTree>(0);
+            if (pTree->root == nullptr) {
+                return DSCxx_ERROR;
+            }
+            pTree->insert(*args.var(1));
+            return DSCxx_OK;
+        }
+
+        // 关键字允许重复，删除任意一个等于 e 的关键字即可撤销，结点的形状不影响之后的结果
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            if (args.adt<BPlusTree>(0)->root == nullptr) {
+                return true;
+            }
+            ElemType e = *args.var(1);
+            steps.push_back({ 0, [e](ADTObject *obj) {
+                static_cast<BPlusTree *>(obj)->erase(e);
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(BPlusTreeInsert)
+
+    // 删除一个等于 e 的关键字，不存在时返回 FALSE
+    class BPlusTreeDelete : public Function {
+    ENABLE_SINGLETON(BPlusTreeDelete)
+    SIGNATURE(ADT_ARG(BPlusTree), VAR_ARG)
+    VALUE_STATUS_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pTree = args.adt<BPlusTree>(0);
+            if (pTree->root == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pTree->erase(*args.var(1)) ? DSCxx_TRUE : DSCxx_FALSE;
+        }
+
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pTree = args.adt<BPlusTree>(0);
+            ElemType e = *args.var(1);
+            if (pTree->root == nullptr || !pTree->contains(e)) {
+                return true;
+            }
+            steps.push_back({ 0, [e](ADTObject *obj) {
+                static_cast<BPlusTree *>(obj)->insert(e);
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(BPlusTreeDelete)
+
+    class BPlusTreeSearch : public Function {
+    ENABLE_SINGLETON(BPlusTreeSearch)
+    SIGNATURE(ADT_ARG(BPlusTree), VAR_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pTree = args.adt<BPlusTree>(0);
+            if (pTree->root == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pTree->contains(*args.var(1)) ? DSCxx_TRUE : DSCxx_FALSE;
+        }
+    };
+
+    SINGLETON_MEMBER(BPlusTreeSearch)
+
+    // 返回值在闭区间 [low, high] 中的关键字个数
+    class CountRangeInBPlusTree : public Function {
+    ENABLE_SINGLETON(CountRangeInBPlusTree)
+    SIGNATURE(ADT_ARG(BPlusTree), VAR_ARG, VAR_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pTree = args.adt<BPlusTree>(0);
+            if (pTree->root == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pTree->countRange(*args.var(1), *args.var(2));
+        }
+    };
+
+    SINGLETON_MEMBER(CountRangeInBPlusTree)
+
+    // 将值在闭区间 [low, high] 中的关键字按顺序写入线性表（线性表原有的内容被覆盖）
+    class ExtractRangeFromBPlusTree : public Function {
+    ENABLE_SINGLETON(ExtractRangeFromBPlusTree)
+    SIGNATURE(ADT_ARG(BPlusTree), VAR_ARG, VAR_ARG, ADT_ARG(SequenceList))
+    SNAPSHOT_ARGS(3)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pTree = args.adt<BPlusTree>(0);
+            auto pList = args.adt<SequenceList>(3);
+            if (pTree->root == nullptr) {
+                return DSCxx_ERROR;
+            }
+            ElemType low = *args.var(1), high = *args.var(2);
+            int count = pTree->countRange(low, high);
+            if (ResizeSequenceList(pList, count) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            if (count == 0) {
+                return DSCxx_OK;
+            }
+            // 从第一个关键字开始沿叶结点链表逐块复制
+            BPlusTreeLeaf *leaf;
+            int pos;
+            pTree->lowerBound(low, leaf, pos);
+            int k = 0;
+            while (k < count) {
+                if (k / CANCELLATION_CHUNK_SIZE != (k + leaf->count) / CANCELLATION_CHUNK_SIZE &&
+                    CancellationToken::requested()) {
+                    pList->length = k;
+                    return DSCxx_INFEASIBLE;
+                }
+                int n = leaf->count - pos;
+                if (n > count - k) n = count - k;
+                memcpy(pList->elem + k, leaf->keys + pos, n * sizeof(ElemType));
+                k += n;
+                leaf = leaf->next;
+                pos = 0;
+            }
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(ExtractRangeFromBPlusTree)
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Interactor.h"
+#include "SkipList.hpp"
+#include "BPlusTree.hpp"
+
+using namespace DataStructure_Cxx;
+
+// 查找表（动态有序集合）的全部指令，由 ADTLoader.hpp 汇总到编译期生成的指令表中
+#define SEARCH_INSTRUCTIONS \
+    LoadFunc(InitSkipList) \
+    LoadFunc(DestroySkipList) \
+    LoadFunc(SkipListLength) \
+    LoadFunc(SkipListInsert) \
+    LoadFunc(SkipListDelete) \
+    LoadFunc(SkipListSearch) \
+    LoadFunc(SkipListRank) \
+    LoadFunc(GetElemInSkipList) \
+    LoadFunc(SkipListToSequenceList) \
+    LoadFunc(InitBPlusTree) \
+    LoadFunc(DestroyBPlusTree) \
+    LoadFunc(BPlusTreeLength) \
+    LoadFunc(BulkLoadBPlusTree) \
+    LoadFunc(BPlusTreeInsert) \
+    LoadFunc(BPlusTreeDelete) \
+    LoadFunc(BPlusTreeSearch) \
+    LoadFunc(CountRangeInBPlusTree) \
+    LoadFunc(ExtractRangeFromBPlusTree)
+
+void loadSearch() {
+    auto pSkipList = new SkipList;
+    Interactor::instance()->addAdtType("SkipList", pSkipList);
+    auto pBPlusTree = new BPlusTree;
+    Interactor::instance()->addAdtType("BPlusTree", pBPlusTree);
+}
@@ -0,0 +1,561 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "List/SequenceList.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace DataStructure_Cxx {
+
+#define SKIP_LIST_MAX_LEVEL 24                      // 层数上限，按 1/4 的晋升概率足以容纳上亿个元素
+#define SKIP_LIST_POOL_BLOCK_SIZE (64 * 1024)       // 结点池每次向系统申请的内存块大小（字节）
+
+    // 跳表结点：每一层保存后继以及到后继跨过的元素个数（span），用于在 O(log n) 时间内求秩、按秩取值
+    // links 的实际长度为 level，结点按层数从结点池中分配
+    struct SkipListNode {
+        struct Link {
+            SkipListNode *next;
+            int span;
+        };
+        ElemType key;
+        int level;
+        Link links[1];
+
+        static size_t sizeFor(int level) {
+            size_t size = sizeof(SkipListNode) + (level - 1) * sizeof(Link);
+            return (size + alignof(SkipListNode) - 1) / alignof(SkipListNode) * alignof(SkipListNode);
+        }
+    };
+
+    // 跳表的结点池：从大块内存中依次切分结点，删除的结点按层数挂到对应的空闲链表上，之后优先复用
+    // 所有结点随结点池一起释放，不需要逐个 free
+    class SkipListPool {
+    private:
+        vector<char *> blocks;
+        size_t used = SKIP_LIST_POOL_BLOCK_SIZE;
+        SkipListNode *freeLists[SKIP_LIST_MAX_LEVEL + 1] = {};
+
+    public:
+        SkipListPool() = default;
+        SkipListPool(const SkipListPool &) = delete;
+        SkipListPool &operator=(const SkipListPool &) = delete;
+
+        ~SkipListPool() {
+            for (auto block : blocks) {
+                free(block);
+            }
+        }
+
+        SkipListNode *allocate(int level) {
+            SkipListNode *node;
+            auto &freeList = freeLists[level];
+            if (freeList != nullptr) {
+                node = freeList;
+                freeList = freeList->links[0].next;
+            }
+            else {
+                size_t size = SkipListNode::sizeFor(level);
+                if (used + size > SKIP_LIST_POOL_BLOCK_SIZE) {
+                    auto block = (char *) malloc(SKIP_LIST_POOL_BLOCK_SIZE);
+                    if (!block) exit(DSCxx_OVERFLOW);
+                    blocks.push_back(block);
+                    used = 0;
+                }
+                node = (SkipListNode *) (blocks.back() + used);
+                used += size;
+            }
+            node->level = level;
+            return node;
+        }
+
+        void deallocate(SkipListNode *node) {
+            node->links[0].next = freeLists[node->level];
+            freeLists[node->level] = node;
+        }
+    };
+
+    class SkipList : public ADTObject {
+    public:
+        SkipListPool *pool = nullptr;
+        SkipListNode *head = nullptr;   // 头结点，拥有全部 SKIP_LIST_MAX_LEVEL 层
+        int length = 0;
+        int level = 1;                  // 当前使用中的最高层数
+        uint64_t rngState = 0;          // xorshift64* 随机数发生器的状态，由初始化时给定的种子决定
+
+        ADTObject *copy() override {
+            auto pastedObj = new SkipList;
+            pastedObj->pool = pool;
+            pastedObj->head = head;
+            pastedObj->length = length;
+            pastedObj->level = level;
+            pastedObj->rngState = rngState;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "SkipList";
+        }
+
+        // 深拷贝时保持每个结点的层数不变，按顺序重建各层的链接和 span
+        ADTObject *clone() override {
+            auto clonedObj = new SkipList;
+            clonedObj->length = length;
+            clonedObj->level = level;
+            clonedObj->rngState = rngState;
+            if (head == nullptr) return clonedObj;
+            clonedObj->pool = new SkipListPool;
+            clonedObj->head = NewSkipListHead(clonedObj->pool);
+            SkipListNode *last[SKIP_LIST_MAX_LEVEL];
+            int lastRank[SKIP_LIST_MAX_LEVEL];
+            for (int i = 0; i < SKIP_LIST_MAX_LEVEL; ++i) {
+                last[i] = clonedObj->head;
+                lastRank[i] = 0;
+            }
+            int rank = 0;
+            for (auto x = head->links[0].next; x != nullptr; x = x->links[0].next) {
+                ++rank;
+                auto y = clonedObj->pool->allocate(x->level);
+                y->key = x->key;
+                for (int i = 0; i < x->level; ++i) {
+                    last[i]->links[i].next = y;
+                    last[i]->links[i].span = rank - lastRank[i];
+                    last[i] = y;
+                    lastRank[i] = rank;
+                }
+            }
+            for (int i = 0; i < level; ++i) {
+                last[i]->links[i].next = nullptr;
+                last[i]->links[i].span = length - lastRank[i];
+            }
+            return clonedObj;
+        }
+
+        void release() override {
+            delete pool;
+            pool = nullptr;
+            head = nullptr;
+        }
+
+        // 格式：是否已初始化、随机数状态、层数、长度，然后按顺序是每个结点的元素和层数
+        // 恢复时结点的层数保持不变，之后的插入也会得到与原跳表完全相同的随机层数
+        void serialize(string& out) override {
+            putU8(out, head != nullptr);
+            putU64(out, rngState);
+            putI32(out, level);
+            putI32(out, length);
+            if (head == nullptr) return;
+            for (auto x = head->links[0].next; x != nullptr; x = x->links[0].next) {
+                putI32(out, x->key);
+                putU8(out, (uint8_t) x->level);
+            }
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            bool initialized = in.getU8() != 0;
+            rngState = in.getU64();
+            level = in.getI32();
+            length = in.getI32();
+            if (!in.ok || level < 1 || level > SKIP_LIST_MAX_LEVEL || length < 0) return false;
+            if (!initialized) return true;
+            pool = new SkipListPool;
+            head = NewSkipListHead(pool);
+            SkipListNode *last[SKIP_LIST_MAX_LEVEL];
+            int lastRank[SKIP_LIST_MAX_LEVEL];
+            for (int i = 0; i < SKIP_LIST_MAX_LEVEL; ++i) {
+                last[i] = head;
+                lastRank[i] = 0;
+            }
+            for (int rank = 1; rank <= length; ++rank) {
+                ElemType key = in.getI32();
+                int lvl = in.getU8();
+                if (!in.ok || lvl < 1 || lvl > level) return false;
+                auto y = pool->allocate(lvl);
+                y->key = key;
+                for (int i = 0; i < lvl; ++i) {
+                    last[i]->links[i].next = y;
+                    last[i]->links[i].span = rank - lastRank[i];
+                    last[i] = y;
+                    lastRank[i] = rank;
+                }
+            }
+            for (int i = 0; i < level; ++i) {
+                last[i]->links[i].next = nullptr;
+                last[i]->links[i].span = length - lastRank[i];
+            }
+            return true;
+        }
+
+        static SkipListNode *NewSkipListHead(SkipListPool *pool) {
+            auto node = pool->allocate(SKIP_LIST_MAX_LEVEL);
+            for (int i = 0; i < SKIP_LIST_MAX_LEVEL; ++i) {
+                node->links[i].next = nullptr;
+                node->links[i].span = 0;
+            }
+            return node;
+        }
+
+        // xorshift64*：状态只有一个 64 位整数，每次只需几次移位、异或和一次乘法
+        uint64_t nextRandom() {
+            rngState ^= rngState >> 12;
+            rngState ^= rngState << 25;
+            rngState ^= rngState >> 27;
+            return rngState * 2685821657736338717ULL;
+        }
+
+        // 每层以 1/4 的概率晋升，一次取出的随机数足够决定全部层数
+        int randomLevel() {
+            uint64_t r = nextRandom();
+            int lvl = 1;
+            while ((r & 3) == 0 && lvl < SKIP_LIST_MAX_LEVEL) {
+                ++lvl;
+                r >>= 2;
+            }
+            return lvl;
+        }
+
+        // 以下操作的期望时间复杂度均为 O(log n)
+
+        bool contains(ElemType key) const {
+            auto x = head;
+            for (int i = level - 1; i >= 0; --i) {
+                while (x->links[i].next != nullptr && x->links[i].next->key < key) {
+                    x = x->links[i].next;
+                }
+            }
+            x = x->links[0].next;
+            return x != nullptr && x->key == key;
+        }
+
+        // 插入成功返回 true，元素已存在时返回 false；lvl 为 0 时随机决定新结点的层数
+        bool insert(ElemType key, int lvl = 0) {
+            SkipListNode *update[SKIP_LIST_MAX_LEVEL];
+            int rank[SKIP_LIST_MAX_LEVEL];
+            auto x = head;
+            for (int i = level - 1; i >= 0; --i) {
+                rank[i] = (i == level - 1) ? 0 : rank[i + 1];
+                while (x->links[i].next != nullptr && x->links[i].next->key < key) {
+                    rank[i] += x->links[i].span;
+                    x = x->links[i].next;
+                }
+                update[i] = x;
+            }
+            if (x->links[0].next != nullptr && x->links[0].next->key == key) {
+                return false;
+            }
+            if (lvl == 0) lvl = randomLevel();
+            if (lvl > level) {
+                for (int i = level; i < lvl; ++i) {
+                    rank[i] = 0;
+                    update[i] = head;
+                    head->links[i].span = length;
+                }
+                level = lvl;
+            }
+            x = pool->allocate(lvl);
+            x->key = key;
+            for (int i = 0; i < lvl; ++i) {
+                x->links[i].next = update[i]->links[i].next;
+                update[i]->links[i].next = x;
+                x->links[i].span = update[i]->links[i].span - (rank[0] - rank[i]);
+                update[i]->links[i].span = (rank[0] - rank[i]) + 1;
+            }
+            for (int i = lvl; i < level; ++i) {
+                ++update[i]->links[i].span;
+            }
+            ++length;
+            return true;
+        }
+
+        // 删除成功返回 true，元素不存在时返回 false
+        bool erase(ElemType key) {
+            SkipListNode *update[SKIP_LIST_MAX_LEVEL];
+            auto x = head;
+            for (int i = level - 1; i >= 0; --i) {
+                while (x->links[i].next != nullptr && x->links[i].next->key < key) {
+                    x = x->links[i].next;
+                }
+                update[i] = x;
+            }
+            x = x->links[0].next;
+            if (x == nullptr || x->key != key) {
+                return false;
+            }
+            for (int i = 0; i < level; ++i) {
+                if (update[i]->links[i].next == x) {
+                    update[i]->links[i].span += x->links[i].span - 1;
+                    update[i]->links[i].next = x->links[i].next;
+                }
+                else {
+                    --update[i]->links[i].span;
+                }
+            }
+            while (level > 1 && head->links[level - 1].next == nullptr) {
+                --level;
+            }
+            --length;
+            pool->deallocate(x);
+            return true;
+        }
+
+        // 返回元素的秩（即在有序序列中的位序），元素不存在时返回 0
+        int rankOf(ElemType key) const {
+            auto x = head;
+            int rank = 0;
+            for (int i = level - 1; i >= 0; --i) {
+                while (x->links[i].next != nullptr && x->links[i].next->key <= key) {
+                    rank += x->links[i].span;
+                    x = x->links[i].next;
+                }
+            }
+            return (x != head && x->key == key) ? rank : 0;
+        }
+
+        // 返回秩为 k 的结点，k 超出范围时返回 nullptr
+        SkipListNode *select(int k) const {
+            if (k < 1 || k > length) return nullptr;
+            auto x = head;
+            int traversed = 0;
+            for (int i = level - 1; i >= 0; --i) {
+                while (x->links[i].next != nullptr && traversed + x->links[i].span <= k) {
+                    traversed += x->links[i].span;
+                    x = x->links[i].next;
+                }
+                if (traversed == k) return x;
+            }
+            return nullptr;
+        }
+    };
+
+    // 用给定的种子初始化跳表，相同的种子和相同的操作序列总是得到结构完全相同的跳表
+    class InitSkipList : public Function {
+    ENABLE_SINGLETON(InitSkipList)
+    SIGNATURE(ADT_ARG(SkipList), INT_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SkipList>(0);
+            pList->release();
+            pList->pool = new SkipListPool;
+            pList->head = SkipList::NewSkipListHead(pList->pool);
+            pList->length = 0;
+            pList->level = 1;
+            // 用 splitmix64 打散种子，保证状态不为 0（xorshift 的状态为 0 时只会输出 0）
+            uint64_t z = (uint64_t) (uint32_t) args.value(1) + 0x9e3779b97f4a7c15ULL;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            pList->rngState = (z ^ (z >> 31)) | 1;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(InitSkipList)
+
+    class DestroySkipList : public Function {
+    ENABLE_SINGLETON(DestroySkipList)
+    SIGNATURE(ADT_ARG(SkipList))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SkipList>(0);
+            if (pList->head == nullptr) {
+                return DSCxx_ERROR;
+            }
+            pList->release();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(DestroySkipList)
+
+    class SkipListLength : public Function {
+    ENABLE_SINGLETON(SkipListLength)
+    SIGNATURE(ADT_ARG(SkipList))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SkipList>(0);
+            if (pList->head == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pList->length;
+        }
+    };
+
+    SINGLETON_MEMBER(SkipListLength)
+
+    // 插入元素 e，元素已存在时返回 FALSE
+    class SkipListInsert : public Function {
+    ENABLE_SINGLETON(SkipListInsert)
+    SIGNATURE(ADT_ARG(SkipList), VAR_ARG)
+    VALUE_STATUS_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SkipList>(0);
+            if (pList->head == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pList->insert(*args.var(1)) ? DSCxx_TRUE : DSCxx_FALSE;
+        }
+
+        // 删除新插入的结点，并让随机数状态回到插入之前，之后的插入仍得到相同的层数
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pList = args.adt<SkipList>(0);
+            ElemType e = *args.var(1);
+            if (pList->head == nullptr || pList->contains(e)) {
+                return true;
+            }
+            uint64_t rngState = pList->rngState;
+            steps.push_back({ 0, [e, rngState](ADTObject *obj) {
+                auto pList = static_cast<SkipList *>(obj);
+                pList->erase(e);
+                pList->rngState = rngState;
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(SkipListInsert)
+
+    // 删除元素 e，元素不存在时返回 FALSE
+    class SkipListDelete : public Function {
+    ENABLE_SINGLETON(SkipListDelete)
+    SIGNATURE(ADT_ARG(SkipList), VAR_ARG)
+    VALUE_STATUS_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SkipList>(0);
+            if (pList->head == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pList->erase(*args.var(1)) ? DSCxx_TRUE : DSCxx_FALSE;
+        }
+
+        // 按原来的层数重新插入被删除的结点
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pList = args.adt<SkipList>(0);
+            ElemType e = *args.var(1);
+            int rank = (pList->head != nullptr) ? pList->rankOf(e) : 0;
+            if (rank == 0) {
+                return true;
+            }
+            int lvl = pList->select(rank)->level;
+            steps.push_back({ 0, [e, lvl](ADTObject *obj) {
+                static_cast<SkipList *>(obj)->insert(e, lvl);
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(SkipListDelete)
+
+    class SkipListSearch : public Function {
+    ENABLE_SINGLETON(SkipListSearch)
+    SIGNATURE(ADT_ARG(SkipList), VAR_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SkipList>(0);
+            if (pList->head == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pList->contains(*args.var(1)) ? DSCxx_TRUE : DSCxx_FALSE;
+        }
+    };
+
+    SINGLETON_MEMBER(SkipListSearch)
+
+    // 返回元素 e 的秩（从 1 开始），元素不存在时返回 0
+    class SkipListRank : public Function {
+    ENABLE_SINGLETON(SkipListRank)
+    SIGNATURE(ADT_ARG(SkipList), VAR_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SkipList>(0);
+            if (pList->head == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pList->rankOf(*args.var(1));
+        }
+    };
+
+    SINGLETON_MEMBER(SkipListRank)
+
+    // 用 pVar 返回秩为 k 的元素
+    class GetElemInSkipList : public Function {
+    ENABLE_SINGLETON(GetElemInSkipList)
+    SIGNATURE(ADT_ARG(SkipList), INT_ARG, VAR_ARG)
+    VARIABLE_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pList = args.adt<SkipList>(0);
+            if (pList->head == nullptr) {
+                return DSCxx_ERROR;
+            }
+            auto node = pList->select(args.value(1));
+            if (node == nullptr) {
+                return DSCxx_ERROR;
+            }
+            *args.var(2) = node->key;
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(GetElemInSkipList)
+
+    // 按从小到大的顺序将全部元素写入线性表（线性表原有的内容被覆盖）
+    class SkipListToSequenceList : public Function {
+    ENABLE_SINGLETON(SkipListToSequenceList)
+    SIGNATURE(ADT_ARG(SkipList), ADT_ARG(SequenceList))
+    SNAPSHOT_ARGS(1)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pSkipList = args.adt<SkipList>(0);
+            auto pList = args.adt<SequenceList>(1);
+            if (pSkipList->head == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (ResizeSequenceList(pList, pSkipList->length) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            int k = 0;
+            for (auto x = pSkipList->head->links[0].next; x != nullptr; x = x->links[0].next) {
+                if (k % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    pList->length = k;
+                    return DSCxx_INFEASIBLE;
+                }
+                pList->elem[k++] = x->key;
+            }
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(SkipListToSequenceList)
+}
@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "StringSearch.hpp"
+#include "List/SequenceList.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+namespace DataStructure_Cxx {
+
+    // 串的堆分配存储表示（参见教材 4.2.2）：ch 指向按串长分配的存储区，空串时为 nullptr
+    // 与教材一样，新建的串就是空串，不需要先初始化；位序都从 1 开始
+    class HString : public ADTObject {
+    public:
+        char *ch = nullptr;
+        int length = 0;
+
+        ADTObject *copy() override {
+            auto pastedObj = new HString;
+            pastedObj->ch = ch;
+            pastedObj->length = length;
+            return pastedObj;
+        }
+
+        string str() override {
+            return "HString";
+        }
+
+        ADTObject *clone() override {
+            auto clonedObj = new HString;
+            clonedObj->assign(ch, length);
+            return clonedObj;
+        }
+
+        void release() override {
+            free(ch);
+            ch = nullptr;
+            length = 0;
+        }
+
+        // 格式：串长、各字符
+        void serialize(string &out) override {
+            putString(out, string(ch != nullptr ? ch : "", (size_t) length));
+        }
+
+        bool deserialize(BinaryReader &in) override {
+            string chars = in.getString();
+            if (!in.ok || chars.size() > INT_MAX) return false;
+            assign(chars.data(), (int) chars.size());
+            return true;
+        }
+
+        // 分配能容纳 n 个字符的存储区，空串返回 nullptr
+        static char *AllocChars(int n) {
+            if (n == 0) return nullptr;
+            auto chars = (char *) malloc((size_t) n);
+            if (!chars) exit(DSCxx_OVERFLOW);
+            return chars;
+        }
+
+        // 以 n 个字符替换串的内容，chars 可以指向串本身
+        void assign(const char *chars, int n) {
+            auto newCh = AllocChars(n);
+            if (n > 0) memcpy(newCh, chars, (size_t) n);
+            free(ch);
+            ch = newCh;
+            length = n;
+        }
+
+        // 直接接管 chars 作为新的存储区
+        void adopt(char *chars, int n) {
+            free(ch);
+            ch = chars;
+            length = n;
+        }
+    };
+
+    // 生成一个其值等于串常量 Chars 的串 T，例如 StrAssign(T, "hello, world")
+    class StrAssign : public Function {
+    ENABLE_SINGLETON(StrAssign)
+    SIGNATURE(ADT_ARG(HString), TEXT_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pString = args.adt<HString>(0);
+            auto chars = args.text(1);
+            pString->assign(chars.data(), (int) chars.size());
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(StrAssign)
+
+    // 由串 S 复制得串 T
+    class StrCopy : public Function {
+    ENABLE_SINGLETON(StrCopy)
+    SIGNATURE(ADT_ARG(HString), ADT_ARG(HString))
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pTarget = args.adt<HString>(0);
+            auto pSource = args.adt<HString>(1);
+            pTarget->assign(pSource->ch, pSource->length);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(StrCopy)
+
+    class StrEmpty : public Function {
+    ENABLE_SINGLETON(StrEmpty)
+    SIGNATURE(ADT_ARG(HString))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            return args.adt<HString>(0)->length == 0 ? DSCxx_TRUE : DSCxx_FALSE;
+        }
+    };
+
+    SINGLETON_MEMBER(StrEmpty)
+
+    class StrLength : public Function {
+    ENABLE_SINGLETON(StrLength)
+    SIGNATURE(ADT_ARG(HString))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            return args.adt<HString>(0)->length;
+        }
+    };
+
+    SINGLETON_MEMBER(StrLength)
+
+    // 若 S > T，则返回值 > 0；若 S = T，则返回值 = 0；若 S < T，则返回值 < 0
+    class StrCompare : public Function {
+    ENABLE_SINGLETON(StrCompare)
+    SIGNATURE(ADT_ARG(HString), ADT_ARG(HString))
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pS = args.adt<HString>(0);
+            auto pT = args.adt<HString>(1);
+            for (int i = 0; i < pS->length && i < pT->length; ++i) {
+                if (pS->ch[i] != pT->ch[i]) return (unsigned char) pS->ch[i] - (unsigned char) pT->ch[i];
+            }
+            return pS->length - pT->length;
+        }
+    };
+
+    SINGLETON_MEMBER(StrCompare)
+
+    // 将 S 清为空串，并释放 S 所占空间
+    class ClearString : public Function {
+    ENABLE_SINGLETON(ClearString)
+    SIGNATURE(ADT_ARG(HString))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            args.adt<HString>(0)->release();
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(ClearString)
+
+    // 用 T 返回由 S1 和 S2 联接而成的新串，T 可以就是 S1 或 S2
+    class Concat : public Function {
+    ENABLE_SINGLETON(Concat)
+    SIGNATURE(ADT_ARG(HString), ADT_ARG(HString), ADT_ARG(HString))
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pTarget = args.adt<HString>(0);
+            auto pS1 = args.adt<HString>(1);
+            auto pS2 = args.adt<HString>(2);
+            if ((int64_t) pS1->length + pS2->length > INT_MAX) {
+                return DSCxx_OVERFLOW;
+            }
+            int n = pS1->length + pS2->length;
+            auto chars = HString::AllocChars(n);
+            if (pS1->length > 0) memcpy(chars, pS1->ch, (size_t) pS1->length);
+            if (pS2->length > 0) memcpy(chars + pS1->length, pS2->ch, (size_t) pS2->length);
+            pTarget->adopt(chars, n);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(Concat)
+
+    // 用 Sub 返回串 S 的第 pos 个字符起长度为 len 的子串，1 <= pos <= StrLength(S) 且 0 <= len <= StrLength(S) - pos + 1
+    class SubString : public Function {
+    ENABLE_SINGLETON(SubString)
+    SIGNATURE(ADT_ARG(HString), ADT_ARG(HString), INT_ARG, INT_ARG)
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pSub = args.adt<HString>(0);
+            auto pString = args.adt<HString>(1);
+            int pos = args.value(2);
+            int len = args.value(3);
+            if (pos < 1 || pos > pString->length || len < 0 || len > pString->length - pos + 1) {
+                return DSCxx_ERROR;
+            }
+            pSub->assign(pString->ch + pos - 1, len);
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(SubString)
+
+    // 在串 S 的第 pos 个字符之前插入串 T，1 <= pos <= StrLength(S) + 1，T 可以就是 S
+    class StrInsert : public Function {
+    ENABLE_SINGLETON(StrInsert)
+    SIGNATURE(ADT_ARG(HString), INT_ARG, ADT_ARG(HString))
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pString = args.adt<HString>(0);
+            int pos = args.value(1);
+            auto pInserted = args.adt<HString>(2);
+            if (pos < 1 || pos > pString->length + 1) {
+                return DSCxx_ERROR;
+            }
+            if ((int64_t) pString->length + pInserted->length > INT_MAX) {
+                return DSCxx_OVERFLOW;
+            }
+            int n = pString->length + pInserted->length;
+            auto chars = HString::AllocChars(n);
+            if (pos > 1) memcpy(chars, pString->ch, (size_t) pos - 1);
+            if (pInserted->length > 0) memcpy(chars + pos - 1, pInserted->ch, (size_t) pInserted->length);
+            if (pString->length >= pos) {
+                memcpy(chars + pos - 1 + pInserted->length, pString->ch + pos - 1, (size_t) (pString->length - pos + 1));
+            }
+            pString->adopt(chars, n);
+            return DSCxx_OK;
+        }
+
+        // 删去插入的 len 个字符
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            int length = args.adt<HString>(0)->length;
+            int pos = args.value(1);
+            int len = args.adt<HString>(2)->length;
+            steps.push_back({ 0, [length, pos, len](ADTObject *obj) {
+                auto pString = static_cast<HString *>(obj);
+                if (pString->length != length + len) return;
+                memmove(pString->ch + pos - 1, pString->ch + pos - 1 + len, (size_t) (length - pos + 1));
+                if (length == 0) {
+                    pString->release();
+                }
+                else {
+                    pString->length = length;
+                }
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(StrInsert)
+
+    // 从串 S 中删除第 pos 个字符起长度为 len 的子串
+    class StrDelete : public Function {
+    ENABLE_SINGLETON(StrDelete)
+    SIGNATURE(ADT_ARG(HString), INT_ARG, INT_ARG)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pString = args.adt<HString>(0);
+            int pos = args.value(1);
+            int len = args.value(2);
+            if (pos < 1 || pos > pString->length || len < 0 || len > pString->length - pos + 1) {
+                return DSCxx_ERROR;
+            }
+            memmove(pString->ch + pos - 1, pString->ch + pos - 1 + len, (size_t) (pString->length - pos + 1 - len));
+            int n = pString->length - len;
+            if (n == 0) {
+                pString->release();
+            }
+            else {
+                pString->length = n;
+            }
+            return DSCxx_OK;
+        }
+
+        // 保存被删除的子串，回滚时插回原位
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pString = args.adt<HString>(0);
+            int pos = args.value(1);
+            int len = args.value(2);
+            if (pos < 1 || pos > pString->length || len <= 0 || len > pString->length - pos + 1) {
+                return true;
+            }
+            string deleted(pString->ch + pos - 1, (size_t) len);
+            steps.push_back({ 0, [pos, deleted](ADTObject *obj) {
+                HString inserted;
+                inserted.assign(deleted.data(), (int) deleted.size());
+                StrInsert::instance()->invoke({ obj, pos, &inserted });
+                inserted.release();
+            } });
+            return true;
+        }
+    };
+
+    SINGLETON_MEMBER(StrDelete)
+
+    // 若主串 S 中第 pos 个字符之后存在与 T 相等的子串，则返回第一个这样的子串在 S 中的位置，否则返回 0
+    // T 必须非空，1 <= pos <= StrLength(S)；查找算法按 T 的长度自动选择（参见 StringSearch.hpp）
+    class Index : public Function {
+    ENABLE_SINGLETON(Index)
+    SIGNATURE(ADT_ARG(HString), ADT_ARG(HString), INT_ARG)
+    READ_ONLY_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pString = args.adt<HString>(0);
+            auto pPattern = args.adt<HString>(1);
+            int pos = args.value(2);
+            if (pPattern->length == 0 || pos < 1 || pos > pString->length) {
+                return DSCxx_ERROR;
+            }
+            StringSearcher searcher(pPattern->ch, pPattern->length);
+            return searcher.find(pString->ch, pString->length, pos - 1) + 1;
+        }
+    };
+
+    SINGLETON_MEMBER(Index)
+
+    // 将 T 在 S 中出现的所有位置（可以重叠，位序从 1 开始，按递增顺序）存入线性表 L，原有内容被覆盖，返回出现的次数
+    class IndexAllInString : public Function {
+    ENABLE_SINGLETON(IndexAllInString)
+    SIGNATURE(ADT_ARG(HString), ADT_ARG(HString), ADT_ARG(SequenceList))
+    SNAPSHOT_ARGS(2)
+    VALUE_STATUS_INSTRUCTION
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pString = args.adt<HString>(0);
+            auto pPattern = args.adt<HString>(1);
+            auto pList = args.adt<SequenceList>(2);
+            if (pPattern->length == 0) {
+                return DSCxx_ERROR;
+            }
+            StringSearcher searcher(pPattern->ch, pPattern->length);
+            vector<ElemType> positions;
+            int i = searcher.find(pString->ch, pString->length, 0);
+            while (i >= 0) {
+                if (positions.size() % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return DSCxx_INFEASIBLE;
+                }
+                positions.push_back(i + 1);
+                i = searcher.find(pString->ch, pString->length, i + 1);
+            }
+            if (ResizeSequenceList(pList, (int) positions.size()) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            if (!positions.empty()) {
+                memcpy(pList->elem, positions.data(), positions.size() * sizeof(ElemType));
+            }
+            return (Status) positions.size();
+        }
+    };
+
+    SINGLETON_MEMBER(IndexAllInString)
+
+    // 用 V 替换主串 S 中出现的所有与 T 相等的不重叠的子串，T 必须非空；模式串只预处理一次，结果一次性写入新的存储区
+    class Replace : public Function {
+    ENABLE_SINGLETON(Replace)
+    SIGNATURE(ADT_ARG(HString), ADT_ARG(HString), ADT_ARG(HString))
+    SNAPSHOT_ARGS(0)
+
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pString = args.adt<HString>(0);
+            auto pPattern = args.adt<HString>(1);
+            auto pValue = args.adt<HString>(2);
+            if (pPattern->length == 0) {
+                return DSCxx_ERROR;
+            }
+            StringSearcher searcher(pPattern->ch, pPattern->length);
+            string result;
+            int copied = 0, count = 0;
+            int i = searcher.find(pString->ch, pString->length, 0);
+            while (i >= 0) {
+                if (++count % CANCELLATION_CHUNK_SIZE == 0 && CancellationToken::requested()) {
+                    return DSCxx_INFEASIBLE;
+                }
+                result.append(pString->ch + copied, (size_t) (i - copied));
+                result.append(pValue->ch != nullptr ? pValue->ch : "", (size_t) pValue->length);
+                copied = i + pPattern->length;
+                if (result.size() + (size_t) (pString->length - copied) > INT_MAX) {
+                    return DSCxx_OVERFLOW;
+                }
+                i = searcher.find(pString->ch, pString->length, copied);
+            }
+            if (count == 0) {
+                return DSCxx_OK;
+            }
+            result.append(pString->ch + copied, (size_t) (pString->length - copied));
+            pString->assign(result.data(), (int) result.size());
+            return DSCxx_OK;
+        }
+    };
+
+    SINGLETON_MEMBER(Replace)
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+
+#include <cstring>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace DataStructure_Cxx {
+
+#define STRING_SIMD_MAX_PATTERN 32      // 模式串超过该长度时，SIMD 过滤的候选位置太多则改用 Two-Way
+
+    // 子串查找：模式串只预处理一次，之后可以在多个位置、多个主串中反复查找
+    // - Naive：朴素的模式匹配（参见教材算法 4.5），先用 memchr 跳到首字符出现的位置
+    // - KMP：按 nextval 数组（参见教材算法 4.8）移动模式串，主串指针不回溯，最坏 O(n + m)
+    // - TwoWay：Crochemore-Perrin 双向匹配，按临界分解先从左向右匹配右半部分、再从右向左匹配左半部分，
+    //   最坏 O(n + m)，除模式串本身之外只需常数的额外空间，长模式串时移动的距离也更大
+    // - SimdFilter：每次比较 16 个位置的首字符和尾字符，两者都相同的位置才比较中间的部分，
+    //   绝大多数位置一次就被排除；但首尾字符频繁相同时（例如主串和模式串都由重复的字符组成）会退化为 O(nm)，
+    //   所以较长的模式串同时做 Two-Way 的预处理，候选位置上比较的字符数超出预算时改用 Two-Way 继续查找；
+    //   不支持 SSE2 时退化为 Naive
+    // KMP 在实际的文本上通常慢于其他算法，只作为教材算法保留，不会被自动选择
+    class StringSearcher {
+    public:
+        enum Engine : uint8_t { Naive, KMP, TwoWay, SimdFilter, EngineCount };
+
+        static const char *EngineName(Engine engine) {
+            static const char *names[EngineCount] = { "Naive", "KMP", "Two-Way", "SIMD filter" };
+            return names[engine];
+        }
+
+        // 按模式串的长度选择：单个字符直接用 memchr，其余用 SIMD 过滤（长模式串有 Two-Way 兜底）；
+        // 不支持 SSE2 时，短模式串用 Naive，长模式串用 Two-Way
+        static Engine Choose(int m) {
+            if (m <= 1) return Naive;
+#ifdef __SSE2__
+            return SimdFilter;
+#else
+            return (m <= STRING_SIMD_MAX_PATTERN) ? Naive : TwoWay;
+#endif
+        }
+
+        StringSearcher(const char *pattern, int m, Engine engine) : pat((const unsigned char *) pattern), m(m), engine(engine) {
+            if (engine == KMP) {
+                buildNextval();
+            }
+            else if (engine == TwoWay || (engine == SimdFilter && m > STRING_SIMD_MAX_PATTERN)) {
+                buildCriticalFactorization();
+            }
+        }
+
+        StringSearcher(const char *pattern, int m) : StringSearcher(pattern, m, Choose(m)) {}
+
+        // 在长度为 n 的主串中从下标 from 开始查找，返回第一次出现的下标，不存在时返回 -1；模式串为空时返回 from
+        int find(const char *text, int n, int from) const {
+            if (m == 0) return (from <= n) ? from : -1;
+            if (from < 0 || n - from < m) return -1;
+            auto t = (const unsigned char *) text;
+            switch (engine) {
+                case KMP: return findKMP(t, n, from);
+                case TwoWay: return findTwoWay(t, n, from);
+                case SimdFilter: return findSimdFilter(t, n, from);
+                default: return findNaive(t, n, from);
+            }
+        }
+
+    private:
+        const unsigned char *pat;
+        int m;
+        Engine engine;
+        vector<int> nextval;    // KMP：pat[j] 失配时模式串应继续比较的位置，为 -1 时主串前进一位
+        int ell = 0;            // Two-Way：临界分解的位置，左半部分为 pat[0, ell]
+        int per = 0;            // Two-Way：右半部分匹配之后（或整个模式串匹配之后）的移动距离
+        bool periodic = false;  // Two-Way：模式串的周期是否为 per，是则匹配之后可以记住已经比较过的前缀
+
+        int findNaive(const unsigned char *t, int n, int from) const {
+            int last = n - m;
+            for (int i = from; i <= last;) {
+                auto p = (const unsigned char *) memchr(t + i, pat[0], (size_t) (last - i + 1));
+                if (p == nullptr) return -1;
+                i = (int) (p - t);
+                if (memcmp(t + i + 1, pat + 1, (size_t) m - 1) == 0) return i;
+                ++i;
+            }
+            return -1;
+        }
+
+        // 教材算法 4.8（get_nextval）的下标从 0 开始的写法
+        void buildNextval() {
+            nextval.assign((size_t) m, -1);
+            int i = 0, j = -1;
+            while (i < m - 1) {
+                if (j == -1 || pat[i] == pat[j]) {
+                    ++i;
+                    ++j;
+                    nextval[i] = (pat[i] != pat[j]) ? j : nextval[j];
+                }
+                else {
+                    j = nextval[j];
+                }
+            }
+        }
+
+        int findKMP(const unsigned char *t, int n, int from) const {
+            int i = from, j = 0;
+            while (i < n) {
+                if (j == -1 || t[i] == pat[j]) {
+                    ++i;
+                    ++j;
+                    if (j == m) return i - m;
+                }
+                else {
+                    j = nextval[j];
+                }
+            }
+            return -1;
+        }
+
+        // 按 Less 定义的字母序求模式串的最大后缀，返回其起点的前一个位置，period 为该后缀的周期
+        template<bool Less>
+        int maximalSuffix(int &period) const {
+            int ms = -1, j = 0, k = 1;
+            period = 1;
+            while (j + k < m) {
+                unsigned char a = pat[j + k], b = pat[ms + k];
+                if (Less ? a < b : a > b) {
+                    j += k;
+                    k = 1;
+                    period = j - ms;
+                }
+                else if (a == b) {
+                    if (k != period) {
+                        ++k;
+                    }
+                    else {
+                        j += period;
+                        k = 1;
+                    }
+                }
+                else {
+                    ms = j;
+                    j = ms + 1;
+                    k = period = 1;
+                }
+            }
+            return ms;
+        }
+
+        // 两种字母序下的最大后缀中较短的一个给出临界分解
+        void buildCriticalFactorization() {
+            int p, q;
+            int i = maximalSuffix<true>(p);
+            int j = maximalSuffix<false>(q);
+            ell = (i > j) ? i : j;
+            per = (i > j) ? p : q;
+            periodic = ell + 1 + per <= m && memcmp(pat, pat + per, (size_t) ell + 1) == 0;
+            if (!periodic) {
+                per = ((ell + 1 > m - ell - 1) ? ell + 1 : m - ell - 1) + 1;
+            }
+        }
+
+        int findTwoWay(const unsigned char *t, int n, int from) const {
+            int j = from;
+            if (periodic) {
+                int memory = -1;    // pat[0, memory] 已知与主串相同
+                while (j <= n - m) {
+                    int i = ((ell > memory) ? ell : memory) + 1;
+                    while (i < m && pat[i] == t[i + j]) ++i;
+                    if (i >= m) {
+                        i = ell;
+                        while (i > memory && pat[i] == t[i + j]) --i;
+                        if (i <= memory) return j;
+                        j += per;
+                        memory = m - per - 1;
+                    }
+                    else {
+                        j += i - ell;
+                        memory = -1;
+                    }
+                }
+            }
+            else {
+                while (j <= n - m) {
+                    int i = ell + 1;
+                    while (i < m && pat[i] == t[i + j]) ++i;
+                    if (i >= m) {
+                        i = ell;
+                        while (i >= 0 && pat[i] == t[i + j]) --i;
+                        if (i < 0) return j;
+                        j += per;
+                    }
+                    else {
+                        j += i - ell;
+                    }
+                }
+            }
+            return -1;
+        }
+
+        int findSimdFilter(const unsigned char *t, int n, int from) const {
+            int i = from;
+#ifdef __SSE2__
+            bool guarded = m > STRING_SIMD_MAX_PATTERN;
+            int64_t wasted = 0;     // 在未匹配的候选位置上比较过的字符数
+            __m128i first = _mm_set1_epi8((char) pat[0]);
+            __m128i last = _mm_set1_epi8((char) pat[m - 1]);
+            // 每次检查以 i ~ i + 15 为起点的 16 个位置，尾字符的读取不能越过主串的末尾
+            for (; i + m + 15 <= n; i += 16) {
+                __m128i head = _mm_loadu_si128((const __m128i *) (t + i));
+                __m128i tail = _mm_loadu_si128((const __m128i *) (t + i + m - 1));
+                auto mask = (unsigned) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(head, first),
+                                                                      _mm_cmpeq_epi8(tail, last)));
+                while (mask != 0) {
+                    int k = __builtin_ctz(mask);
+                    if (!guarded) {
+                        if (m <= 2 || memcmp(t + i + k + 1, pat + 1, (size_t) m - 2) == 0) return i + k;
+                    }
+                    else {
+                        int j = 1;
+                        while (j < m - 1 && t[i + k + j] == pat[j]) ++j;
+                        if (j >= m - 1) return i + k;
+                        wasted += j;
+                        // 预算：已经扫描过的字节数再加上若干个模式串的长度
+                        if (wasted > (int64_t) (i - from) + 8 * (int64_t) m) return findTwoWay(t, n, i + k + 1);
+                    }
+                    mask &= mask - 1;
+                }
+            }
+            // 剩下的不到 m + 15 个位置：长模式串逐个比较仍可能是 O(m^2)，所以交给 Two-Way
+            if (guarded) return findTwoWay(t, n, i);
+#endif
+            return findNaive(t, n, i);
+        }
+    };
+}
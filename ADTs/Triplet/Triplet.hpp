@@ -18,166 +18,93 @@
 
 #include "Common.h"
 #include "Interactor.h"
-
-#include <cstdlib>
+#include "TripletCore.hpp"
 
 namespace DataStructure_Cxx
 {
-    class Triplet : public ADTObject {
-    public:
-        ElemType* p = nullptr;
-        ADTObject* copy() override {
-            auto pastedObj = new Triplet;
-            pastedObj->p = p;
-            return pastedObj;
-        }
-        string str() override {
-            return "Triplet";
-        }
-    };
+    // 三元组的指令：解码参数之后直接调用 TripletCore.hpp 中的类型化接口
 
     class InitTriplet : public Function {
         ENABLE_SINGLETON(InitTriplet)
+        SIGNATURE(ADT_ARG(Triplet), INT_ARG, INT_ARG, INT_ARG)
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(4)
-            Triplet* pTriplet = (Triplet*)Interactor::instance()->getADT(args[0]);
-            pTriplet->p = (ElemType*)std::malloc(3 * sizeof(ElemType));
-            if (!pTriplet->p) exit(DSCxx_OVERFLOW);
-            for (size_t i = 0; i < 3; ++i) {
-                pTriplet->p[i] = stoi(args[i + 1]);
-            }
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return InitTriplet_T(*args.adt<Triplet>(0), args.value(1), args.value(2), args.value(3));
         }
     };
     SINGLETON_MEMBER(InitTriplet)
 
     class DestroyTriplet : public Function {
         ENABLE_SINGLETON(DestroyTriplet)
+        SIGNATURE(ADT_ARG(Triplet))
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(1)
-            Triplet* pTriplet = (Triplet*)Interactor::instance()->getADT(args[0]);
-            if (pTriplet->p == nullptr) {
-                return DSCxx_ERROR;
-            }
-            free(pTriplet->p);
-            pTriplet->p = nullptr;
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return DestroyTriplet_T(*args.adt<Triplet>(0));
         }
     };
     SINGLETON_MEMBER(DestroyTriplet)
 
     class GetElemInTriplet : public Function {
         ENABLE_SINGLETON(GetElemInTriplet)
+        SIGNATURE(ADT_ARG(Triplet), INT_ARG, VAR_ARG)
+        VARIABLE_ONLY_INSTRUCTION
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(3)
-            Triplet* pTriplet = (Triplet*)Interactor::instance()->getADT(args[0]);
-            if (pTriplet->p == nullptr) {
-                return DSCxx_ERROR;
-            }
-            int i = stoi(args[1]);
-            ElemType* pVar = Interactor::instance()->getVariable(args[2]);
-            if (i < 1 || i > 3) {
-                return DSCxx_ERROR;
-            }
-            *pVar = pTriplet->p[i - 1];
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return Get_T(*args.adt<Triplet>(0), args.value(1), *args.var(2));
         }
     };
     SINGLETON_MEMBER(GetElemInTriplet)
 
     class PutElemIntoTriplet : public Function {
         ENABLE_SINGLETON(PutElemIntoTriplet)
+        SIGNATURE(ADT_ARG(Triplet), INT_ARG, INT_ARG)
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(3)
-            Triplet* pTriplet = (Triplet*)Interactor::instance()->getADT(args[0]);
-            if (pTriplet->p == nullptr) {
-                return DSCxx_ERROR;
-            }
-            int i = stoi(args[1]);
-            ElemType value = stoi(args[2]);
-            if (i < 1 || i > 3) {
-                return DSCxx_ERROR;
-            }
-            pTriplet->p[i - 1] = value;
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return Put_T(*args.adt<Triplet>(0), args.value(1), args.value(2));
         }
     };
     SINGLETON_MEMBER(PutElemIntoTriplet)
 
     class IsTripletAscending : public Function {
         ENABLE_SINGLETON(IsTripletAscending)
+        SIGNATURE(ADT_ARG(Triplet))
+        READ_ONLY_INSTRUCTION
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(1)
-            Triplet* pTriplet = (Triplet*)Interactor::instance()->getADT(args[0]);
-            if (pTriplet->p == nullptr) {
-                return DSCxx_ERROR;
-            }
-            if (pTriplet->p[0] <= pTriplet->p[1] && pTriplet->p[1] <= pTriplet->p[2]) {
-                return DSCxx_TRUE;
-            }
-            else {
-                return DSCxx_FALSE;
-            }
+        Status invoke(const ArgBlock &args) override {
+            return IsAscending_T(*args.adt<Triplet>(0));
         }
     };
     SINGLETON_MEMBER(IsTripletAscending)
 
     class IsTripletDescending : public Function {
         ENABLE_SINGLETON(IsTripletDescending)
+        SIGNATURE(ADT_ARG(Triplet))
+        READ_ONLY_INSTRUCTION
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(1)
-            Triplet* pTriplet = (Triplet*)Interactor::instance()->getADT(args[0]);
-            if (pTriplet->p == nullptr) {
-                return DSCxx_ERROR;
-            }
-            if (pTriplet->p[0] >= pTriplet->p[1] && pTriplet->p[1] >= pTriplet->p[2]) {
-                return DSCxx_TRUE;
-            }
-            else {
-                return DSCxx_FALSE;
-            }
+        Status invoke(const ArgBlock &args) override {
+            return IsDescending_T(*args.adt<Triplet>(0));
         }
     };
     SINGLETON_MEMBER(IsTripletDescending)
 
     class GetMaxInTriplet : public Function {
         ENABLE_SINGLETON(GetMaxInTriplet)
+        SIGNATURE(ADT_ARG(Triplet), VAR_ARG)
+        VARIABLE_ONLY_INSTRUCTION
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(2)
-            Triplet* pTriplet = (Triplet*)Interactor::instance()->getADT(args[0]);
-            if (pTriplet->p == nullptr) {
-                return DSCxx_ERROR;
-            }
-            ElemType* pVar = Interactor::instance()->getVariable(args[1]);
-            *pVar = (pTriplet->p[0] >= pTriplet->p[1]) ?
-                    (pTriplet->p[0] >= pTriplet->p[2]) ? pTriplet->p[0] : pTriplet->p[2] :
-                    (pTriplet->p[1] >= pTriplet->p[2]) ? pTriplet->p[1] : pTriplet->p[2];
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return Max_T(*args.adt<Triplet>(0), *args.var(1));
         }
     };
     SINGLETON_MEMBER(GetMaxInTriplet)
 
     class GetMinInTriplet : public Function {
-    ENABLE_SINGLETON(GetMinInTriplet)
+        ENABLE_SINGLETON(GetMinInTriplet)
+        SIGNATURE(ADT_ARG(Triplet), VAR_ARG)
+        VARIABLE_ONLY_INSTRUCTION
     public:
-        Status invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(2)
-            Triplet* pTriplet = (Triplet*)Interactor::instance()->getADT(args[0]);
-            if (pTriplet->p == nullptr) {
-                return DSCxx_ERROR;
-            }
-            ElemType* pVar = Interactor::instance()->getVariable(args[1]);
-            *pVar = (pTriplet->p[0] <= pTriplet->p[1]) ?
-                    (pTriplet->p[0] <= pTriplet->p[2]) ? pTriplet->p[0] : pTriplet->p[2] :
-                    (pTriplet->p[1] <= pTriplet->p[2]) ? pTriplet->p[1] : pTriplet->p[2];
-            return DSCxx_OK;
+        Status invoke(const ArgBlock &args) override {
+            return Min_T(*args.adt<Triplet>(0), *args.var(1));
         }
     };
     SINGLETON_MEMBER(GetMinInTriplet)
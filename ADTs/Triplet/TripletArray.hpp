@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+#include "Interactor.h"
+#include "Triplet.hpp"
+#include "List/SequenceList.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace DataStructure_Cxx
+{
+
+#define TRIPLET_ARRAY_INIT_SIZE 64      // 三元组数组存储空间的初始分配量（以三元组为单位）
+
+    // TripletArray 以“结构数组”（Structure of Arrays）的形式存储 N 个三元组：
+    // 第 1、2、3 个分量分别存放在三段连续的数组中，批量指令只需顺序扫描这三段内存，
+    // 循环体中没有分支，编译器可以直接将其向量化
+    class TripletArray : public ADTObject {
+    public:
+        ElemType* e1 = nullptr;     // 所有三元组的第 1 个分量
+        ElemType* e2 = nullptr;     // 所有三元组的第 2 个分量
+        ElemType* e3 = nullptr;     // 所有三元组的第 3 个分量
+        int length = 0;             // 当前存储的三元组个数
+        int arraysize = 0;          // 当前分配的存储容量（以三元组为单位）
+        ADTObject* copy() override {
+            auto pastedObj = new TripletArray;
+            pastedObj->e1 = e1;
+            pastedObj->e2 = e2;
+            pastedObj->e3 = e3;
+            pastedObj->length = length;
+            pastedObj->arraysize = arraysize;
+            return pastedObj;
+        }
+        string str() override {
+            return "TripletArray";
+        }
+        ADTObject* clone() override {
+            auto clonedObj = new TripletArray;
+            if (e1 != nullptr) {
+                clonedObj->reserve(arraysize);
+                std::memcpy(clonedObj->e1, e1, length * sizeof(ElemType));
+                std::memcpy(clonedObj->e2, e2, length * sizeof(ElemType));
+                std::memcpy(clonedObj->e3, e3, length * sizeof(ElemType));
+                clonedObj->length = length;
+            }
+            return clonedObj;
+        }
+        void release() override {
+            free(e1);
+            free(e2);
+            free(e3);
+            e1 = e2 = e3 = nullptr;
+            length = arraysize = 0;
+        }
+        // 格式：是否已初始化、三元组个数、三个分量数组
+        void serialize(string& out) override {
+            putU8(out, e1 != nullptr);
+            putI32(out, length);
+            putI32Array(out, e1, length);
+            putI32Array(out, e2, length);
+            putI32Array(out, e3, length);
+        }
+        bool deserialize(BinaryReader& in) override {
+            bool initialized = in.getU8() != 0;
+            int size = in.getI32();
+            if (!in.ok || size < 0 || !in.require((size_t)size * 3 * sizeof(int32_t))) return false;
+            if (!initialized) return true;
+            reserve(size > 0 ? size : TRIPLET_ARRAY_INIT_SIZE);
+            length = size;
+            return in.getI32Array(e1, size) && in.getI32Array(e2, size) && in.getI32Array(e3, size);
+        }
+
+        ElemType* component(int i) {
+            return (i == 1) ? e1 : (i == 2) ? e2 : (i == 3) ? e3 : nullptr;
+        }
+
+        // 保证至少能够容纳 size 个三元组，容量按倍数增长，使得逐个追加的均摊代价为 O(1)
+        void reserve(int size) {
+            if (size <= arraysize) return;
+            int newSize = (arraysize > 0) ? arraysize : TRIPLET_ARRAY_INIT_SIZE;
+            while (newSize < size) newSize *= 2;
+            ElemType** parts[3] = { &e1, &e2, &e3 };
+            for (auto part : parts) {
+                auto newBase = (ElemType*)std::realloc(*part, newSize * sizeof(ElemType));
+                if (!newBase) exit(DSCxx_OVERFLOW);
+                *part = newBase;
+            }
+            arraysize = newSize;
+        }
+    };
+
+    // 以下为批量指令使用的计算核心，均以 __restrict 修饰指针并写成无分支的形式，便于自动向量化
+
+    // 判断每个三元组是否升序（或降序），结果按位压缩写入 bitmap：
+    // 第 k 个三元组（从 0 开始）对应 bitmap[k / 32] 的第 k % 32 位，返回满足条件的三元组个数
+    inline int TripletArrayOrderKernel(const ElemType* __restrict a, const ElemType* __restrict b,
+                                       const ElemType* __restrict c, int n,
+                                       uint32_t* __restrict bitmap, bool ascending) {
+        int count = 0;
+        for (int base = 0; base < n; base += 32) {
+            int end = (n - base < 32) ? n - base : 32;
+            uint32_t word = 0;
+            for (int j = 0; j < end; ++j) {
+                int k = base + j;
+                uint32_t bit = ascending ?
+                        (uint32_t)((a[k] <= b[k]) & (b[k] <= c[k])) :
+                        (uint32_t)((a[k] >= b[k]) & (b[k] >= c[k]));
+                word |= bit << j;
+                count += (int)bit;
+            }
+            bitmap[base / 32] = word;
+        }
+        return count;
+    }
+
+    inline void TripletArrayMaxKernel(const ElemType* __restrict a, const ElemType* __restrict b,
+                                      const ElemType* __restrict c, int n, ElemType* __restrict out) {
+        for (int k = 0; k < n; ++k) {
+            ElemType m = (a[k] >= b[k]) ? a[k] : b[k];
+            out[k] = (m >= c[k]) ? m : c[k];
+        }
+    }
+
+    inline void TripletArrayMinKernel(const ElemType* __restrict a, const ElemType* __restrict b,
+                                      const ElemType* __restrict c, int n, ElemType* __restrict out) {
+        for (int k = 0; k < n; ++k) {
+            ElemType m = (a[k] <= b[k]) ? a[k] : b[k];
+            out[k] = (m <= c[k]) ? m : c[k];
+        }
+    }
+
+    class InitTripletArray : public Function {
+        ENABLE_SINGLETON(InitTripletArray)
+        SIGNATURE(ADT_ARG(TripletArray))
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            pArray->e1 = pArray->e2 = pArray->e3 = nullptr;
+            pArray->length = pArray->arraysize = 0;
+            pArray->reserve(TRIPLET_ARRAY_INIT_SIZE);
+            return DSCxx_OK;
+        }
+    };
+    SINGLETON_MEMBER(InitTripletArray)
+
+    class DestroyTripletArray : public Function {
+        ENABLE_SINGLETON(DestroyTripletArray)
+        SIGNATURE(ADT_ARG(TripletArray))
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            if (pArray->e1 == nullptr) {
+                return DSCxx_ERROR;
+            }
+            free(pArray->e1);
+            free(pArray->e2);
+            free(pArray->e3);
+            pArray->e1 = pArray->e2 = pArray->e3 = nullptr;
+            pArray->length = pArray->arraysize = 0;
+            return DSCxx_OK;
+        }
+    };
+    SINGLETON_MEMBER(DestroyTripletArray)
+
+    class TripletArrayLength : public Function {
+        ENABLE_SINGLETON(TripletArrayLength)
+        SIGNATURE(ADT_ARG(TripletArray))
+        READ_ONLY_INSTRUCTION
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            if (pArray->e1 == nullptr) {
+                return DSCxx_ERROR;
+            }
+            return pArray->length;
+        }
+    };
+    SINGLETON_MEMBER(TripletArrayLength)
+
+    // 在尾部追加一个由三个整数字面值构成的三元组，用法与 InitTriplet 一致
+    class TripletArrayAppend : public Function {
+        ENABLE_SINGLETON(TripletArrayAppend)
+        SIGNATURE(ADT_ARG(TripletArray), INT_ARG, INT_ARG, INT_ARG)
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            if (pArray->e1 == nullptr) {
+                return DSCxx_ERROR;
+            }
+            int v1 = args.value(1);
+            int v2 = args.value(2);
+            int v3 = args.value(3);
+            pArray->reserve(pArray->length + 1);
+            int k = pArray->length;
+            pArray->e1[k] = v1;
+            pArray->e2[k] = v2;
+            pArray->e3[k] = v3;
+            ++pArray->length;
+            return DSCxx_OK;
+        }
+
+        // 逆操作：追加成功时恢复原来的长度
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            int length = args.adt<TripletArray>(0)->length;
+            steps.push_back({ 0, [length](ADTObject *obj) {
+                static_cast<TripletArray *>(obj)->length = length;
+            } });
+            return true;
+        }
+    };
+    SINGLETON_MEMBER(TripletArrayAppend)
+
+    // 在尾部追加一个已有 Triplet 对象的副本
+    class TripletArrayAppendTriplet : public Function {
+        ENABLE_SINGLETON(TripletArrayAppendTriplet)
+        SIGNATURE(ADT_ARG(TripletArray), ADT_ARG(Triplet))
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            auto pTriplet = args.adt<Triplet>(1);
+            if (pArray->e1 == nullptr || pTriplet->p == nullptr) {
+                return DSCxx_ERROR;
+            }
+            pArray->reserve(pArray->length + 1);
+            int k = pArray->length;
+            pArray->e1[k] = pTriplet->p[0];
+            pArray->e2[k] = pTriplet->p[1];
+            pArray->e3[k] = pTriplet->p[2];
+            ++pArray->length;
+            return DSCxx_OK;
+        }
+
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            int length = args.adt<TripletArray>(0)->length;
+            steps.push_back({ 0, [length](ADTObject *obj) {
+                static_cast<TripletArray *>(obj)->length = length;
+            } });
+            return true;
+        }
+    };
+    SINGLETON_MEMBER(TripletArrayAppendTriplet)
+
+    // 第 k 个三元组（从 1 开始）的第 i 个分量，用变量返回
+    class GetElemInTripletArray : public Function {
+        ENABLE_SINGLETON(GetElemInTripletArray)
+        SIGNATURE(ADT_ARG(TripletArray), INT_ARG, INT_ARG, VAR_ARG)
+        VARIABLE_ONLY_INSTRUCTION
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            if (pArray->e1 == nullptr) {
+                return DSCxx_ERROR;
+            }
+            int k = args.value(1);
+            int i = args.value(2);
+            auto pVar = args.var(3);
+            if (k < 1 || k > pArray->length || i < 1 || i > 3) {
+                return DSCxx_ERROR;
+            }
+            *pVar = pArray->component(i)[k - 1];
+            return DSCxx_OK;
+        }
+    };
+    SINGLETON_MEMBER(GetElemInTripletArray)
+
+    class PutElemIntoTripletArray : public Function {
+        ENABLE_SINGLETON(PutElemIntoTripletArray)
+        SIGNATURE(ADT_ARG(TripletArray), INT_ARG, INT_ARG, INT_ARG)
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            if (pArray->e1 == nullptr) {
+                return DSCxx_ERROR;
+            }
+            int k = args.value(1);
+            int i = args.value(2);
+            int value = args.value(3);
+            if (k < 1 || k > pArray->length || i < 1 || i > 3) {
+                return DSCxx_ERROR;
+            }
+            pArray->component(i)[k - 1] = value;
+            return DSCxx_OK;
+        }
+
+        // 逆操作：写回原来的值
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pArray = args.adt<TripletArray>(0);
+            int k = args.value(1);
+            int i = args.value(2);
+            if (pArray->e1 == nullptr || k < 1 || k > pArray->length || i < 1 || i > 3) {
+                return true;
+            }
+            ElemType value = pArray->component(i)[k - 1];
+            steps.push_back({ 0, [k, i, value](ADTObject *obj) {
+                static_cast<TripletArray *>(obj)->component(i)[k - 1] = value;
+            } });
+            return true;
+        }
+    };
+    SINGLETON_MEMBER(PutElemIntoTripletArray)
+
+    // 批量版本的 GetElemInTriplet：将所有三元组的第 i 个分量依次写入线性表
+    class BatchGetElemInTripletArray : public Function {
+        ENABLE_SINGLETON(BatchGetElemInTripletArray)
+        SIGNATURE(ADT_ARG(TripletArray), INT_ARG, ADT_ARG(SequenceList))
+        SNAPSHOT_ARGS(2)
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            int i = args.value(1);
+            auto pList = args.adt<SequenceList>(2);
+            if (pArray->e1 == nullptr || i < 1 || i > 3) {
+                return DSCxx_ERROR;
+            }
+            if (ResizeSequenceList(pList, pArray->length) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            std::copy(pArray->component(i), pArray->component(i) + pArray->length, pList->elem);
+            return DSCxx_OK;
+        }
+    };
+    SINGLETON_MEMBER(BatchGetElemInTripletArray)
+
+    // 批量版本的 PutElemIntoTriplet：将所有三元组的第 i 个分量都设为 value
+    class BatchPutElemIntoTripletArray : public Function {
+        ENABLE_SINGLETON(BatchPutElemIntoTripletArray)
+        SIGNATURE(ADT_ARG(TripletArray), INT_ARG, INT_ARG)
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            int i = args.value(1);
+            int value = args.value(2);
+            if (pArray->e1 == nullptr || i < 1 || i > 3) {
+                return DSCxx_ERROR;
+            }
+            std::fill(pArray->component(i), pArray->component(i) + pArray->length, value);
+            return DSCxx_OK;
+        }
+
+        // 只改写了一个分量，只需保存这一个分量
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override {
+            auto pArray = args.adt<TripletArray>(0);
+            int i = args.value(1);
+            if (pArray->e1 == nullptr || i < 1 || i > 3) {
+                return true;
+            }
+            vector<ElemType> values(pArray->component(i), pArray->component(i) + pArray->length);
+            steps.push_back({ 0, [i, values](ADTObject *obj) {
+                std::copy(values.begin(), values.end(), static_cast<TripletArray *>(obj)->component(i));
+            } });
+            return true;
+        }
+    };
+    SINGLETON_MEMBER(BatchPutElemIntoTripletArray)
+
+    // 批量版本的 IsTripletAscending：位图写入线性表（每个元素压缩 32 个结果），返回升序三元组的个数
+    class BatchIsTripletAscending : public Function {
+        ENABLE_SINGLETON(BatchIsTripletAscending)
+        SIGNATURE(ADT_ARG(TripletArray), ADT_ARG(SequenceList))
+        SNAPSHOT_ARGS(1)
+        VALUE_STATUS_INSTRUCTION
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            auto pBitmap = args.adt<SequenceList>(1);
+            if (pArray->e1 == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (ResizeSequenceList(pBitmap, (pArray->length + 31) / 32) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            return TripletArrayOrderKernel(pArray->e1, pArray->e2, pArray->e3, pArray->length,
+                                           (uint32_t*)pBitmap->elem, true);
+        }
+    };
+    SINGLETON_MEMBER(BatchIsTripletAscending)
+
+    class BatchIsTripletDescending : public Function {
+        ENABLE_SINGLETON(BatchIsTripletDescending)
+        SIGNATURE(ADT_ARG(TripletArray), ADT_ARG(SequenceList))
+        SNAPSHOT_ARGS(1)
+        VALUE_STATUS_INSTRUCTION
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            auto pBitmap = args.adt<SequenceList>(1);
+            if (pArray->e1 == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (ResizeSequenceList(pBitmap, (pArray->length + 31) / 32) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            return TripletArrayOrderKernel(pArray->e1, pArray->e2, pArray->e3, pArray->length,
+                                           (uint32_t*)pBitmap->elem, false);
+        }
+    };
+    SINGLETON_MEMBER(BatchIsTripletDescending)
+
+    // 批量版本的 GetMaxInTriplet：第 k 个三元组的最大值写入线性表的第 k 个位置
+    class BatchGetMaxInTriplet : public Function {
+        ENABLE_SINGLETON(BatchGetMaxInTriplet)
+        SIGNATURE(ADT_ARG(TripletArray), ADT_ARG(SequenceList))
+        SNAPSHOT_ARGS(1)
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            auto pList = args.adt<SequenceList>(1);
+            if (pArray->e1 == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (ResizeSequenceList(pList, pArray->length) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            TripletArrayMaxKernel(pArray->e1, pArray->e2, pArray->e3, pArray->length, pList->elem);
+            return DSCxx_OK;
+        }
+    };
+    SINGLETON_MEMBER(BatchGetMaxInTriplet)
+
+    class BatchGetMinInTriplet : public Function {
+        ENABLE_SINGLETON(BatchGetMinInTriplet)
+        SIGNATURE(ADT_ARG(TripletArray), ADT_ARG(SequenceList))
+        SNAPSHOT_ARGS(1)
+    public:
+        Status invoke(const ArgBlock &args) override {
+            auto pArray = args.adt<TripletArray>(0);
+            auto pList = args.adt<SequenceList>(1);
+            if (pArray->e1 == nullptr) {
+                return DSCxx_ERROR;
+            }
+            if (ResizeSequenceList(pList, pArray->length) != DSCxx_OK) {
+                return DSCxx_ERROR;
+            }
+            TripletArrayMinKernel(pArray->e1, pArray->e2, pArray->e3, pArray->length, pList->elem);
+            return DSCxx_OK;
+        }
+    };
+    SINGLETON_MEMBER(BatchGetMinInTriplet)
+}
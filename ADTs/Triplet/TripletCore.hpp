@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace DataStructure_Cxx
+{
+    class Triplet : public ADTObject {
+    public:
+        ElemType* p = nullptr;
+        ADTObject* copy() override {
+            auto pastedObj = new Triplet;
+            pastedObj->p = p;
+            return pastedObj;
+        }
+        string str() override {
+            return "Triplet";
+        }
+        ADTObject* clone() override {
+            auto clonedObj = new Triplet;
+            if (p != nullptr) {
+                clonedObj->p = (ElemType*)std::malloc(3 * sizeof(ElemType));
+                if (!clonedObj->p) exit(DSCxx_OVERFLOW);
+                std::memcpy(clonedObj->p, p, 3 * sizeof(ElemType));
+            }
+            return clonedObj;
+        }
+        void release() override {
+            free(p);
+            p = nullptr;
+        }
+        void serialize(string& out) override {
+            putU8(out, p != nullptr);
+            if (p != nullptr) {
+                putI32Array(out, p, 3);
+            }
+        }
+        bool deserialize(BinaryReader& in) override {
+            if (in.getU8() == 0) return in.ok;
+            p = (ElemType*)std::malloc(3 * sizeof(ElemType));
+            if (!p) exit(DSCxx_OVERFLOW);
+            return in.getI32Array(p, 3);
+        }
+    };
+
+    // 以下为三元组的类型化接口，可以不经过 Interactor 直接调用（参见 DSCxx.hpp），Interactor 中的指令只是它们的包装
+    // 分量的序号从 1 开始，对未初始化的三元组操作时返回 DSCxx_ERROR
+
+    inline Status InitTriplet_T(Triplet& T, ElemType v1, ElemType v2, ElemType v3) {
+        ElemType values[3] = { v1, v2, v3 };
+        T.p = (ElemType*)std::malloc(3 * sizeof(ElemType));
+        if (!T.p) exit(DSCxx_OVERFLOW);
+        std::memcpy(T.p, values, 3 * sizeof(ElemType));
+        return DSCxx_OK;
+    }
+
+    inline Status DestroyTriplet_T(Triplet& T) {
+        if (T.p == nullptr) {
+            return DSCxx_ERROR;
+        }
+        free(T.p);
+        T.p = nullptr;
+        return DSCxx_OK;
+    }
+
+    inline Status Get_T(const Triplet& T, int i, ElemType& e) {
+        if (T.p == nullptr || i < 1 || i > 3) {
+            return DSCxx_ERROR;
+        }
+        e = T.p[i - 1];
+        return DSCxx_OK;
+    }
+
+    inline Status Put_T(Triplet& T, int i, ElemType e) {
+        if (T.p == nullptr || i < 1 || i > 3) {
+            return DSCxx_ERROR;
+        }
+        T.p[i - 1] = e;
+        return DSCxx_OK;
+    }
+
+    inline Status IsAscending_T(const Triplet& T) {
+        if (T.p == nullptr) {
+            return DSCxx_ERROR;
+        }
+        return (T.p[0] <= T.p[1] && T.p[1] <= T.p[2]) ? DSCxx_TRUE : DSCxx_FALSE;
+    }
+
+    inline Status IsDescending_T(const Triplet& T) {
+        if (T.p == nullptr) {
+            return DSCxx_ERROR;
+        }
+        return (T.p[0] >= T.p[1] && T.p[1] >= T.p[2]) ? DSCxx_TRUE : DSCxx_FALSE;
+    }
+
+    inline Status Max_T(const Triplet& T, ElemType& e) {
+        if (T.p == nullptr) {
+            return DSCxx_ERROR;
+        }
+        e = (T.p[0] >= T.p[1]) ?
+            (T.p[0] >= T.p[2]) ? T.p[0] : T.p[2] :
+            (T.p[1] >= T.p[2]) ? T.p[1] : T.p[2];
+        return DSCxx_OK;
+    }
+
+    inline Status Min_T(const Triplet& T, ElemType& e) {
+        if (T.p == nullptr) {
+            return DSCxx_ERROR;
+        }
+        e = (T.p[0] <= T.p[1]) ?
+            (T.p[0] <= T.p[2]) ? T.p[0] : T.p[2] :
+            (T.p[1] <= T.p[2]) ? T.p[1] : T.p[2];
+        return DSCxx_OK;
+    }
+}
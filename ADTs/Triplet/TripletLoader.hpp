@@ -18,18 +18,37 @@
 
 #include "Interactor.h"
 #include "Triplet.hpp"
+#include "TripletArray.hpp"
 
 using namespace DataStructure_Cxx;
 
+// 三元组的全部指令，由 ADTLoader.hpp 汇总到编译期生成的指令表中
+#define TRIPLET_INSTRUCTIONS \
+    LoadFunc(InitTriplet) \
+    LoadFunc(DestroyTriplet) \
+    LoadFunc(GetElemInTriplet) \
+    LoadFunc(PutElemIntoTriplet) \
+    LoadFunc(IsTripletAscending) \
+    LoadFunc(IsTripletDescending) \
+    LoadFunc(GetMaxInTriplet) \
+    LoadFunc(GetMinInTriplet) \
+    LoadFunc(InitTripletArray) \
+    LoadFunc(DestroyTripletArray) \
+    LoadFunc(TripletArrayLength) \
+    LoadFunc(TripletArrayAppend) \
+    LoadFunc(TripletArrayAppendTriplet) \
+    LoadFunc(GetElemInTripletArray) \
+    LoadFunc(PutElemIntoTripletArray) \
+    LoadFunc(BatchGetElemInTripletArray) \
+    LoadFunc(BatchPutElemIntoTripletArray) \
+    LoadFunc(BatchIsTripletAscending) \
+    LoadFunc(BatchIsTripletDescending) \
+    LoadFunc(BatchGetMaxInTriplet) \
+    LoadFunc(BatchGetMinInTriplet)
+
 void loadTriplet() {
     auto pTriplet = new Triplet;
     Interactor::instance()->addAdtType("Triplet", pTriplet);
-    LoadFunc(InitTriplet);
-    LoadFunc(DestroyTriplet);
-    LoadFunc(GetElemInTriplet);
-    LoadFunc(PutElemIntoTriplet);
-    LoadFunc(IsTripletAscending);
-    LoadFunc(IsTripletDescending);
-    LoadFunc(GetMaxInTriplet);
-    LoadFunc(GetMinInTriplet);
+    auto pTripletArray = new TripletArray;
+    Interactor::instance()->addAdtType("TripletArray", pTripletArray);
 }
\ No newline at end of file
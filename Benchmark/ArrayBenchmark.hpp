@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Benchmark.h"
+#include "Array/SparseMatrix.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace DataStructure_Cxx {
+    // 比较不同线程数下矩阵向量乘法的速度：n 行 n 列、每行约 16 个非零元的随机矩阵，线程数依次为 1、2、4……
+    // 直到硬件线程数，每种重复若干次取最短的耗时，输出每个非零元的平均耗时和相对单线程的加速比；
+    // 所有线程数的结果都相同时返回 true
+    inline bool SparseMatrixBenchmark(int n) {
+        const int Repeats = 5;
+        if (n > SPARSE_MATRIX_MAX_DIM) n = SPARSE_MATRIX_MAX_DIM;
+        BenchmarkRandom random;
+        SparseMatrix M;
+        M.reset(n, n);
+        for (int r = 0; r < n; ++r) {
+            for (int k = 0; k < 16; ++k) {
+                M.append(r, random.below(n), random.below(7) - 3);
+            }
+        }
+        if (M.compress() != DSCxx_OK) return false;
+        vector<ElemType> x((size_t) n);
+        for (auto &e : x) {
+            e = random.below(7) - 3;
+        }
+        cout << "Non-zeros: " << M.nonZeroCount() << '\n';
+        int hardware = max(1, min((int) thread::hardware_concurrency(), SPARSE_MATRIX_MAX_THREADS));
+        vector<int> threadCounts;
+        for (int t = 1; t < hardware; t *= 2) {
+            threadCounts.push_back(t);
+        }
+        threadCounts.push_back(hardware);
+        vector<ElemType> reference((size_t) n), y((size_t) n);
+        bool equal = true;
+        double single = 0;
+        for (size_t t = 0; t < threadCounts.size(); ++t) {
+            double best = 0;
+            for (int k = 0; k < Repeats; ++k) {
+                BenchmarkTimer timer;
+                if (MultSparseMatrixVector_RL(M, x.data(), y.data(), threadCounts[t]) != DSCxx_OK) return false;
+                double time = timer.lap();
+                best = (k == 0 || time < best) ? time : best;
+            }
+            if (t == 0) {
+                single = best;
+                reference.swap(y);
+            }
+            else {
+                equal &= y == reference;
+            }
+            cout << "Threads = " << threadCounts[t] << ": " << NanosPerOp(best, M.nonZeroCount()) << " ns/nnz, speedup "
+                 << (best > 0 ? single / best : 1.0) << "x\n";
+        }
+        return equal;
+    }
+}
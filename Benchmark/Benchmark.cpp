@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#include "Benchmark.h"
+#include "ArrayBenchmark.hpp"
+#include "GraphBenchmark.hpp"
+#include "InteractorBenchmark.hpp"
+#include "ListBenchmark.hpp"
+#include "ListStorageBenchmark.hpp"
+#include "QueueBenchmark.hpp"
+#include "SearchBenchmark.hpp"
+#include "StringBenchmark.hpp"
+#include "TripletBenchmark.hpp"
+
+using namespace DataStructure_Cxx;
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// 基准测试表：名称、默认规模、基准测试函数；新增基准测试时只需在这里加入一项
+struct BenchmarkEntry {
+    const char *name;
+    int defaultSize;
+    bool (*run)(int n);
+};
+
+static const BenchmarkEntry benchmarks[] = {
+    { "TripletArray", 1 << 22, TripletArrayBenchmark },
+    { "CompressedSequenceList", 1 << 20, CompressedSequenceListBenchmark },
+    { "PersistentVector", 1 << 20, PersistentVectorBenchmark },
+    { "SequenceListStorage", 1 << 25, SequenceListStorageBenchmark },
+    { "SkipList", 100000, SkipListBenchmark },
+    { "PriorityQueue", 1 << 20, PriorityQueueBenchmark },
+    { "SparseMatrix", 1 << 18, SparseMatrixBenchmark },
+    { "StringSearch", 1 << 24, StringSearchBenchmark },
+    { "CSRGraph", 1 << 20, CSRGraphBenchmark },
+    { "Interactor", 1 << 16, InteractorBenchmark },
+};
+
+// 用法：DSCxx_Benchmark [--size n] [name ...]
+// 不给出名称时依次运行全部基准测试；--size 以 n 代替每个基准测试的默认规模
+// 某个基准测试中各种实现的结果不一致时，退出状态为 EXIT_FAILURE
+int main(int argc, char** argv) {
+    int size = 0;
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "--size") == 0) {
+        size = atoi(argv[2]);
+        first = 3;
+    }
+    bool usage = size < 0;
+    for (int i = first; i < argc && !usage; ++i) {
+        usage = true;
+        for (auto &benchmark : benchmarks) {
+            if (strcmp(argv[i], benchmark.name) == 0) usage = false;
+        }
+    }
+    if (usage) {
+        cerr << "Usage: " << argv[0] << " [--size n] [name ...]\nBenchmarks:";
+        for (auto &benchmark : benchmarks) {
+            cerr << ' ' << benchmark.name;
+        }
+        cerr << endl;
+        return EXIT_FAILURE;
+    }
+    bool passed = true;
+    for (auto &benchmark : benchmarks) {
+        bool selected = first == argc;
+        for (int i = first; i < argc; ++i) {
+            if (strcmp(argv[i], benchmark.name) == 0) selected = true;
+        }
+        if (!selected) continue;
+        cout << "== " << benchmark.name << " ==\n";
+        bool equal = benchmark.run(size > 0 ? size : benchmark.defaultSize);
+        cout << (equal ? "Results match." : "Results DIFFER.") << '\n' << endl;
+        passed &= equal;
+    }
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+namespace DataStructure_Cxx {
+    // 基准测试共用的工具：每个基准测试是一个 bool (*)(int n) 函数，按规模 n 自行生成数据，
+    // 把各种实现的耗时写到标准输出，并核对各种实现的结果，全部一致时返回 true（参见 Benchmark.cpp 中的基准测试表）
+
+    // xorshift64*：种子固定，每次运行生成的数据完全相同，不同版本的测量结果可以直接比较
+    class BenchmarkRandom {
+    private:
+        uint64_t state;
+
+    public:
+        explicit BenchmarkRandom(uint64_t seed = 0x9e3779b97f4a7c15ULL) : state(seed) {}
+
+        uint64_t next() {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 0x2545f4914f6cdd1dULL;
+        }
+
+        // [0, bound) 中的整数
+        int below(int bound) {
+            return (int) ((next() >> 33) % (uint64_t) bound);
+        }
+    };
+
+    // 以秒为单位的计时器：lap 返回自构造或上一次 lap 以来经过的时间
+    class BenchmarkTimer {
+    private:
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+    public:
+        double lap() {
+            auto now = chrono::steady_clock::now();
+            double elapsed = chrono::duration<double>(now - start).count();
+            start = now;
+            return elapsed;
+        }
+    };
+
+    // 平均每个操作的纳秒数
+    inline double NanosPerOp(double seconds, double count) {
+        return seconds * 1e9 / (count > 0 ? count : 1);
+    }
+
+    // 让计时的循环的结果“被使用”，防止整个循环被优化掉：写入 volatile 变量的操作不能被省略
+    static volatile uint64_t BenchmarkSink;
+
+    inline void KeepResult(uint64_t value) {
+        BenchmarkSink = value;
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Benchmark.h"
+#include "Graph/CSRGraph.hpp"
+
+#include <vector>
+
+namespace DataStructure_Cxx {
+    // 在 n 个顶点、8n 条随机边的无向图上比较从顶点 0 出发的 BFS：单线程只自顶向下、单线程方向优化、
+    // 全部硬件线程方向优化，以及单线程、全部线程的连通分量，输出每种的耗时；
+    // 各种 BFS 的结果相同、两种连通分量的结果相同时返回 true
+    inline bool CSRGraphBenchmark(int n) {
+        const int VariantCount = 5;
+        const char *const VariantNames[VariantCount] = {
+            "BFS top-down, 1 thread", "BFS direction-optimizing, 1 thread", "BFS direction-optimizing, all threads",
+            "Components, 1 thread", "Components, all threads"
+        };
+        if (n > CSR_GRAPH_MAX_VERTICES / 16) n = CSR_GRAPH_MAX_VERTICES / 16;
+        BenchmarkRandom random;
+        int m = n * 8;
+        vector<ElemType> tails((size_t) m), heads((size_t) m);
+        for (int k = 0; k < m; ++k) {
+            tails[k] = random.below(n);
+            heads[k] = random.below(n);
+        }
+        CSRGraph G;
+        G.build(n, tails.data(), heads.data(), nullptr, m, false);
+        int hardware = CSRGraphThreads(0);
+        cout << "Vertices: " << n << ", arcs: " << G.arcCount() << ", hardware threads: " << hardware << '\n';
+        vector<ElemType> results[VariantCount];
+        for (int k = 0; k < VariantCount; ++k) {
+            results[k].resize((size_t) n);
+            BenchmarkTimer timer;
+            if (k < 3) {
+                CSRGraphBFS(G, 0, results[k].data(), k == 2 ? hardware : 1, k > 0);
+            }
+            else {
+                CSRGraphComponents(G, results[k].data(), k == 4 ? hardware : 1);
+            }
+            double elapsed = timer.lap();
+            cout << VariantNames[k] << ": " << elapsed * 1e3 << " ms (" << NanosPerOp(elapsed, G.arcCount()) << " ns/arc)\n";
+        }
+        return results[1] == results[0] && results[2] == results[0] && results[4] == results[3];
+    }
+}
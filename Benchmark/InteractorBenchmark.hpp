@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Benchmark.h"
+#include "Interactor.h"
+#include "ADTLoader.hpp"
+
+#include <string>
+#include <vector>
+
+namespace DataStructure_Cxx {
+    // 命令交互器的常见成功路径与常见错误路径的比较：先逐条测出每种命令的平均耗时，
+    // 再按 n 条命令执行“命中为主”（9 条成功、1 条失败）和“失败为主”（1 条成功、9 条失败）两种脚本；
+    // 错误路径不再抛出异常，两种脚本每条命令的耗时应当相近。成功的命令都成功、失败的命令都失败时返回 true
+    inline bool InteractorBenchmark(int n) {
+        struct Command {
+            const char *text;
+            bool succeeds;
+        };
+        const Command Hits[] = {
+            { "GetElemInSequenceList(L, 1, x)", true },
+            { "SequenceListLength(L)", true },
+            { "IsSequenceListEmpty(L)", true },
+            { "x = 7", true },
+        };
+        const Command Misses[] = {
+            { "SequenceListLength(NOPE)", false },              // ADT 不存在
+            { "GetElemInSequenceList(L, 1, nope)", false },     // 变量不存在
+            { "GetElemInSequenceList(L, abc, x)", false },      // 整数字面值格式错误
+            { "SequenceListLength(L, 1)", false },              // 参数个数错误
+            { "x = nope", false },                              // 赋值的来源既不是字面值也不是变量
+        };
+        if (n < 1) n = 1;
+        loadAllAdts();
+        auto interactor = Interactor::instance();
+        for (auto setup : { "set output quiet", "new SequenceList L", "new var x", "InitSequenceList(L)", "x = 5" }) {
+            interactor->dispatch(setup);
+        }
+        for (int i = 0; i < 64; ++i) {
+            interactor->dispatch("SequenceListInsert(L, 1, x)");
+        }
+
+        bool equal = true;
+        auto run = [&](const vector<Command> &script) {
+            BenchmarkTimer timer;
+            for (int i = 0; i < n; ++i) {
+                auto &command = script[i % script.size()];
+                bool failed = interactor->dispatch(command.text).kind == CommandOutcome::Failed;
+                equal &= failed != command.succeeds;
+            }
+            return NanosPerOp(timer.lap(), n);
+        };
+        for (auto &command : Hits) {
+            cout << "  " << command.text << ": " << run({ command }) << " ns/command\n";
+        }
+        for (auto &command : Misses) {
+            cout << "  " << command.text << ": " << run({ command }) << " ns/command (fails)\n";
+        }
+        // 两种脚本都以 10 条为一组循环，命中与失败的命令交替取自上面两个表
+        vector<Command> hitHeavy, missHeavy;
+        for (int i = 0; i < 10; ++i) {
+            hitHeavy.push_back((i == 9) ? Misses[i % 5] : Hits[i % 4]);
+            missHeavy.push_back((i == 9) ? Hits[i % 4] : Misses[i % 5]);
+        }
+        double hitHeavyTime = run(hitHeavy);
+        double missHeavyTime = run(missHeavy);
+        cout << "Commands: " << n << ", hit-heavy script: " << hitHeavyTime
+             << " ns/command, miss-heavy script: " << missHeavyTime << " ns/command\n";
+
+        for (auto cleanup : { "DestroySequenceList(L)", "delete adt L", "delete var x", "set output normal" }) {
+            interactor->dispatch(cleanup);
+        }
+        return equal;
+    }
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Benchmark.h"
+#include "List/CompressedSequenceList.hpp"
+#include "List/PersistentVector.hpp"
+#include "List/SequenceList.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+namespace DataStructure_Cxx {
+    // 与存放相同数据的线性表比较：分别用递增的序列（相邻元素之差很小）和 [0, 1024) 中的随机序列各 n 个元素，
+    // 输出两者的存储空间、压缩率以及顺序读取全部元素的速度；内容完全一致时返回 true
+    inline bool CompressedSequenceListBenchmark(int n) {
+        const char *const DataNames[] = { "ascending", "random below 1024" };
+        BenchmarkRandom random;
+        bool equal = true;
+        for (int d = 0; d < 2; ++d) {
+            CompressedSequenceList compressed;
+            compressed.initialized = true;
+            SequenceList list;
+            InitList_Sq(list);
+            ResizeSequenceList(&list, n);
+            ElemType value = 0;
+            for (int i = 0; i < n; ++i) {
+                value = (d == 0) ? value + random.below(16) : random.below(1024);
+                compressed.append(value);
+                list.elem[i] = value;
+            }
+            // 比较的是压缩块部分（尾部的元素两边都是原样存放），重复多遍使总量至少达到 2^24 个元素，计时才有意义
+            size_t blocked = compressed.blocks.size() * COMPRESSED_BLOCK_SIZE;
+            int rounds = (blocked > 0 && blocked < (1u << 24)) ? (int) ((1u << 24) / blocked) : 1;
+            ElemType values[COMPRESSED_BLOCK_SIZE];
+            equal &= memcmp(compressed.tail, list.elem + blocked, compressed.tailLength * sizeof(ElemType)) == 0;
+            uint32_t checksum = 0;
+            BenchmarkTimer timer;
+            for (int r = 0; r < rounds; ++r) {
+                for (size_t b = 0; b < compressed.blocks.size(); ++b) {
+                    DecodeCompressedBlock(compressed.blocks[b], compressed.data.data(), values);
+                    if (r == 0) {
+                        equal &= memcmp(values, list.elem + b * COMPRESSED_BLOCK_SIZE, sizeof(values)) == 0;
+                    }
+                    for (int k = 0; k < COMPRESSED_BLOCK_SIZE; ++k) {
+                        checksum += (uint32_t) values[k];
+                    }
+                }
+            }
+            double decodeTime = timer.lap();
+            for (int r = 0; r < rounds; ++r) {
+                for (size_t i = 0; i < blocked; ++i) {
+                    checksum -= (uint32_t) list.elem[i];
+                }
+            }
+            double scanTime = timer.lap();
+            KeepResult(checksum);
+            double total = (double) blocked * rounds;
+            size_t compressedBytes = compressed.storageBytes();
+            size_t plainBytes = (size_t) n * sizeof(ElemType);
+            cout << "Elements: " << n << " (" << DataNames[d] << "), compressed: " << compressedBytes << " bytes ("
+                 << (n > 0 ? compressedBytes * 8.0 / n : 0) << " bits/elem), SequenceList: " << plainBytes
+                 << " bytes, ratio: " << (compressedBytes > 0 ? (double) plainBytes / compressedBytes : 0) << ":1\n";
+            cout << "Decode: " << (decodeTime > 0 ? total / decodeTime / 1e6 : 0) << " M elem/s, SequenceList scan: "
+                 << (scanTime > 0 ? total / scanTime / 1e6 : 0) << " M elem/s\n";
+            DestroyList_Sq(list);
+        }
+        return equal;
+    }
+
+    // 与每个版本都保存一份完整的 SequenceList 相比较：n 个元素的向量每修改 16 个随机位置保存一个版本，共 64 个版本，
+    // 存储空间为所有版本实际引用的结点总量，以及同样多的版本各复制一份线性表所需的空间；
+    // 更新代价为"保存快照 + 修改一个随机位置的元素"的平均耗时，以及"复制整个线性表 + 修改"的平均耗时；
+    // 两种做法最后得到的内容相同时返回 true
+    inline bool PersistentVectorBenchmark(int n) {
+        if (n < 1) n = 1;
+        BenchmarkRandom random;
+        PersistentVector persistent;
+        persistent.head.root = new PersistentVectorBranch;
+        for (int i = 0; i < n; ++i) {
+            persistent.head.push(i);
+        }
+        for (int v = 0; v < 64; ++v) {
+            persistent.head.retain();
+            persistent.versions.push_back(persistent.head);
+            for (int k = 0; k < 16; ++k) {
+                persistent.head.set(random.below(n), k);
+            }
+        }
+        unordered_set<PersistentVectorNode *> leaves, branches;
+        persistent.collectNodes(leaves, branches);
+        size_t sharedBytes = leaves.size() * sizeof(PersistentVectorLeaf) + branches.size() * sizeof(PersistentVectorBranch);
+        size_t copiedBytes = (persistent.versions.size() + 1) * (size_t) n * sizeof(ElemType);
+        cout << "Versions: " << persistent.versions.size() + 1 << ", shared nodes: " << sharedBytes
+             << " bytes, full SequenceList copies: " << copiedBytes << " bytes, ratio: "
+             << (sharedBytes > 0 ? (double) copiedBytes / sharedBytes : 0) << ":1\n";
+
+        // 两种做法修改相同的位置序列；复制整个线性表的代价与长度成正比，长度很大时减少轮数，避免耗时过长
+        const int rounds = 1000;
+        int copyRounds = (int) ((size_t(1) << 26) / ((size_t) n * sizeof(ElemType)));
+        copyRounds = (copyRounds < 1) ? 1 : (copyRounds > rounds ? rounds : copyRounds);
+        BenchmarkRandom persistentIndex(n), copyIndex(n);
+        PersistentVectorVersion scratch = persistent.head;
+        scratch.retain();
+        vector<PersistentVectorVersion> snapshots;
+        snapshots.reserve(rounds);
+        BenchmarkTimer timer;
+        for (int r = 0; r < rounds; ++r) {
+            scratch.retain();
+            snapshots.push_back(scratch);
+            scratch.set(persistentIndex.below(n), r);
+        }
+        double persistentUpdate = timer.lap() / rounds;
+
+        auto plain = (ElemType *) malloc((size_t) n * sizeof(ElemType));
+        if (!plain) exit(DSCxx_OVERFLOW);
+        for (int i = 0; i < n; ++i) {
+            plain[i] = persistent.head.at(i);
+        }
+        timer.lap();
+        for (int r = 0; r < copyRounds; ++r) {
+            auto copied = (ElemType *) malloc((size_t) n * sizeof(ElemType));
+            if (!copied) exit(DSCxx_OVERFLOW);
+            memcpy(copied, plain, (size_t) n * sizeof(ElemType));
+            copied[copyIndex.below(n)] = r;
+            free(plain);
+            plain = copied;
+        }
+        double copyUpdate = timer.lap() / copyRounds;
+        cout << "Snapshot + update: " << persistentUpdate * 1e9 << " ns/op, SequenceList copy + update: "
+             << copyUpdate * 1e9 << " ns/op\n";
+
+        // 第 copyRounds 个快照之前恰好做了 copyRounds 次修改，应与复制的线性表相同
+        auto &same = (copyRounds < rounds) ? snapshots[copyRounds] : scratch;
+        bool equal = true;
+        for (int i = 0; i < n; ++i) {
+            equal &= same.at(i) == plain[i];
+        }
+        free(plain);
+        for (auto &snapshot : snapshots) {
+            snapshot.release();
+        }
+        scratch.release();
+        return equal;
+    }
+}
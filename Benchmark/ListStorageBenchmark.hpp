@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Benchmark.h"
+#include "List/SequenceList.hpp"
+
+#include <sys/resource.h>
+
+namespace DataStructure_Cxx {
+    // 进程到目前为止的缺页次数（不需要读磁盘的次要缺页），用来粗略反映大页是否生效
+    inline long BenchmarkMinorFaults() {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_minflt;
+    }
+
+    // 堆上的存储与映射存储（参见 ListStorage.hpp）的比较：分别逐个在尾部插入 n 个元素建立线性表，
+    // 顺序读取全部元素，再截去后一半的元素并缩减容量；输出各阶段的耗时、建立时的缺页次数以及缩减前后的容量
+    // （TLB 缺失需要用 perf 等工具另行测量），两种存储的内容相同时返回 true
+    inline bool SequenceListStorageBenchmark(int n) {
+        if (n < 1) n = 1;
+        const char *const StorageNames[2] = { "heap", "mapped" };
+        uint64_t checksums[2] = { 0, 0 };
+        for (int s = 0; s < 2; ++s) {
+            SequenceList list;
+            if (s == 1 && MapList_Sq(list) != DSCxx_OK) {
+                cout << "Mapped storage is not supported on this platform\n";
+                return true;
+            }
+            long faults = BenchmarkMinorFaults();
+            BenchmarkTimer timer;
+            InitList_Sq(list);
+            for (int i = 0; i < n; ++i) {
+                ListInsert_Sq(list, list.length + 1, i);
+            }
+            double buildTime = timer.lap();
+            long buildFaults = BenchmarkMinorFaults() - faults;
+            uint64_t checksum = 0;
+            for (int i = 0; i < list.length; ++i) {
+                checksum = checksum * 31 + (uint64_t) list.elem[i];
+            }
+            double scanTime = timer.lap();
+            int capacity = list.listsize;
+            list.length /= 2;
+            ShrinkList_Sq(list);
+            double shrinkTime = timer.lap();
+            checksums[s] = checksum + (uint64_t) list.length;
+            cout << StorageNames[s] << ": build " << NanosPerOp(buildTime, n) << " ns/elem (" << buildFaults
+                 << " page faults), scan " << NanosPerOp(scanTime, n) << " ns/elem, capacity "
+                 << (size_t) capacity * sizeof(ElemType) << " -> " << (size_t) list.listsize * sizeof(ElemType)
+                 << " bytes after deleting half (" << shrinkTime * 1e3 << " ms)\n";
+            DestroyList_Sq(list);
+        }
+        return checksums[0] == checksums[1];
+    }
+}
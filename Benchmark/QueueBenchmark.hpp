@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Benchmark.h"
+#include "Queue/PriorityQueue.hpp"
+
+#include <vector>
+
+namespace DataStructure_Cxx {
+    // 比较 2、4、8 叉堆：由 n 个随机元素建堆、再逐个出队，以及逐个入队，输出每种操作的耗时
+    // 所有的 d 都得到相同的出队序列时返回 true
+    inline bool PriorityQueueBenchmark(int n) {
+        const int Arities[] = { 2, 4, 8 };
+        BenchmarkRandom random;
+        vector<ElemType> elems((size_t) n);
+        for (auto &e : elems) {
+            e = random.below(n);
+        }
+        cout << "Elements: " << n << '\n';
+        bool equal = true;
+        uint32_t reference = 0;
+        for (int arity : Arities) {
+            PriorityQueue heap;
+            heap.arity = arity;
+            BenchmarkTimer timer;
+            heap.heapify(elems.data(), n);
+            double heapifyTime = timer.lap();
+            // 出队序列的校验和：各个 d 都应该相同
+            uint32_t checksum = 0;
+            for (int i = 0; i < n; ++i) {
+                checksum = checksum * 31 + (uint32_t) heap.pop();
+            }
+            double popTime = timer.lap();
+            for (int i = 0; i < n; ++i) {
+                heap.push(elems[i]);
+            }
+            double pushTime = timer.lap();
+            if (arity == Arities[0]) reference = checksum;
+            equal &= checksum == reference;
+            cout << "d = " << arity << ": heapify " << NanosPerOp(heapifyTime, n) << " ns/elem, pop "
+                 << NanosPerOp(popTime, n) << " ns/op, push " << NanosPerOp(pushTime, n) << " ns/op\n";
+        }
+        return equal;
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Benchmark.h"
+#include "List/SortedSequenceList.hpp"
+#include "Search/SkipList.hpp"
+
+#include <vector>
+
+namespace DataStructure_Cxx {
+    // 跳表与有序线性表（二分查找 + 移动元素）的比较：规模依次为 n / 100、n / 10、n，
+    // 分别随机插入 size 个元素（重复的只保留一个）、查找 size 次（约一半命中）、求 size 次秩，再按插入的顺序全部删除，
+    // 输出每种操作的平均耗时；两者的查找、求秩结果以及插入之后的元素序列都相同时返回 true
+    inline bool SkipListBenchmark(int n) {
+        bool equal = true;
+        for (int size : { n / 100, n / 10, n }) {
+            if (size < 1) continue;
+            BenchmarkRandom random;
+            vector<ElemType> keys((size_t) size), probes((size_t) size);
+            for (int i = 0; i < size; ++i) {
+                keys[i] = random.below(size) * 2;   // 只取偶数，奇数的查找一定不命中
+                probes[i] = random.below(size * 2);
+            }
+            double skipTime[4], sortedTime[4];
+            uint64_t skipChecksum = 0, sortedChecksum = 0;
+
+            SkipList skipList;
+            InitSkipList::instance()->invoke({ &skipList, 1 });
+            BenchmarkTimer timer;
+            for (auto key : keys) {
+                skipList.insert(key);
+            }
+            skipTime[0] = timer.lap();
+            for (auto key : probes) {
+                skipChecksum += skipList.contains(key);
+            }
+            skipTime[1] = timer.lap();
+            for (auto key : probes) {
+                skipChecksum = skipChecksum * 31 + (uint64_t) skipList.rankOf(key);
+            }
+            skipTime[2] = timer.lap();
+            vector<ElemType> skipElems;
+            skipElems.reserve((size_t) skipList.length);
+            for (auto x = skipList.head->links[0].next; x != nullptr; x = x->links[0].next) {
+                skipElems.push_back(x->key);
+            }
+            timer.lap();
+            for (auto key : keys) {
+                skipList.erase(key);
+            }
+            skipTime[3] = timer.lap();
+            equal &= skipList.length == 0;
+            skipList.release();
+
+            // 有序线性表的元素不重复，与跳表的集合语义相同
+            SortedSequenceList sorted;
+            InitList_Sq(sorted);
+            timer.lap();
+            for (auto key : keys) {
+                int index = SortedBound<false>(sorted.elem, sorted.length, key);
+                if (index == sorted.length || sorted.elem[index] != key) {
+                    InsertSortedElem(&sorted, key);
+                }
+            }
+            sortedTime[0] = timer.lap();
+            for (auto key : probes) {
+                int index = SortedBound<false>(sorted.elem, sorted.length, key);
+                sortedChecksum += index < sorted.length && sorted.elem[index] == key;
+            }
+            sortedTime[1] = timer.lap();
+            for (auto key : probes) {
+                int index = SortedBound<false>(sorted.elem, sorted.length, key);
+                int rank = (index < sorted.length && sorted.elem[index] == key) ? index + 1 : 0;
+                sortedChecksum = sortedChecksum * 31 + (uint64_t) rank;
+            }
+            sortedTime[2] = timer.lap();
+            equal &= vector<ElemType>(sorted.elem, sorted.elem + sorted.length) == skipElems;
+            timer.lap();
+            ElemType e;
+            for (auto key : keys) {
+                int index = SortedBound<false>(sorted.elem, sorted.length, key);
+                if (index < sorted.length && sorted.elem[index] == key) {
+                    ListDelete_Sq(sorted, index + 1, e);
+                }
+            }
+            sortedTime[3] = timer.lap();
+            equal &= sorted.length == 0;
+            DestroyList_Sq(sorted);
+            equal &= skipChecksum == sortedChecksum;
+
+            const char *const OperationNames[4] = { "insert", "search", "rank", "delete" };
+            cout << "Size " << size << ":\n";
+            for (int k = 0; k < 4; ++k) {
+                cout << "  " << OperationNames[k] << ": skip list " << NanosPerOp(skipTime[k], size)
+                     << " ns/op, SequenceList " << NanosPerOp(sortedTime[k], size) << " ns/op\n";
+            }
+        }
+        return equal;
+    }
+}
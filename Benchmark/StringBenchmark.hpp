@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Benchmark.h"
+#include "String/StringSearch.hpp"
+
+#include <string>
+
+namespace DataStructure_Cxx {
+    // 比较各个查找算法：在 n 字节的随机文本（小写字母）中分别用 Naive、KMP、Two-Way、SIMD 过滤
+    // 找出长度为 1、4、16、64 的模式串出现的所有位置，模式串取自文本，保证至少出现一次；
+    // 输出每种算法的耗时（每字节的纳秒数）以及按模式串长度自动选择的算法，所有算法找到的位置都相同时返回 true
+    inline bool StringSearchBenchmark(int n) {
+        const int PatternLengths[] = { 1, 4, 16, 64 };
+        BenchmarkRandom random;
+        string text((size_t) n, 'a');
+        for (auto &c : text) {
+            c = (char) ('a' + random.below(26));
+        }
+        bool equal = true;
+        for (int m : PatternLengths) {
+            if (m > n) break;
+            string pattern = text.substr((size_t) random.below(n - m + 1), (size_t) m);
+            uint32_t reference = 0;
+            int matches = 0;
+            cout << "Text: " << n << " bytes, pattern: " << m << " bytes\n";
+            for (int e = 0; e < StringSearcher::EngineCount; ++e) {
+                BenchmarkTimer timer;
+                StringSearcher searcher(pattern.data(), m, (StringSearcher::Engine) e);
+                // 出现位置的校验和：各个算法都应该相同
+                uint32_t checksum = 0;
+                int count = 0;
+                int i = searcher.find(text.data(), n, 0);
+                while (i >= 0) {
+                    ++count;
+                    checksum = checksum * 31 + (uint32_t) i;
+                    i = searcher.find(text.data(), n, i + 1);
+                }
+                double elapsed = timer.lap();
+                if (e == 0) {
+                    reference = checksum;
+                    matches = count;
+                }
+                equal &= checksum == reference && count == matches;
+                cout << "  " << StringSearcher::EngineName((StringSearcher::Engine) e) << ": "
+                     << NanosPerOp(elapsed, n) << " ns/byte\n";
+            }
+            cout << "  Matches: " << matches << ", chosen by pattern length: "
+                 << StringSearcher::EngineName(StringSearcher::Choose(m)) << '\n';
+        }
+        return equal;
+    }
+}
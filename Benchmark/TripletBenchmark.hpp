@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Benchmark.h"
+#include "Triplet/Triplet.hpp"
+#include "Triplet/TripletArray.hpp"
+
+#include <vector>
+
+namespace DataStructure_Cxx {
+    // 与 n 个独立的 Triplet 对象比较：分量取 [0, 1024) 中的随机数，
+    // Triplet 逐个调用 IsTripletAscending、IsTripletDescending、GetMaxInTriplet、GetMinInTriplet 指令，
+    // TripletArray 用批量指令的计算核心一次处理全部三元组；输出每个三元组的平均耗时，两者的结果都相同时返回 true
+    inline bool TripletArrayBenchmark(int n) {
+        if (n < 1) n = 1;
+        BenchmarkRandom random;
+        vector<Triplet> triplets((size_t) n);
+        TripletArray array;
+        InitTripletArray::instance()->invoke({ &array });
+        array.reserve(n);
+        for (int k = 0; k < n; ++k) {
+            ElemType v1 = random.below(1024), v2 = random.below(1024), v3 = random.below(1024);
+            InitTriplet_T(triplets[k], v1, v2, v3);
+            array.e1[k] = v1;
+            array.e2[k] = v2;
+            array.e3[k] = v3;
+        }
+        array.length = n;
+
+        const char *const OperationNames[4] = { "ascending", "descending", "max", "min" };
+        double tripletTime[4], arrayTime[4];
+        vector<uint32_t> tripletBitmap((size_t) (n + 31) / 32), arrayBitmap((size_t) (n + 31) / 32);
+        vector<ElemType> tripletValues((size_t) n), arrayValues((size_t) n);
+        bool equal = true;
+        for (int op = 0; op < 4; ++op) {
+            BenchmarkTimer timer;
+            if (op < 2) {
+                auto function = (op == 0) ? (Function *) IsTripletAscending::instance() : IsTripletDescending::instance();
+                fill(tripletBitmap.begin(), tripletBitmap.end(), 0u);
+                for (int k = 0; k < n; ++k) {
+                    uint32_t bit = function->invoke({ &triplets[k] }) == DSCxx_TRUE;
+                    tripletBitmap[k / 32] |= bit << (k % 32);
+                }
+            }
+            else {
+                auto function = (op == 2) ? (Function *) GetMaxInTriplet::instance() : GetMinInTriplet::instance();
+                for (int k = 0; k < n; ++k) {
+                    function->invoke({ &triplets[k], &tripletValues[k] });
+                }
+            }
+            tripletTime[op] = timer.lap();
+            if (op < 2) {
+                TripletArrayOrderKernel(array.e1, array.e2, array.e3, n, arrayBitmap.data(), op == 0);
+            }
+            else if (op == 2) {
+                TripletArrayMaxKernel(array.e1, array.e2, array.e3, n, arrayValues.data());
+            }
+            else {
+                TripletArrayMinKernel(array.e1, array.e2, array.e3, n, arrayValues.data());
+            }
+            arrayTime[op] = timer.lap();
+            equal &= (op < 2) ? tripletBitmap == arrayBitmap : tripletValues == arrayValues;
+        }
+
+        cout << "Triplets: " << n << ", Triplet objects: " << (size_t) n * (sizeof(Triplet) + 3 * sizeof(ElemType))
+             << " bytes, TripletArray: " << (size_t) array.arraysize * 3 * sizeof(ElemType) << " bytes\n";
+        for (int op = 0; op < 4; ++op) {
+            cout << "  " << OperationNames[op] << ": Triplet " << NanosPerOp(tripletTime[op], n)
+                 << " ns/triplet, TripletArray " << NanosPerOp(arrayTime[op], n) << " ns/triplet\n";
+        }
+        for (auto &triplet : triplets) {
+            DestroyTriplet_T(triplet);
+        }
+        array.release();
+        return equal;
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+using namespace std;
+
+namespace DataStructure_Cxx {
+
+    // 紧凑的二进制编码（小端序），用于预写日志的记录和检查点快照
+    // 写入时直接追加到 string 的末尾；读取时 BinaryReader 在数据不足时置 ok 为 false，之后的读取都返回 0
+
+    inline void putU8(string& out, uint8_t v) {
+        out.push_back((char)v);
+    }
+
+    inline void putU32(string& out, uint32_t v) {
+        char bytes[4] = { (char)v, (char)(v >> 8), (char)(v >> 16), (char)(v >> 24) };
+        out.append(bytes, 4);
+    }
+
+    inline void putI32(string& out, int32_t v) {
+        putU32(out, (uint32_t)v);
+    }
+
+    inline void putU64(string& out, uint64_t v) {
+        putU32(out, (uint32_t)v);
+        putU32(out, (uint32_t)(v >> 32));
+    }
+
+    // 字符串：长度（32 位）+ 内容
+    inline void putString(string& out, const string& str) {
+        putU32(out, (uint32_t)str.size());
+        out.append(str);
+    }
+
+    inline void putI32Array(string& out, const int32_t* values, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            putI32(out, values[i]);
+        }
+    }
+
+    struct BinaryReader {
+        const char* p;
+        const char* end;
+        bool ok = true;
+
+        BinaryReader(const char* data, size_t size) : p(data), end(data + size) {}
+
+        bool require(size_t n) {
+            if (!ok || (size_t)(end - p) < n) {
+                ok = false;
+                return false;
+            }
+            return true;
+        }
+
+        uint8_t getU8() {
+            if (!require(1)) return 0;
+            return (uint8_t)*p++;
+        }
+
+        uint32_t getU32() {
+            if (!require(4)) return 0;
+            auto b = (const unsigned char*)p;
+            p += 4;
+            return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+        }
+
+        int32_t getI32() {
+            return (int32_t)getU32();
+        }
+
+        uint64_t getU64() {
+            uint64_t low = getU32();
+            return low | ((uint64_t)getU32() << 32);
+        }
+
+        string getString() {
+            uint32_t size = getU32();
+            if (!require(size)) return string();
+            string str(p, size);
+            p += size;
+            return str;
+        }
+
+        bool getI32Array(int32_t* values, size_t count) {
+            if (!require(count * 4)) return false;
+            for (size_t i = 0; i < count; ++i) {
+                values[i] = getI32();
+            }
+            return true;
+        }
+    };
+}
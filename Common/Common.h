@@ -16,11 +16,22 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
 #include <exception>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "BinaryIO.h"
+#include "ExecutionTracer.h"
+#include "OutputSink.h"
+
 using namespace std;
 
 namespace DataStructure_Cxx {
@@ -43,9 +54,25 @@ namespace DataStructure_Cxx {
     ((STATUS) == 1 ? "TRUE/OK (value: 1)" : (STATUS) == 0 ? "FALSE/ERROR (value: 0)" : \
     (STATUS) == -1 ? "INFEASIBLE (value: -1)" : (STATUS) == -2 ? "OVERFLOW (value: -2)" : to_string(STATUS))
 
+    class UnimplementedException : public exception {
+    public:
+        const char * what() const noexcept override {
+            return "Virtual function unimplemented";
+        }
+    };
+
     // 所有数据结构类都应该继承 ADTObject 并重写 copy、str 功能
+    // 如果希望该数据结构能够参与事务（begin/commit/rollback），还需要重写 clone、release 功能
+    // 如果希望该数据结构能够写入检查点快照（参见 WriteAheadLog），还需要重写 serialize、deserialize 功能
     class ADTObject {
     public:
+        // 访问锁：指令执行期间持有参数中所有 ADT 的锁，防止后台任务与其他命令同时修改同一个 ADT
+        mutex accessLock;
+        // 引用计数：被尚未结束的后台任务引用的 ADT 不能被删除
+        atomic<int> pinCount{0};
+
+        virtual ~ADTObject() = default;
+
         virtual ADTObject* copy() {
             auto pastedObj = new ADTObject;
             return pastedObj;
@@ -54,12 +81,31 @@ namespace DataStructure_Cxx {
         virtual string str() {
             return "ADTObject";
         }
-    };
 
-    class UnimplementedException : public exception {
-    public:
-        const char * what() const noexcept override {
-            return "Virtual function unimplemented";
+        // 深拷贝：与 copy 不同，产生的对象拥有独立的存储空间，事务用它保存修改之前的快照
+        virtual ADTObject* clone() {
+            throw UnimplementedException();
+        }
+
+        // 释放对象持有的存储空间（不释放对象本身），用于丢弃快照或者撤销修改
+        virtual void release() {
+            throw UnimplementedException();
+        }
+
+        // 将对象的完整内容编码到 out 的末尾
+        virtual void serialize(string& out) {
+            throw UnimplementedException();
+        }
+
+        // 从 in 中恢复 serialize 写入的内容（对象是刚由样本复制出来的空对象），数据有误时返回 false
+        virtual bool deserialize(BinaryReader& in) {
+            throw UnimplementedException();
+        }
+
+        // 本对象引用的其他 ADT（例如视图引用的线性表），没有则返回 nullptr，name 为被引用 ADT 的名称
+        // 指令执行时会同时对被引用的 ADT 加锁，后台任务也会同时引用（pin）它；只在持有 registryMutex 时调用
+        virtual ADTObject* dependency(string& name) {
+            return nullptr;
         }
     };
 
@@ -75,24 +121,281 @@ namespace DataStructure_Cxx {
             return m_instance; \
        }
 
-#define CHECK_ARG_COUNT(arg_count) \
-    if (args.size() != arg_count) {        \
-        throw InstructionInvalidArgumentCountException(arg_count, args.size()); \
+    // 后台任务的取消标记，耗时较长的指令应该每处理完一块数据（CANCELLATION_CHUNK_SIZE 个元素）检查一次
+    class CancellationToken {
+    public:
+        static atomic<bool>*& current() {
+            static thread_local atomic<bool>* token = nullptr;
+            return token;
+        }
+
+        static bool requested() {
+            auto token = current();
+            return token != nullptr && token->load(memory_order_relaxed);
+        }
+    };
+
+#define CANCELLATION_CHUNK_SIZE 4096
+
+    // 指令执行中的常见错误（参数个数不对、参数格式不对、ADT/变量不存在等）不通过异常报告，
+    // 而是记录在当前线程的 InvokeError 中，指令随即返回 DSCxx_ERROR，由 Interactor 在指令返回后检查，
+    // 这样失败时不需要栈展开，开销与成功时相当
+    class InvokeError {
+    public:
+        enum Code {
+            None,
+            InvalidArgumentCount,
+            InvalidArgument,
+            ADTNotFound,
+            ADTTypeMismatch,
+            VariableNotFound,
+            InstructionNotFound,
+            InvalidFormat,
+            VariableBusy
+        };
+
+        Code code = None;
+        string subject;     // 出错的参数、名称等（复用同一个 string 的存储空间，通常不会再分配内存）
+        string detail;      // 补充信息，例如类型不符时期望的 ADT 类型
+        size_t need = 0;
+        size_t given = 0;
+
+        static InvokeError& current() {
+            static thread_local InvokeError error;
+            return error;
+        }
+
+        static bool pending() {
+            return current().code != None;
+        }
+
+        static void clear() {
+            current().code = None;
+        }
+
+        // 只记录第一个错误：嵌套调用时最内层的错误才是真正的原因
+        static Status raise(Code code, const string& subject = "", const string& detail = "") {
+            auto& error = current();
+            if (error.code == None) {
+                error.code = code;
+                error.subject.assign(subject);
+                error.detail.assign(detail);
+            }
+            return DSCxx_ERROR;
+        }
+
+        static Status raise(Code code, size_t need, size_t given) {
+            auto& error = current();
+            if (error.code == None) {
+                error.code = code;
+                error.need = need;
+                error.given = given;
+            }
+            return DSCxx_ERROR;
+        }
+
+        // 生成与对应异常相同的错误信息，只在需要报告时才调用（定义在 Interactor.cpp 中）
+        string message() const;
+    };
+
+    // 不抛出异常的整数解析：整个字符串必须是合法的十进制整数，且不能超出 ElemType 的范围
+    inline bool parseElem(const string& str, ElemType& value) {
+        if (str.empty()) return false;
+        char* end = nullptr;
+        errno = 0;
+        long result = strtol(str.c_str(), &end, 10);
+        if (*end != '\0' || errno == ERANGE || result < INT_MIN || result > INT_MAX) {
+            return false;
+        }
+        value = (ElemType)result;
+        return true;
+    }
+
+    // 解析串常量参数：用双引号括起时去掉引号并处理 \" 和 \\ 两种转义，否则原样作为文本（例如 hello）
+    inline bool parseText(const string& str, string& text) {
+        if (str.empty() || str[0] != '"') {
+            text = str;
+            return true;
+        }
+        if (str.size() < 2 || str.back() != '"') return false;
+        text.clear();
+        for (size_t i = 1; i + 1 < str.size(); ++i) {
+            if (str[i] == '\\') {
+                if (++i + 1 >= str.size() || (str[i] != '"' && str[i] != '\\')) return false;
+            }
+            else if (str[i] == '"') {
+                return false;
+            }
+            text += str[i];
+        }
+        return true;
     }
 
+    // 每种 ADT 在注册时（Interactor::addAdtType）分配到一个类型编号，用于在查找时检查类型
+    template<typename T>
+    struct ADTTypeId {
+        static uint32_t value;
+    };
+    template<typename T>
+    uint32_t ADTTypeId<T>::value = UINT32_MAX;
+
+    // 指令参数的声明：ADT（以及它的类型）、整数字面值、变量、名称或者串常量
+    // ADT 的类型编号在注册时才分配，所以这里保存的是编号的地址
+    // acceptDerived 为 true 时也接受注册为该类型派生类型的 ADT（例如接受 SequenceList 的只读指令也接受 SortedSequenceList）
+    struct ArgSpec {
+        enum Kind : uint8_t { ADT, Int, Variable, Name, Text };
+        Kind kind;
+        const uint32_t* adtType;
+        bool acceptDerived;
+    };
+
+    struct ArgSignature {
+        const ArgSpec* specs;
+        size_t count;
+    };
+
+#define ADT_ARG(adt_type) ArgSpec{ ArgSpec::ADT, &ADTTypeId<adt_type>::value, false }
+#define ADT_FAMILY_ARG(adt_type) ArgSpec{ ArgSpec::ADT, &ADTTypeId<adt_type>::value, true }
+#define INT_ARG ArgSpec{ ArgSpec::Int, nullptr, false }
+#define VAR_ARG ArgSpec{ ArgSpec::Variable, nullptr, false }
+// 原样传入的名称（例如共享内存区域的名称），不查找 ADT 或变量
+#define NAME_ARG ArgSpec{ ArgSpec::Name, nullptr, false }
+// 串常量，可以用双引号括起包含空格和标点的文本，例如 "hello, world"（参见 parseText）
+#define TEXT_ARG ArgSpec{ ArgSpec::Text, nullptr, false }
+
+    // 在指令类中声明参数签名，例如 SIGNATURE(ADT_ARG(SequenceList), INT_ARG, VAR_ARG)
+    // 签名在加载指令表时检查，参数在调用前按签名一次性解码，指令本身不再解析字符串
+#define SIGNATURE(...) \
+    public: \
+        static ArgSignature argSignature() { \
+            static constexpr ArgSpec specs[] = { __VA_ARGS__ }; \
+            return ArgSignature{ specs, sizeof(specs) / sizeof(ArgSpec) }; \
+        } \
+        ArgSignature signature() const override { \
+            return argSignature(); \
+        }
+
+    // 标记只读的指令（不修改任何 ADT 和变量）：事务不为其参数保存快照，预写日志也不记录它
+#define READ_ONLY_INSTRUCTION \
+    public: \
+        bool readOnly() const override { \
+            return true; \
+        }
+
+    // 只修改变量、不修改任何 ADT 的指令（例如 GetElem）：批处理只保存变量的旧值，不为 ADT 参数保存快照
+#define VARIABLE_ONLY_INSTRUCTION \
+    public: \
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override { \
+            return true; \
+        }
+
+    // 只整体改写部分 ADT 参数的指令（例如把结果写入线性表）：批处理只为列出的参数保存快照，例如 SNAPSHOT_ARGS(2)
+#define SNAPSHOT_ARGS(...) \
+    public: \
+        bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const override { \
+            for (size_t arg : { __VA_ARGS__ }) steps.push_back({ arg, nullptr }); \
+            return true; \
+        }
+
+    // 修改 ADT 的指令中，返回值是计数、TRUE/FALSE 之类的结果而不是 OK/ERROR 的（例如 SkipListInsert）：
+    // 批处理只把负的状态（INFEASIBLE、OVERFLOW）视为执行失败
+#define VALUE_STATUS_INSTRUCTION \
+    public: \
+        bool failed(Status status) const override { \
+            return status < 0; \
+        }
+
+#define MAX_INSTRUCTION_ARGS 8
+
+    // 按签名解码之后的参数块：每个参数按声明分别是 ADT 对象、整数或者变量的地址
+    // 指令之间的内部调用直接构造参数块，例如 GetElemInSequenceList::instance()->invoke({pList, i, &e})
+    class ArgBlock {
+    private:
+        union Arg {
+            ADTObject* adt;
+            ElemType value;
+            ElemType* var;
+            const string* name;
+        };
+        Arg items[MAX_INSTRUCTION_ARGS];
+        size_t argCount = 0;
+
+    public:
+        ArgBlock() = default;
+
+        template<typename T, typename... Rest>
+        ArgBlock(T first, Rest... rest) {
+            push(first);
+            int expand[] = { 0, (push(rest), 0)... };
+            (void)expand;
+        }
+
+        size_t size() const { return argCount; }
+        void resize(size_t n) { argCount = n; }
+
+        void push(ADTObject* adt) { items[argCount++].adt = adt; }
+        void push(ElemType value) { items[argCount++].value = value; }
+        void push(ElemType* var) { items[argCount++].var = var; }
+        void push(const string* name) { items[argCount++].name = name; }
+
+        void set(size_t i, ADTObject* adt) { items[i].adt = adt; }
+        void set(size_t i, ElemType value) { items[i].value = value; }
+        void set(size_t i, ElemType* var) { items[i].var = var; }
+        void set(size_t i, const string* name) { items[i].name = name; }
+
+        template<typename T>
+        T* adt(size_t i) const { return static_cast<T*>(items[i].adt); }
+        ElemType value(size_t i) const { return items[i].value; }
+        ElemType* var(size_t i) const { return items[i].var; }
+        const string& name(size_t i) const { return *items[i].name; }
+        // 串常量参数保存的是输入中的原始字符串（预写日志也记录原文），取值时才去掉引号和转义
+        string text(size_t i) const {
+            string text;
+            parseText(*items[i].name, text);
+            return text;
+        }
+    };
+
+    // 批处理中一条指令的逆操作：回滚时以参数 arg 所指 ADT 当前的对象调用 undo，将其恢复到指令执行之前的状态
+    // 回滚按相反的顺序进行，所以 undo 执行时对象正处于指令刚执行完的状态；undo 为空表示改为保存整个对象的快照
+    struct UndoStep {
+        size_t arg;
+        function<void(ADTObject*)> undo;
+    };
+
 #define SINGLETON_MEMBER(class_name) class_name* class_name::m_instance = nullptr;
 
     // 所有的指令类都应该继承 Function 并重写必要的虚函数，从而符合 Interactor 的调用规范
+    // 指令类还需要用 SIGNATURE 声明参数签名，Interactor 据此解码参数后再调用 invoke
     class Function {
     public:
         Status status = DSCxx_OK;
 
-        virtual Status invoke(const vector<string>& args) {
+        virtual ArgSignature signature() const = 0;
+
+        virtual bool readOnly() const {
+            return false;
+        }
+
+        // 在批处理中执行之前调用（参数已经绑定）：为会被修改的 ADT 参数写入逆操作并返回 true，
+        // 回滚时只需执行这些逆操作，提交时也不必复制任何数据；撤销之后，之后的指令得到的结果必须与从未执行过
+        // 这条指令时完全相同（例如优先队列中相等元素的出队顺序、分配的句柄），只是元素集合相等还不够
+        // 默认返回 false，此时为所有 ADT 参数在其第一次被修改之前保存整个对象的快照
+        virtual bool undoSteps(const ArgBlock &args, vector<UndoStep> &steps) const {
+            return false;
+        }
+
+        // 非只读指令在批处理中返回这样的状态时视为执行失败，整个批处理回滚
+        virtual bool failed(Status status) const {
+            return status == DSCxx_ERROR || status < 0;
+        }
+
+        virtual Status invoke(const ArgBlock& args) {
             throw UnimplementedException();
         }
 
         virtual void output() {
-            cout << "Status = " << StatusToString(status) << endl;
+            OutputSink::instance()->result(status, string("Status = ") + StatusToString(status));
         }
     };
 }
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace DataStructure_Cxx {
+
+#define TRACE_RING_CAPACITY (1 << 15)   // 每个线程最多保留的事件数，超出后覆盖最早的事件
+#define TRACE_MAX_VALUES 4              // 内部调用记录的整数参数的最大个数
+#define TRACE_TEXT_SIZE 64              // 指令的参数（以逗号分隔的原始字符串）最多保留的字节数
+
+    // 一段执行区间：指令从开始到返回，在 Chrome 的 trace-event 格式中对应一个 "X"（complete）事件
+    // 结束时才一次写入，所以环形缓冲区覆盖旧事件时不会留下只有开始、没有结束的区间
+    struct TraceEvent {
+        const char* name;       // 指向字符串字面值或者 ExecutionTracer 保存的指令名称，始终有效
+        int64_t start;          // 相对于开始追踪的纳秒数
+        int64_t duration;
+        bool instruction;       // 由 Interactor 调用的指令（参数为 text），否则为内部调用（参数为 values）
+        uint8_t valueCount;
+        int32_t values[TRACE_MAX_VALUES];
+        char text[TRACE_TEXT_SIZE];
+    };
+
+    // 每个线程自己的环形缓冲区：只有所属的线程写入（单写者），写入不加锁，只发布 written
+    // writing 与追踪开关组成一次握手：stop() 关闭开关后等待 writing 变为 false，之后才读取事件，所以读取时不会有写入者
+    // events 按需增长到 TRACE_RING_CAPACITY，只记录过少量事件的线程（例如后台任务）不会占用整个容量
+    struct TraceBuffer {
+        vector<TraceEvent> events;
+        atomic<uint64_t> written{0};    // 写入过的事件总数，超过容量的部分已被覆盖
+        atomic<bool> writing{false};
+        atomic<bool> finished{false};   // 所属的线程已经结束，导出之后即可回收
+        int tid = 0;
+        string threadName;              // 由 registryMutex 保护
+    };
+
+    // 可选的执行追踪：开启后记录每条指令（包括批处理和后台任务中的指令）以及数据结构内部调用的执行区间，
+    // 停止时写出 Chrome trace-event 格式的 JSON 文件，可以在 chrome://tracing 或 Perfetto 中查看嵌套关系
+    // 关闭时每个追踪点只多一次 relaxed 读取；默认只追踪 Union_Sq 这类整体操作（TRACE_SCOPE），
+    // GetElem_Sq 这类逐元素调用的追踪点（TRACE_FINE_SCOPE）只在定义 DSCxx_ENABLE_FINE_TRACING 时编译，
+    // 定义 DSCxx_DISABLE_TRACING 时两者都在编译期被去掉
+    class ExecutionTracer {
+    private:
+        chrono::steady_clock::time_point epoch;
+        string path;
+        mutex registryMutex;
+        vector<shared_ptr<TraceBuffer>> buffers;    // 线程结束后缓冲区仍然保留到下一次导出
+        set<string> names;                          // 指令名称只保存一份，事件中只记录指针
+
+        // 线程结束时标记其缓冲区，缓冲区本身由 buffers 持有
+        struct LocalBuffer {
+            shared_ptr<TraceBuffer> buffer;
+
+            ~LocalBuffer() {
+                if (buffer != nullptr) buffer->finished.store(true);
+            }
+        };
+
+        ExecutionTracer() = default;
+
+    public:
+        static ExecutionTracer* instance() {
+            static ExecutionTracer tracer;
+            return &tracer;
+        }
+
+        // 程序正常退出（包括 exit）时写出尚未停止的追踪
+        ~ExecutionTracer() {
+            if (flag().load()) stop();
+        }
+
+        // 开关单独存放在常量初始化的静态变量中，追踪点检查它时不需要经过 instance() 的初始化检查
+        static atomic<bool>& flag() {
+            static atomic<bool> active{false};
+            return active;
+        }
+
+        static bool enabled() {
+            return flag().load(memory_order_relaxed);
+        }
+
+        const string& outputPath() const {
+            return path;
+        }
+
+        // 开始追踪，之前记录的事件全部丢弃；已在追踪时只更换输出文件
+        void start(const string& outputPath) {
+            lock_guard<mutex> guard(registryMutex);
+            path = outputPath;
+            if (flag().load()) return;
+            // 开关关闭时写入者不会修改缓冲区（见 record），可以直接清空
+            reclaimFinished();
+            for (auto& buffer : buffers) {
+                buffer->events.clear();
+                buffer->written.store(0);
+            }
+            epoch = chrono::steady_clock::now();
+            flag().store(true);
+        }
+
+        // 停止追踪并写出 JSON 文件，返回写出的事件数，文件无法写入时返回 -1
+        long long stop() {
+            flag().store(false);
+            lock_guard<mutex> guard(registryMutex);
+            // 等待已经通过开关检查的写入者完成，此后直到下一次 start() 都没有线程写入缓冲区
+            for (auto& buffer : buffers) {
+                while (buffer->writing.load()) this_thread::yield();
+            }
+            FILE* file = fopen(path.c_str(), "w");
+            if (file == nullptr) {
+                reclaimFinished();
+                return -1;
+            }
+            long long count = 0;
+            uint64_t dropped = 0;
+            fputs("{\"traceEvents\":[", file);
+            bool first = true;
+            vector<TraceEvent> events;
+            for (auto& buffer : buffers) {
+                uint64_t written = buffer->written.load(memory_order_acquire);
+                size_t kept = (size_t) min<uint64_t>(written, buffer->events.size());
+                dropped += written - kept;
+                events.assign(buffer->events.begin(), buffer->events.begin() + kept);
+                if (events.empty()) continue;
+                // 事件按结束的顺序写入，导出时按开始时间排序，外层的区间排在它包含的区间之前
+                sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+                    return a.start != b.start ? a.start < b.start : a.duration > b.duration;
+                });
+                if (!buffer->threadName.empty()) {
+                    fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                            first ? "" : ",", buffer->tid, escape(buffer->threadName).c_str());
+                    first = false;
+                }
+                for (auto& event : events) {
+                    fprintf(file, "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,"
+                                  "\"args\":{\"args\":\"%s\"}}",
+                            first ? "" : ",", escape(event.name).c_str(), event.instruction ? "instruction" : "internal",
+                            event.start / 1e3, event.duration / 1e3, buffer->tid, escape(arguments(event)).c_str());
+                    first = false;
+                    ++count;
+                }
+            }
+            fprintf(file, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":%llu}}\n",
+                    (unsigned long long) dropped);
+            fclose(file);
+            reclaimFinished();
+            return count;
+        }
+
+        // 为当前线程在追踪结果中命名，例如 "Job 3"
+        void nameThread(const string& name) {
+            auto buffer = localBuffer();
+            lock_guard<mutex> guard(registryMutex);
+            buffer->threadName = name;
+        }
+
+        const char* intern(const string& name) {
+            lock_guard<mutex> guard(registryMutex);
+            return names.insert(name).first->c_str();
+        }
+
+        int64_t now() const {
+            return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - epoch).count();
+        }
+
+        // 先声明正在写入再检查开关，stop() 先关闭开关再检查 writing（均为顺序一致的原子操作），
+        // 两者之中至少有一方看到对方，所以 stop() 读取事件时不会与这里的写入重叠
+        void record(const TraceEvent& event) {
+            auto buffer = localBuffer();
+            buffer->writing.store(true);
+            if (flag().load()) {
+                uint64_t written = buffer->written.load(memory_order_relaxed);
+                if (buffer->events.size() < TRACE_RING_CAPACITY) buffer->events.push_back(event);
+                else buffer->events[written % TRACE_RING_CAPACITY] = event;
+                buffer->written.store(written + 1, memory_order_release);
+            }
+            buffer->writing.store(false, memory_order_release);
+        }
+
+    private:
+        TraceBuffer* localBuffer() {
+            static thread_local LocalBuffer local;
+            if (local.buffer == nullptr) {
+                local.buffer = make_shared<TraceBuffer>();
+                lock_guard<mutex> guard(registryMutex);
+                local.buffer->tid = nextTid();
+                buffers.push_back(local.buffer);
+            }
+            return local.buffer.get();
+        }
+
+        // 编号只增不减，回收缓冲区后新线程也不会与之前导出的线程重号
+        static int nextTid() {
+            static int tid = 0;
+            return ++tid;
+        }
+
+        // 丢弃已结束线程的缓冲区（它们的事件已经导出或被 start() 丢弃），调用时持有 registryMutex
+        void reclaimFinished() {
+            buffers.erase(remove_if(buffers.begin(), buffers.end(), [](const shared_ptr<TraceBuffer>& buffer) {
+                return buffer->finished.load();
+            }), buffers.end());
+        }
+
+        static string arguments(const TraceEvent& event) {
+            if (event.instruction) return event.text;
+            string text;
+            for (int k = 0; k < event.valueCount; ++k) {
+                if (k > 0) text += ", ";
+                text += to_string(event.values[k]);
+            }
+            return text;
+        }
+
+        static string escape(const string& str) {
+            string escaped;
+            for (char c : str) {
+                if (c == '"' || c == '\\') {
+                    escaped += '\\';
+                    escaped += c;
+                }
+                else if ((unsigned char) c < 0x20) {
+                    char code[8];
+                    snprintf(code, sizeof(code), "\\u%04x", c);
+                    escaped += code;
+                }
+                else {
+                    escaped += c;
+                }
+            }
+            return escaped;
+        }
+    };
+
+    // 追踪数据结构内部的一次调用：构造时记下开始时间，析构时写入当前线程的缓冲区；开始时追踪未开启则什么也不做
+    // 可能放在 GetElem_Sq 这样的热路径中（TRACE_FINE_SCOPE），所以只保存整数参数，事件在析构时才组装
+    class TraceScope {
+    private:
+        const char* name;
+        int64_t start = 0;
+        int32_t values[TRACE_MAX_VALUES];
+        uint8_t valueCount = 0;
+        bool recording;
+
+    public:
+        // name 必须是字符串字面值，values 为其整数参数（最多 TRACE_MAX_VALUES 个）
+        template<typename... Values>
+        explicit TraceScope(const char* name, Values... values) : name(name), recording(ExecutionTracer::enabled()) {
+            if (!recording) return;
+            int32_t items[] = { 0, (int32_t) values... };
+            valueCount = (uint8_t) min<size_t>(sizeof...(values), TRACE_MAX_VALUES);
+            memcpy(this->values, items + 1, valueCount * sizeof(int32_t));
+            start = ExecutionTracer::instance()->now();
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+        ~TraceScope() {
+            if (recording) finish();
+        }
+
+    private:
+        void finish() const {
+            auto tracer = ExecutionTracer::instance();
+            TraceEvent event;
+            event.name = name;
+            event.start = start;
+            event.duration = tracer->now() - start;
+            event.instruction = false;
+            event.valueCount = valueCount;
+            memcpy(event.values, values, valueCount * sizeof(int32_t));
+            tracer->record(event);
+        }
+    };
+
+    // 追踪 Interactor 执行的一条指令，参数为输入中的原始字符串
+    class InstructionTraceScope {
+    private:
+        TraceEvent event;
+        bool recording;
+
+    public:
+        InstructionTraceScope(const string& name, const vector<string>& args) : recording(ExecutionTracer::enabled()) {
+            if (!recording) return;
+            auto tracer = ExecutionTracer::instance();
+            string text;
+            for (size_t k = 0; k < args.size(); ++k) {
+                if (k > 0) text += ", ";
+                text += args[k];
+            }
+            event.name = tracer->intern(name);
+            event.instruction = true;
+            event.valueCount = 0;
+            size_t size = min<size_t>(text.size(), TRACE_TEXT_SIZE - 1);
+            memcpy(event.text, text.data(), size);
+            event.text[size] = '\0';
+            event.start = tracer->now();
+        }
+
+        InstructionTraceScope(const InstructionTraceScope&) = delete;
+        InstructionTraceScope& operator=(const InstructionTraceScope&) = delete;
+
+        ~InstructionTraceScope() {
+            if (!recording) return;
+            auto tracer = ExecutionTracer::instance();
+            event.duration = tracer->now() - event.start;
+            tracer->record(event);
+        }
+    };
+
+#define DSCxx_TRACE_CONCAT_IMPL(a, b) a##b
+#define DSCxx_TRACE_CONCAT(a, b) DSCxx_TRACE_CONCAT_IMPL(a, b)
+
+    // 在函数开头追踪整个函数的执行，例如 TRACE_SCOPE("Union_Sq", target.length, source.length)
+    // 逐元素调用（例如 GetElem_Sq）使用 TRACE_FINE_SCOPE，默认不编译，避免为 Union_Sq 中的每次比较付出开销
+#ifdef DSCxx_DISABLE_TRACING
+#define TRACE_SCOPE(...) ((void)0)
+#else
+#define TRACE_SCOPE(...) TraceScope DSCxx_TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
+#endif
+
+#if defined(DSCxx_ENABLE_FINE_TRACING) && !defined(DSCxx_DISABLE_TRACING)
+#define TRACE_FINE_SCOPE(...) TraceScope DSCxx_TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
+#else
+#define TRACE_FINE_SCOPE(...) ((void)0)
+#endif
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+namespace DataStructure_Cxx {
+
+#define OUTPUT_SINK_FLUSH_THRESHOLD (64 * 1024)   // 缓冲区超过该大小时无论刷新策略如何都会立即写出
+
+    // 程序的所有输出都先写入 OutputSink 的缓冲区，再按照刷新策略统一写到标准输出，
+    // 这样输出很多的脚本不会因为每行一次 endl 而被系统调用拖慢
+    class OutputSink {
+    public:
+        enum FlushPolicy {
+            FlushPerCommand,    // 每条命令执行完毕后刷新（交互使用时的默认值）
+            FlushPerBatch,      // 每个批处理提交后刷新
+            FlushOnExit         // 只在缓冲区满或者程序退出时刷新
+        };
+        enum Format {
+            TextFormat,         // 面向用户的文本格式，例如 Status = TRUE/OK (value: 1)
+            CompactFormat       // 面向下游程序的紧凑格式：每个结果一行，OK <status> 或 ERR <message>
+        };
+
+        FlushPolicy flushPolicy = FlushPerCommand;
+        Format format = TextFormat;
+        bool quiet = false;     // 安静模式：只输出错误以及用户显式查询的内容
+        // 写出之前调用的屏障：启用预写日志时等待已执行命令的记录落盘，保证用户看到的结果都已持久化
+        void (*barrier)() = nullptr;
+
+    private:
+        ostringstream buffer;
+        ostream discarded{nullptr}; // 没有关联缓冲区的流，写入的内容都会被丢弃
+
+        OutputSink() = default;
+
+    public:
+        static OutputSink* instance() {
+            static OutputSink sink;
+            return &sink;
+        }
+
+        // 程序正常退出（包括 exit）时会析构静态对象，确保缓冲区中剩余的内容都被写出
+        ~OutputSink() {
+            flush();
+        }
+
+        // 普通输出：提示符、确认信息等，安静模式和紧凑格式下会被丢弃（紧凑格式每个结果只输出 result/error 的一行）
+        ostream& out() {
+            return (quiet || format == CompactFormat) ? discarded : buffer;
+        }
+
+        // 用户显式查询的内容（list、显示变量、帮助等），任何模式下都会输出
+        ostream& info() {
+            return buffer;
+        }
+
+        void result(long long status, const string& text) {
+            if (quiet) return;
+            if (format == CompactFormat) {
+                buffer << "OK " << status << '\n';
+            }
+            else {
+                buffer << text << '\n';
+            }
+        }
+
+        void error(const string& msg) {
+            if (format == CompactFormat) {
+                buffer << "ERR " << msg << '\n';
+            }
+            else {
+                buffer << msg << '\n';
+            }
+        }
+
+        void endCommand() {
+            if (flushPolicy == FlushPerCommand || buffer.tellp() > OUTPUT_SINK_FLUSH_THRESHOLD) {
+                flush();
+            }
+        }
+
+        void endBatch() {
+            if (flushPolicy != FlushOnExit || buffer.tellp() > OUTPUT_SINK_FLUSH_THRESHOLD) {
+                flush();
+            }
+        }
+
+        void flush() {
+            auto content = buffer.str();
+            if (content.empty()) return;
+            if (barrier != nullptr) {
+                barrier();
+            }
+            fwrite(content.data(), 1, content.size(), stdout);
+            fflush(stdout);
+            buffer.str("");
+        }
+    };
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+namespace DataStructure_Cxx {
+
+    // 指令集在编译时就已经确定，所以指令表也在编译时生成：
+    // 各个 ADT 的 Loader 用 LoadFunc 列出自己的指令，ADTLoader.hpp 把它们汇总成一个数组，
+    // 再由 buildInstructionTable 在编译期构造完美哈希表（hash and displace），
+    // 运行时查找只需对指令名计算一次哈希，再与唯一的候选项比较一次
+
+    struct InstructionEntry {
+        const char* name;
+        Function* (*instance)();
+        ArgSignature (*signature)();    // 不需要创建指令对象就能取得参数签名，供加载时检查
+    };
+
+    template<typename F>
+    Function* instanceOf() {
+        return F::instance();
+    }
+
+    // 在 Loader 中列出指令时使用，每一项展开为指令表中的一个元素
+#define LoadFunc(func_name) InstructionEntry{ #func_name, &instanceOf<func_name>, &func_name::argSignature },
+
+    // FNV-1a 哈希，指令名只需扫描一遍
+    constexpr uint32_t instructionHash(const char* str, size_t len) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < len; ++i) {
+            h ^= (uint8_t)str[i];
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    constexpr size_t constLength(const char* str) {
+        size_t len = 0;
+        while (str[len] != '\0') ++len;
+        return len;
+    }
+
+    // 由指令名的哈希值和所在桶的偏移量计算槽位（整数混合函数，不需要再次扫描指令名）
+    constexpr uint32_t instructionSlot(uint32_t h, uint32_t displacement) {
+        uint32_t x = h ^ (displacement * 0x9e3779b9u);
+        x ^= x >> 16;
+        x *= 0x85ebca6bu;
+        x ^= x >> 13;
+        x *= 0xc2b2ae35u;
+        x ^= x >> 16;
+        return x;
+    }
+
+    constexpr size_t nextPowerOfTwo(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    template<size_t N>
+    struct InstructionTable {
+        static constexpr size_t BucketCount = (N + 3) / 4;          // 平均每个桶 4 条指令
+        static constexpr size_t SlotCount = nextPowerOfTwo(N * 2);  // 槽位数为 2 的幂，取模只需按位与
+
+        InstructionEntry entries[N];
+        uint32_t hashes[N];
+        uint16_t displacements[BucketCount];
+        int16_t slots[SlotCount];   // 指令在 entries 中的下标，-1 表示空槽
+    };
+
+    // 构造完美哈希表：先按第一次哈希把指令分到各个桶中，再从最大的桶开始，
+    // 为每个桶寻找一个偏移量，使桶内所有指令都落到互不冲突的空槽位上
+    // 如果指令名重复（或者哈希值完全相同），常量求值会在 throw 处失败，从而在编译时报错
+    template<size_t N>
+    constexpr InstructionTable<N> buildInstructionTable(const InstructionEntry (&entries)[N]) {
+        using Table = InstructionTable<N>;
+        Table table{};
+        size_t bucketOf[N] = {};
+        size_t bucketSize[Table::BucketCount] = {};
+        for (size_t i = 0; i < N; ++i) {
+            table.entries[i] = entries[i];
+            table.hashes[i] = instructionHash(entries[i].name, constLength(entries[i].name));
+            for (size_t j = 0; j < i; ++j) {
+                if (table.hashes[j] == table.hashes[i]) {
+                    throw logic_error("Duplicate instruction name or hash.");
+                }
+            }
+            bucketOf[i] = table.hashes[i] % Table::BucketCount;
+            ++bucketSize[bucketOf[i]];
+        }
+        for (size_t s = 0; s < Table::SlotCount; ++s) {
+            table.slots[s] = -1;
+        }
+        size_t maxSize = 0;
+        for (size_t b = 0; b < Table::BucketCount; ++b) {
+            if (bucketSize[b] > maxSize) maxSize = bucketSize[b];
+        }
+        for (size_t size = maxSize; size > 0; --size) {
+            for (size_t b = 0; b < Table::BucketCount; ++b) {
+                if (bucketSize[b] != size) continue;
+                bool placed = false;
+                for (uint32_t d = 0; d < 0xffffu && !placed; ++d) {
+                    size_t candidate[N] = {};
+                    size_t count = 0;
+                    bool ok = true;
+                    for (size_t i = 0; i < N && ok; ++i) {
+                        if (bucketOf[i] != b) continue;
+                        size_t slot = instructionSlot(table.hashes[i], d) & (Table::SlotCount - 1);
+                        if (table.slots[slot] != -1) ok = false;
+                        for (size_t k = 0; k < count && ok; ++k) {
+                            if (candidate[k] == slot) ok = false;
+                        }
+                        candidate[count++] = slot;
+                    }
+                    if (!ok) continue;
+                    count = 0;
+                    for (size_t i = 0; i < N; ++i) {
+                        if (bucketOf[i] == b) {
+                            table.slots[candidate[count++]] = (int16_t)i;
+                        }
+                    }
+                    table.displacements[b] = (uint16_t)d;
+                    placed = true;
+                }
+                if (!placed) {
+                    throw logic_error("Failed to build the perfect hash table.");
+                }
+            }
+        }
+        return table;
+    }
+
+    // 不依赖指令数量的只读视图，Interactor 通过它查找指令
+    struct InstructionTableView {
+        const InstructionEntry* entries = nullptr;
+        const uint32_t* hashes = nullptr;
+        size_t count = 0;
+        const uint16_t* displacements = nullptr;
+        size_t bucketCount = 0;
+        const int16_t* slots = nullptr;
+        size_t slotCount = 0;
+
+        Function* find(const string& name) const {
+            if (count == 0) return nullptr;
+            uint32_t h = instructionHash(name.data(), name.size());
+            size_t slot = instructionSlot(h, displacements[h % bucketCount]) & (slotCount - 1);
+            int i = slots[slot];
+            if (i < 0 || hashes[i] != h || strcmp(entries[i].name, name.c_str()) != 0) {
+                return nullptr;
+            }
+            return entries[i].instance();
+        }
+    };
+
+    template<size_t N>
+    InstructionTableView makeInstructionTableView(const InstructionTable<N>& table) {
+        InstructionTableView view;
+        view.entries = table.entries;
+        view.hashes = table.hashes;
+        view.count = N;
+        view.displacements = table.displacements;
+        view.bucketCount = InstructionTable<N>::BucketCount;
+        view.slots = table.slots;
+        view.slotCount = InstructionTable<N>::SlotCount;
+        return view;
+    }
+}
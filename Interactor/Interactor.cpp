@@ -17,6 +17,11 @@
 
 #include "Interactor.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <regex>
 
@@ -25,105 +30,560 @@ using namespace std;
 namespace DataStructure_Cxx {
     Interactor* Interactor::m_instance;
 
+    // 当前线程所执行的后台任务的临时变量表，主线程中始终为空
+    static thread_local unordered_map<string, ElemType*>* jobTemporaries = nullptr;
+
+    // 后台任务中以下划线开头的变量（指令内部使用的临时变量）存放在任务自己的变量表中
+    static unordered_map<string, ElemType*>* temporaryScope(const string& name) {
+        if (jobTemporaries != nullptr && !name.empty() && name[0] == '_') {
+            return jobTemporaries;
+        }
+        return nullptr;
+    }
+
+    // 函数指令的外形：开头的单词紧接着左括号，并以右括号结尾。绝大多数命令都是函数指令，
+    // 扫描一遍开头的单词就能认出它们，不必再逐个尝试 new、set、wait 等命令的正则表达式
+    static bool isInstructionCall(const string& instStr) {
+        size_t pos = 0;
+        while (pos < instStr.size() && (isalnum((unsigned char) instStr[pos]) || instStr[pos] == '_')) ++pos;
+        return pos > 0 && pos < instStr.size() && instStr[pos] == '(' && instStr.back() == ')';
+    }
+
+    // 其他命令都以固定的关键字开头，关键字对得上时才用正则表达式匹配
+    static bool startsWith(const string& instStr, const char* keyword) {
+        return instStr.compare(0, strlen(keyword), keyword) == 0;
+    }
+
+    string InvokeError::message() const {
+        switch (code) {
+            case InvalidArgumentCount:
+                return InstructionInvalidArgumentCountException(need, given).what();
+            case InvalidArgument:
+                return InstructionInvalidArgumentException(subject).what();
+            case ADTNotFound:
+                return OperateObjectFailedException("Search", "ADT", subject,
+                    "Target ADT not exists.").what();
+            case ADTTypeMismatch:
+                return OperateObjectFailedException("Search", "ADT", subject,
+                    "Target ADT is not a " + detail + ".").what();
+            case VariableNotFound:
+                return OperateObjectFailedException("Search", "Variable", subject,
+                    "Target variable not exists.").what();
+            case InstructionNotFound:
+                return InstructionNotFoundException(subject).what();
+            case InvalidFormat:
+                return InstructionInvalidFormatException().what();
+            case VariableBusy:
+                return ADTBusyException(subject).what();
+            default:
+                return "";
+        }
+    }
+
+    ADTLockGuard::ADTLockGuard(const ADTRefs& adts, bool wait) {
+        for (auto& adt : adts) {
+            if (wait) {
+                adt.first->accessLock.lock();
+            }
+            else if (!adt.first->accessLock.try_lock()) {
+                for (auto obj : locked) {
+                    obj->accessLock.unlock();
+                }
+                throw ADTBusyException(adt.second);
+            }
+            locked.push_back(adt.first);
+        }
+    }
+
+    ADTLockGuard::~ADTLockGuard() {
+        for (auto obj : locked) {
+            obj->accessLock.unlock();
+        }
+    }
+
     void Interactor::run() {
-        cout << "DataStructure_Cxx Interactor " << DSCxx_VERSION << endl;
+        auto sink = OutputSink::instance();
+        if (sink->format == OutputSink::TextFormat) {
+            sink->out() << "DataStructure_Cxx Interactor " << DSCxx_VERSION << '\n';
+        }
         string instStr;
         while (true) {
-            cout << ">> ";
-            getline(cin, instStr);
-            try {
-                if (handleControlInstruction(instStr) ||
-                    handleOperationInstruction(instStr) ||
-                    handleVariableInstruction(instStr))
-                {
-                    continue;
+            if (sink->format == OutputSink::TextFormat) {
+                sink->out() << ">> ";
+            }
+            sink->endCommand();
+            // 输入结束时与 /q 相同，正常退出（缓冲区和轨迹文件会在退出时写出）
+            if (!getline(cin, instStr)) {
+                quit(EXIT_SUCCESS);
+            }
+            auto received = chrono::steady_clock::now();
+            auto outcome = dispatch(instStr);
+            if (outcome.kind == CommandOutcome::Failed) {
+                sink->error(outcome.message);
+            }
+            if (instStr == "commit") {
+                sink->endBatch();
+            }
+            if (traceFile != nullptr) {
+                auto offset = chrono::duration_cast<chrono::microseconds>(received - traceStart).count();
+                fprintf(traceFile, "%lld\t%s\t%s\n", (long long)offset, outcome.str().c_str(), instStr.c_str());
+            }
+        }
+    }
+
+    CommandOutcome Interactor::dispatch(const string &instStr) {
+        CommandOutcome outcome;
+        hasResult = false;
+        try {
+            if (!isInstructionCall(instStr) && (
+                handleControlInstruction(instStr) ||
+                handleSettingInstruction(instStr) ||
+                handleTransactionInstruction(instStr) ||
+                handleJobInstruction(instStr) ||
+                handleLogInstruction(instStr) ||
+                handleTraceInstruction(instStr)))
+            {
+                // 已处理
+            }
+            else if (inBatch) {
+                pendingBatch.push_back(instStr);
+            }
+            else {
+                if (!execute(instStr)) {
+                    outcome.kind = CommandOutcome::Failed;
+                    outcome.message = InvokeError::current().message();
                 }
-                string instName;
-                auto instArgs = extractInstructionStr(instStr, instName);
-                if (availableInstructions.find(instName) == availableInstructions.end()) {
-                    throw InstructionNotFoundException(instName);
+                // 日志过大时自动做检查点；批处理、后台任务进行中时推迟到之后的命令
+                auto wal = WriteAheadLog::instance();
+                if (wal->active() && wal->logSize() > WAL_CHECKPOINT_THRESHOLD && !hasRunningJobs()) {
+                    checkpoint();
                 }
-                invoke(availableInstructions.at(instName), instArgs);
             }
-            catch (const invalid_argument& iae) {
-                InstructionInvalidArgumentException iiae(iae.what());
-                cout << iiae.what() << endl;
+        }
+        catch (const invalid_argument& iae) {
+            outcome.kind = CommandOutcome::Failed;
+            outcome.message = InstructionInvalidArgumentException(iae.what()).what();
+        }
+        catch (const exception& e) {
+            outcome.kind = CommandOutcome::Failed;
+            outcome.message = e.what();
+        }
+        if (outcome.kind != CommandOutcome::Failed && hasResult) {
+            outcome.kind = CommandOutcome::Result;
+            outcome.status = lastStatus;
+        }
+        return outcome;
+    }
+
+    void Interactor::startRecording(const string &path) {
+        traceFile = fopen(path.c_str(), "w");
+        if (traceFile == nullptr) {
+            throw OperateObjectFailedException("Create", "Trace file", path);
+        }
+        traceStart = chrono::steady_clock::now();
+    }
+
+    bool Interactor::replay(const string &path, bool originalPacing) {
+        ifstream trace(path);
+        if (!trace) {
+            throw OperateObjectFailedException("Open", "Trace file", path);
+        }
+        struct TraceEntry {
+            long long offset;
+            string expected;
+            string instStr;
+        };
+        vector<TraceEntry> entries;
+        string line;
+        while (getline(trace, line)) {
+            auto first = line.find('\t');
+            auto second = (first == string::npos) ? string::npos : line.find('\t', first + 1);
+            if (second == string::npos) {
+                throw OperateObjectFailedException("Parse", "Trace file", path,
+                    "Invalid line " + to_string(entries.size() + 1) + ".");
             }
-            catch (const exception& e) {
-                cout << e.what() << endl;
+            entries.push_back({ atoll(line.c_str()), line.substr(first + 1, second - first - 1), line.substr(second + 1) });
+        }
+
+        // 重放期间不输出执行结果，只保留最后的报告
+        auto sink = OutputSink::instance();
+        bool quiet = sink->quiet;
+        sink->quiet = true;
+        vector<double> latencies;
+        latencies.reserve(entries.size());
+        size_t mismatches = 0;
+        auto start = chrono::steady_clock::now();
+        for (size_t k = 0; k < entries.size(); ++k) {
+            auto& entry = entries[k];
+            if (originalPacing) {
+                this_thread::sleep_until(start + chrono::microseconds(entry.offset));
             }
+            auto begin = chrono::steady_clock::now();
+            auto outcome = dispatch(entry.instStr);
+            auto end = chrono::steady_clock::now();
+            latencies.push_back(chrono::duration<double, micro>(end - begin).count());
+            if (outcome.str() != entry.expected) {
+                if (++mismatches <= 10) {
+                    sink->info() << "Mismatch at line " << k + 1 << " \"" << entry.instStr << "\": recorded "
+                                 << entry.expected << ", replayed " << outcome.str() << ".\n";
+                }
+            }
+        }
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        sink->quiet = quiet;
+
+        auto& report = sink->info();
+        report << "Replayed " << entries.size() << " command(s) in " << elapsed << " s ("
+               << (elapsed > 0 ? entries.size() / elapsed : 0) << " commands/s), "
+               << mismatches << " mismatch(es).\n";
+        if (!latencies.empty()) {
+            sort(latencies.begin(), latencies.end());
+            auto percentile = [&](double p) {
+                return latencies[(size_t)(p / 100 * (latencies.size() - 1) + 0.5)];
+            };
+            report << "Latency (us): p50 " << percentile(50) << ", p90 " << percentile(90)
+                   << ", p99 " << percentile(99) << ", p99.9 " << percentile(99.9)
+                   << ", max " << latencies.back() << '\n';
         }
+        return mismatches == 0;
+    }
+
+    bool Interactor::execute(const string &instStr) {
+        InvokeError::clear();
+        if (!isInstructionCall(instStr) && (
+            handleOperationInstruction(instStr) ||
+            handleVariableInstruction(instStr)))
+        {
+            return !InvokeError::pending();
+        }
+        string instName;
+        vector<string> instArgs;
+        if (!parseInstructionStr(instStr, instName, instArgs)) {
+            InvokeError::raise(InvokeError::InvalidFormat);
+            return false;
+        }
+        auto func = findInstruction(instName);
+        if (func == nullptr) {
+            InvokeError::raise(InvokeError::InstructionNotFound, instName);
+            return false;
+        }
+        return invoke(instName, func, instArgs);
     }
 
     vector<string> Interactor::extractInstructionStr(const string& instStr, string& instName) {
-        regex instRegex(R"((\w+)\((\s*(\w+)\s*,)*(\s*(\w+)\s*)\))");
-        regex instRegexVoidArg(R"((\w+)\(\))");
-        smatch strMatch;
         vector<string> instArgs;
-        if (!regex_match(instStr, strMatch, instRegex)) {
-            if (!regex_match(instStr, strMatch, instRegexVoidArg)) {
-                throw InstructionInvalidFormatException();
+        if (!parseInstructionStr(instStr, instName, instArgs)) {
+            throw InstructionInvalidFormatException();
+        }
+        return instArgs;
+    }
+
+    // 格式：Name(arg, arg, ...)，参数为单词（\w+）或者用双引号括起的串常量，参数两侧可以有空白
+    // 串常量中可以出现逗号和括号，所以逐字符扫描而不是用正则表达式拆分；引号原样保留在参数中，由 decodeLiterals 检查
+    bool Interactor::parseInstructionStr(const string& instStr, string& instName, vector<string>& instArgs) {
+        auto isWordChar = [](char c) { return isalnum((unsigned char) c) || c == '_'; };
+        size_t pos = 0;
+        while (pos < instStr.size() && isWordChar(instStr[pos])) ++pos;
+        if (pos == 0 || pos >= instStr.size() || instStr[pos] != '(' || instStr.back() != ')') {
+            return false;
+        }
+        instName = instStr.substr(0, pos);
+        instArgs.clear();
+        ++pos;
+        if (pos + 1 == instStr.size()) return true;
+        while (true) {
+            while (isspace((unsigned char) instStr[pos])) ++pos;
+            size_t begin = pos;
+            if (instStr[pos] == '"') {
+                ++pos;
+                while (pos < instStr.size() && instStr[pos] != '"') {
+                    pos += (instStr[pos] == '\\') ? 2 : 1;
+                }
+                if (pos >= instStr.size()) return false;
+                ++pos;
             }
             else {
-                instName = strMatch[1];
-                return instArgs;
+                while (isWordChar(instStr[pos])) ++pos;
+                if (pos == begin) return false;
             }
-        }
-        instName = strMatch[1];
-        string argListStr = instStr.substr(instName.size());
-        regex singleArg(R"(\w+)");
-        sregex_iterator pos(argListStr.begin(), argListStr.end(), singleArg);
-        sregex_iterator end;
-        while (pos != end) {
-            instArgs.push_back(pos->str(0));
+            instArgs.push_back(instStr.substr(begin, pos - begin));
+            while (isspace((unsigned char) instStr[pos])) ++pos;
+            if (instStr[pos] == ')') return pos + 1 == instStr.size();
+            if (instStr[pos] != ',') return false;
             ++pos;
         }
-        return instArgs;
     }
 
-    void Interactor::invoke(Function *func, const vector<string>& args) {
-        func->status = func->invoke(args);
+    bool Interactor::invoke(const string& instName, Function *func, const vector<string>& args) {
+        InvokeError::clear();
+        auto signature = func->signature();
+        ArgBlock block;
+        if (!decodeLiterals(signature, args, block)) {
+            return false;
+        }
+        {
+            ADTLockGuard adtGuard(resolveADTs(args), false);
+            if (!bindReferences(signature, args, block)) {
+                return false;
+            }
+            {
+                InstructionTraceScope span(instName, args);
+                func->status = func->invoke(block);
+            }
+            if (InvokeError::pending()) {
+                return false;
+            }
+            hasResult = true;
+            lastStatus = func->status;
+            // 在释放 ADT 的锁之前记录，保证日志中的顺序与对同一 ADT 的实际修改顺序一致
+            if (!func->readOnly()) {
+                logRecord(encodeInvoke(instName, signature, args, block));
+            }
+        }
         func->output();
+        return true;
+    }
+
+    bool Interactor::decodeLiterals(const ArgSignature &signature, const vector<string> &args, ArgBlock &block) {
+        if (args.size() != signature.count) {
+            InvokeError::raise(InvokeError::InvalidArgumentCount, signature.count, args.size());
+            return false;
+        }
+        block.resize(args.size());
+        for (size_t i = 0; i < args.size(); ++i) {
+            auto kind = signature.specs[i].kind;
+            // 只有串常量参数可以用引号括起
+            bool quoted = !args[i].empty() && args[i][0] == '"';
+            string text;
+            if (kind == ArgSpec::Text ? !parseText(args[i], text) : quoted) {
+                InvokeError::raise(InvokeError::InvalidArgument, args[i]);
+                return false;
+            }
+            if (kind == ArgSpec::Name || kind == ArgSpec::Text) {
+                block.set(i, &args[i]);
+                continue;
+            }
+            if (kind != ArgSpec::Int) continue;
+            ElemType value;
+            if (!parseElem(args[i], value)) {
+                InvokeError::raise(InvokeError::InvalidArgument, args[i]);
+                return false;
+            }
+            block.set(i, value);
+        }
+        return true;
+    }
+
+    bool Interactor::bindReferences(const ArgSignature &signature, const vector<string> &args, ArgBlock &block) {
+        for (size_t i = 0; i < args.size(); ++i) {
+            auto& spec = signature.specs[i];
+            if (spec.kind == ArgSpec::ADT) {
+                auto obj = findADT(args[i], *spec.adtType, spec.acceptDerived);
+                if (obj == nullptr) return false;
+                block.set(i, obj);
+            }
+            else if (spec.kind == ArgSpec::Variable) {
+                auto var = findVariable(args[i]);
+                if (var == nullptr) return false;
+                block.set(i, var);
+            }
+        }
+        return true;
+    }
+
+    void Interactor::checkSignature(const string &name, const ArgSignature &signature) {
+        if (signature.count > MAX_INSTRUCTION_ARGS) {
+            throw logic_error("Instruction \"" + name + "\" declares too many arguments.");
+        }
+        for (size_t i = 0; i < signature.count; ++i) {
+            auto& spec = signature.specs[i];
+            if (spec.kind == ArgSpec::ADT && *spec.adtType >= adtTypes.size()) {
+                throw logic_error("Instruction \"" + name + "\" uses an unregistered ADT type.");
+            }
+        }
+    }
+
+    void Interactor::setInstructionTable(const InstructionTableView &table) {
+        for (size_t i = 0; i < table.count; ++i) {
+            checkSignature(table.entries[i].name, table.entries[i].signature());
+        }
+        instructionTable = table;
     }
 
     void Interactor::addInstruction(const string &name, Function *func) {
+        checkSignature(name, func->signature());
         availableInstructions.insert({ name, func });
     }
 
+    Function* Interactor::findInstruction(const string &name) {
+        auto func = instructionTable.find(name);
+        if (func != nullptr || availableInstructions.empty()) {
+            return func;
+        }
+        auto instIter = availableInstructions.find(name);
+        return (instIter != availableInstructions.end()) ? instIter->second : nullptr;
+    }
+
     void Interactor::createADT(const string &name, const string& adtType) {
+        lock_guard<mutex> registryGuard(registryMutex);
         if (userCreatedADTs.find(name) != userCreatedADTs.end()) {
             throw ConflictUserDefinedNameException(name);
         }
-        try {
-            userCreatedADTs.insert({ name, availableADTs.at(adtType)->copy() });
-        }
-        catch (const exception& e) {
+        auto typeIter = availableADTs.find(adtType);
+        if (typeIter == availableADTs.end()) {
             throw OperateObjectFailedException("Create", "ADT", name,
                 "Target ADT type not supported.");
         }
+        auto obj = adtTypes[typeIter->second].sample->copy();
+        userCreatedADTs.insert({ name, allocateADTSlot(typeIter->second, obj, name) });
+        if (inTransaction) {
+            UndoRecord record;
+            record.kind = UndoRecord::ADTCreated;
+            record.name = name;
+            undoLog.push_back(record);
+            // 新创建的 ADT 在回滚时会被直接删除，无需再保存快照
+            loggedADTs.insert(name);
+        }
     }
 
     void Interactor::deleteADT(const string &name) {
-        try {
-            delete userCreatedADTs.at(name);
-            userCreatedADTs.erase(name);
-        }
-        catch (const exception& e) {
+        lock_guard<mutex> registryGuard(registryMutex);
+        auto adtIter = userCreatedADTs.find(name);
+        if (adtIter == userCreatedADTs.end()) {
             throw OperateObjectFailedException("Delete", "ADT", name);
         }
+        auto handle = adtIter->second;
+        auto obj = resolveADT(handle);
+        // 被后台任务引用或者正在使用的 ADT 不能被删除
+        if (obj->pinCount.load() > 0 || !obj->accessLock.try_lock()) {
+            throw ADTBusyException(name);
+        }
+        obj->accessLock.unlock();
+        releaseADTSlot(handle);
+        if (inTransaction) {
+            // 事务中被删除的对象暂时保留在撤销日志中，直到提交时才真正释放
+            UndoRecord record;
+            record.kind = UndoRecord::ADTDeleted;
+            record.name = name;
+            record.adtType = handle.type;
+            record.adt = obj;
+            undoLog.push_back(record);
+        }
+        else {
+            obj->release();
+            delete obj;
+        }
+        userCreatedADTs.erase(adtIter);
     }
 
     ADTObject* Interactor::getADT(const string &name) {
-        try {
-            return userCreatedADTs.at(name);
-        }
-        catch(const exception& e) {
+        lock_guard<mutex> registryGuard(registryMutex);
+        auto obj = lookupADT(name);
+        if (obj == nullptr) {
             throw OperateObjectFailedException("Search", "ADT", name,
                 "Target ADT not exists.");
         }
+        return obj;
+    }
+
+    ADTObject* Interactor::findADT(const string &name, uint32_t type, bool acceptDerived) {
+        lock_guard<mutex> registryGuard(registryMutex);
+        auto adtIter = userCreatedADTs.find(name);
+        if (adtIter == userCreatedADTs.end()) {
+            InvokeError::raise(InvokeError::ADTNotFound, name);
+            return nullptr;
+        }
+        auto actual = adtIter->second.type;
+        while (acceptDerived && actual != type && actual < adtTypes.size()) {
+            actual = adtTypes[actual].baseType;
+        }
+        if (actual != type) {
+            InvokeError::raise(InvokeError::ADTTypeMismatch, name,
+                type < adtTypes.size() ? adtTypes[type].name : "ADTObject");
+            return nullptr;
+        }
+        return resolveADT(adtIter->second);
+    }
+
+    ADTHandle Interactor::findADTHandle(const string &name) {
+        lock_guard<mutex> registryGuard(registryMutex);
+        auto adtIter = userCreatedADTs.find(name);
+        return (adtIter != userCreatedADTs.end()) ? adtIter->second : ADTHandle();
+    }
+
+    ADTObject* Interactor::findADT(const ADTHandle &handle) {
+        lock_guard<mutex> registryGuard(registryMutex);
+        return resolveADT(handle);
+    }
+
+    ADTHandle Interactor::findADTHandle(ADTObject *obj, string &name) {
+        lock_guard<mutex> registryGuard(registryMutex);
+        for (uint32_t type = 0; type < adtTypes.size(); ++type) {
+            auto& slots = adtTypes[type].slots;
+            for (uint32_t index = 0; index < slots.size(); ++index) {
+                if (slots[index].obj == obj) {
+                    name = slots[index].name;
+                    return ADTHandle{ type, index, slots[index].generation };
+                }
+            }
+        }
+        return ADTHandle();
+    }
+
+    ADTObject* Interactor::resolveADT(const ADTHandle &handle) {
+        if (handle.type >= adtTypes.size()) return nullptr;
+        auto& slots = adtTypes[handle.type].slots;
+        if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation) {
+            return nullptr;
+        }
+        return slots[handle.index].obj;
+    }
+
+    ADTHandle Interactor::allocateADTSlot(uint32_t type, ADTObject *obj, const string &name) {
+        auto& registry = adtTypes[type];
+        ADTHandle handle;
+        handle.type = type;
+        if (!registry.freeSlots.empty()) {
+            handle.index = registry.freeSlots.back();
+            registry.freeSlots.pop_back();
+        }
+        else {
+            handle.index = (uint32_t)registry.slots.size();
+            registry.slots.emplace_back();
+        }
+        auto& slot = registry.slots[handle.index];
+        slot.obj = obj;
+        slot.name = name;
+        handle.generation = slot.generation;
+        return handle;
+    }
+
+    ADTObject* Interactor::releaseADTSlot(const ADTHandle &handle) {
+        auto& registry = adtTypes[handle.type];
+        auto& slot = registry.slots[handle.index];
+        auto obj = slot.obj;
+        slot.obj = nullptr;
+        slot.name.clear();
+        ++slot.generation;
+        registry.freeSlots.push_back(handle.index);
+        return obj;
+    }
+
+    ADTObject* Interactor::lookupADT(const string &name) {
+        auto adtIter = userCreatedADTs.find(name);
+        return (adtIter != userCreatedADTs.end()) ? resolveADT(adtIter->second) : nullptr;
     }
 
     void Interactor::createVariable(const string &name) {
+        auto scope = temporaryScope(name);
+        if (scope != nullptr) {
+            if (scope->find(name) != scope->end()) {
+                throw ConflictUserDefinedNameException(name);
+            }
+            scope->insert({ name, new ElemType });
+            return;
+        }
+        lock_guard<mutex> registryGuard(registryMutex);
         if (userCreatedVariables.find(name) != userCreatedVariables.end()) {
             throw ConflictUserDefinedNameException(name);
         }
@@ -134,38 +594,83 @@ namespace DataStructure_Cxx {
         catch(const exception& e) {
             throw OperateObjectFailedException("Create", "Variable", name);
         }
+        if (inTransaction) {
+            UndoRecord record;
+            record.kind = UndoRecord::VariableCreated;
+            record.name = name;
+            undoLog.push_back(record);
+            loggedVariables.insert(name);
+        }
     }
 
     void Interactor::deleteVariable(const string &name) {
-        try {
-            delete userCreatedVariables.at(name);
-            userCreatedVariables.erase(name);
+        auto scope = temporaryScope(name);
+        auto& variables = (scope != nullptr) ? *scope : userCreatedVariables;
+        unique_lock<mutex> registryGuard(registryMutex, defer_lock);
+        if (scope == nullptr) {
+            registryGuard.lock();
+            if (pinnedVariables.find(name) != pinnedVariables.end()) {
+                throw ADTBusyException(name);
+            }
         }
-        catch(const exception& e) {
+        auto varIter = variables.find(name);
+        if (varIter == variables.end()) {
             throw OperateObjectFailedException("Delete", "Variable", name,
                 "Target variable not exists.");
         }
+        if (scope == nullptr && inTransaction) {
+            UndoRecord record;
+            record.kind = UndoRecord::VariableDeleted;
+            record.name = name;
+            record.variable = varIter->second;
+            undoLog.push_back(record);
+        }
+        else {
+            delete varIter->second;
+        }
+        variables.erase(varIter);
     }
 
     ElemType* Interactor::getVariable(const string &name) {
-        try {
-            return userCreatedVariables.at(name);
+        auto scope = temporaryScope(name);
+        unique_lock<mutex> registryGuard(registryMutex, defer_lock);
+        if (scope == nullptr) {
+            registryGuard.lock();
         }
-        catch(const exception& e) {
+        auto& variables = (scope != nullptr) ? *scope : userCreatedVariables;
+        auto varIter = variables.find(name);
+        if (varIter == variables.end()) {
             throw OperateObjectFailedException("Search", "Variable", name,
                 "Target variable not exists.");
         }
+        return varIter->second;
     }
 
-    void Interactor::addAdtType(const string &name, ADTObject *obj) {
-        availableADTs.insert({ name, obj });
+    ElemType* Interactor::findVariable(const string &name) {
+        auto scope = temporaryScope(name);
+        unique_lock<mutex> registryGuard(registryMutex, defer_lock);
+        if (scope == nullptr) {
+            registryGuard.lock();
+        }
+        auto& variables = (scope != nullptr) ? *scope : userCreatedVariables;
+        auto varIter = variables.find(name);
+        if (varIter == variables.end()) {
+            InvokeError::raise(InvokeError::VariableNotFound, name);
+            return nullptr;
+        }
+        // 后台任务引用的变量在任务结束之前只归该任务使用，前台的读写都会与任务线程竞争
+        if (scope == nullptr && jobTemporaries == nullptr && pinnedVariables.find(name) != pinnedVariables.end()) {
+            InvokeError::raise(InvokeError::VariableBusy, name);
+            return nullptr;
+        }
+        return varIter->second;
     }
 
     bool Interactor::handleControlInstruction(const string &instStr) {
         if (instStr.size() != 2 || instStr.at(0) != '/') return false;
         switch (instStr.at(1)) {
             case 'q':
-                std::exit(DSCxx_OK);
+                quit(EXIT_SUCCESS);
             case '?':
                 showHelpText();
                 break;
@@ -176,33 +681,47 @@ namespace DataStructure_Cxx {
     }
 
     bool Interactor::handleOperationInstruction(const string &instStr) {
-        regex newInstRegex(R"(new (\w+) (\w+))"); // 格式：new [adtType] [name] 或者 new var [name]
-        regex deleteInstRegex(R"(delete (\w+) (\w+))"); // 格式 delete adt|var [name]
-        regex listInstRegex(R"(list (adt|var))");
+        static const regex newInstRegex(R"(new (\w+) (\w+))"); // 格式：new [adtType] [name] 或者 new var [name]
+        static const regex deleteInstRegex(R"(delete (\w+) (\w+))"); // 格式 delete adt|var [name]
+        static const regex listInstRegex(R"(list (adt|var))");
+        if (!startsWith(instStr, "new ") && !startsWith(instStr, "delete ") && !startsWith(instStr, "list ")) {
+            return false;
+        }
         smatch strMatch;
         if (regex_match(instStr, strMatch, newInstRegex)) {
             string type = strMatch[1];
             string name = strMatch[2];
+            string record;
             if (type == "var") {
                 createVariable(name);
+                putU8(record, LogRecord::NewVariable);
             }
             else {
                 createADT(name, type);
+                putU8(record, LogRecord::NewADT);
+                putString(record, type);
             }
+            putString(record, name);
+            logRecord(record);
             return true;
         }
         else if (regex_match(instStr, strMatch, deleteInstRegex)) {
             string type = strMatch[1];
             string name = strMatch[2];
+            string record;
             if (type == "adt") {
                 deleteADT(name);
+                putU8(record, LogRecord::DeleteADT);
             }
             else if (type == "var") {
                 deleteVariable(name);
+                putU8(record, LogRecord::DeleteVariable);
             }
             else {
                 return false;
             }
+            putString(record, name);
+            logRecord(record);
             return true;
         }
         else if (regex_match(instStr, strMatch, listInstRegex)) {
@@ -221,40 +740,838 @@ namespace DataStructure_Cxx {
     }
 
     bool Interactor::handleVariableInstruction(const string &instStr) {
-        regex r(R"((\w+)\s*=\s*(\w+))");
+        static const regex r(R"((\w+)\s*=\s*(\w+))");
         smatch sm;
-        if (regex_match(instStr, sm, r)) {
-            auto left = getVariable(sm[1]);
-            // 这里要防止获取右边的参数时直接抛出异常，因为有可能这是一个整数字面值
+        if (instStr.find('=') != string::npos && regex_match(instStr, sm, r)) {
+            // 出错时同样视为已处理，错误记录在 InvokeError 中
+            auto left = findVariable(sm[1]);
+            if (left == nullptr) return true;
+            // 右边既可能是变量名也可能是整数字面值，先按变量名查找，找不到再按整数解析
+            ElemType value;
+            if (isVariable(sm[2])) {
+                auto right = findVariable(sm[2]);
+                if (right == nullptr) return true;
+                value = *right;
+            }
+            else if (!parseElem(sm[2], value)) {
+                InvokeError::raise(InvokeError::InvalidArgument, sm[2]);
+                return true;
+            }
+            logVariableModification(sm[1]);
+            *left = value;
+            string record;
+            putU8(record, LogRecord::SetVariable);
+            putString(record, sm[1]);
+            putI32(record, value);
+            logRecord(record);
+            return true;
+        }
+        else if (isVariable(instStr)) {
+            auto var = findVariable(instStr);
+            if (var != nullptr) {
+                OutputSink::instance()->info() << *var << '\n';
+            }
+            return true;
+        }
+        return false;
+    }
+
+    bool Interactor::isVariable(const string &name) {
+        lock_guard<mutex> registryGuard(registryMutex);
+        return userCreatedVariables.find(name) != userCreatedVariables.end();
+    }
+
+    bool Interactor::handleSettingInstruction(const string &instStr) {
+        static const regex setInstRegex(R"(set (output|format|flush) (\w+))"); // 格式：set output|format|flush [value]
+        smatch strMatch;
+        if (!startsWith(instStr, "set ") || !regex_match(instStr, strMatch, setInstRegex)) return false;
+        auto sink = OutputSink::instance();
+        string key = strMatch[1];
+        string value = strMatch[2];
+        if (key == "output" && (value == "normal" || value == "quiet")) {
+            sink->quiet = (value == "quiet");
+        }
+        else if (key == "format" && (value == "text" || value == "compact")) {
+            sink->format = (value == "text") ? OutputSink::TextFormat : OutputSink::CompactFormat;
+        }
+        else if (key == "flush" && value == "command") {
+            sink->flushPolicy = OutputSink::FlushPerCommand;
+        }
+        else if (key == "flush" && value == "batch") {
+            sink->flushPolicy = OutputSink::FlushPerBatch;
+        }
+        else if (key == "flush" && value == "exit") {
+            sink->flushPolicy = OutputSink::FlushOnExit;
+        }
+        else {
+            throw InstructionInvalidArgumentException(value);
+        }
+        return true;
+    }
+
+    bool Interactor::handleTransactionInstruction(const string &instStr) {
+        if (instStr == "begin") {
+            if (inBatch) {
+                throw BatchStateException("A batch has already begun.");
+            }
+            inBatch = true;
+            pendingBatch.clear();
+        }
+        else if (instStr == "commit") {
+            if (!inBatch) {
+                throw BatchStateException("No batch to commit.");
+            }
+            inBatch = false;
+            commitBatch();
+        }
+        else if (instStr == "rollback") {
+            if (!inBatch) {
+                throw BatchStateException("No batch to roll back.");
+            }
+            inBatch = false;
+            OutputSink::instance()->out() << "Batch discarded: " << pendingBatch.size() << " command(s).\n";
+            pendingBatch.clear();
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+
+    void Interactor::commitBatch() {
+        // 第一遍：一次性解析所有命令并查找函数指令，任何一条函数指令有误都不会执行整个批处理
+        vector<BatchCommand> commands(pendingBatch.size());
+        for (size_t k = 0; k < pendingBatch.size(); ++k) {
+            commands[k].instStr = pendingBatch[k];
+            auto& instName = commands[k].instName;
+            if (!parseInstructionStr(pendingBatch[k], instName, commands[k].args)) {
+                continue; // 不是函数指令，留到执行时交给 new、delete、赋值等命令的处理函数
+            }
+            commands[k].func = findInstruction(instName);
+            if (commands[k].func == nullptr) {
+                pendingBatch.clear();
+                throw InstructionNotFoundException(instName);
+            }
+            InvokeError::clear();
+            if (!decodeLiterals(commands[k].func->signature(), commands[k].args, commands[k].argBlock)) {
+                pendingBatch.clear();
+                throw BatchAbortedException(k + 1, commands[k].instStr, InvokeError::current().message());
+            }
+        }
+        pendingBatch.clear();
+
+        // 第二遍：在撤销日志的保护下连续执行，中途不输出任何执行结果
+        inTransaction = true;
+        for (size_t k = 0; k < commands.size(); ++k) {
+            auto& cmd = commands[k];
+            string reason;
+            InvokeError::clear();
+            try {
+                if (cmd.func == nullptr) {
+                    if (!handleOperationInstruction(cmd.instStr) &&
+                        !handleVariableInstruction(cmd.instStr))
+                    {
+                        InvokeError::raise(InvokeError::InvalidFormat);
+                    }
+                }
+                else {
+                    ADTLockGuard adtGuard(resolveADTs(cmd.args), false);
+                    bool readOnly = cmd.func->readOnly();
+                    auto signature = cmd.func->signature();
+                    if (bindReferences(signature, cmd.args, cmd.argBlock)) {
+                        if (!readOnly) {
+                            logInstructionModification(cmd);
+                        }
+                        {
+                            InstructionTraceScope span(cmd.instName, cmd.args);
+                            cmd.func->status = cmd.func->invoke(cmd.argBlock);
+                        }
+                        // 修改指令返回失败的状态时（例如插入位置越界）同样回滚整个批处理
+                        if (!readOnly && !InvokeError::pending() && cmd.func->failed(cmd.func->status)) {
+                            reason = string("Status = ") + StatusToString(cmd.func->status);
+                        }
+                        else if (!readOnly && !InvokeError::pending()) {
+                            logRecord(encodeInvoke(cmd.instName, signature, cmd.args, cmd.argBlock));
+                        }
+                    }
+                }
+                if (InvokeError::pending()) {
+                    reason = InvokeError::current().message();
+                }
+                if (reason.empty()) {
+                    continue;
+                }
+            }
+            catch (const invalid_argument& iae) {
+                reason = InstructionInvalidArgumentException(iae.what()).what();
+            }
+            catch (const exception& e) {
+                reason = e.what();
+            }
+            rollbackTransaction();
+            throw BatchAbortedException(k + 1, cmd.instStr, reason);
+        }
+        commitTransaction();
+        OutputSink::instance()->result((long long)commands.size(),
+            "Batch committed: " + to_string(commands.size()) + " command(s).");
+    }
+
+    void Interactor::logADTModification(const string &name) {
+        if (!inTransaction || loggedADTs.find(name) != loggedADTs.end()) return;
+        lock_guard<mutex> registryGuard(registryMutex);
+        auto obj = lookupADT(name);
+        if (obj == nullptr) return;
+        UndoRecord record;
+        record.kind = UndoRecord::ADTModified;
+        record.name = name;
+        try {
+            record.adt = obj->clone();
+        }
+        catch (const UnimplementedException&) {
+            // 不支持快照的 ADT（例如共享线性表）在批处理中只能被只读指令使用，否则回滚时无法恢复
+            throw OperateObjectFailedException("Modify", "ADT", name,
+                "Its type cannot take part in a batch.");
+        }
+        undoLog.push_back(record);
+        loggedADTs.insert(name);
+    }
+
+    void Interactor::logInstructionModification(const BatchCommand &cmd) {
+        auto signature = cmd.func->signature();
+        for (size_t i = 0; i < signature.count; ++i) {
+            if (signature.specs[i].kind == ArgSpec::Variable) {
+                logVariableModification(cmd.args[i]);
+            }
+        }
+        vector<UndoStep> steps;
+        if (!cmd.func->undoSteps(cmd.argBlock, steps)) {
+            // 指令给不出逆操作时，保守地为所有 ADT 参数保存快照
+            steps.clear();
+            for (size_t i = 0; i < signature.count; ++i) {
+                if (signature.specs[i].kind == ArgSpec::ADT) steps.push_back({ i, nullptr });
+            }
+        }
+        for (auto& step : steps) {
+            auto& name = cmd.args[step.arg];
+            if (!step.undo) {
+                logADTModification(name);
+            }
+            // 已经保存过快照（或者在本次批处理中创建）的 ADT 回滚时整体恢复，之后的修改无需再记录
+            else if (loggedADTs.find(name) == loggedADTs.end()) {
+                UndoRecord record;
+                record.kind = UndoRecord::ADTInverse;
+                record.name = name;
+                record.undo = move(step.undo);
+                undoLog.push_back(move(record));
+            }
+        }
+    }
+
+    void Interactor::logVariableModification(const string &name) {
+        if (!inTransaction || loggedVariables.find(name) != loggedVariables.end()) return;
+        lock_guard<mutex> registryGuard(registryMutex);
+        auto varIter = userCreatedVariables.find(name);
+        // 被后台任务引用的变量不能读取，之后的绑定会报告错误
+        if (varIter == userCreatedVariables.end() || pinnedVariables.find(name) != pinnedVariables.end()) return;
+        UndoRecord record;
+        record.kind = UndoRecord::VariableModified;
+        record.name = name;
+        record.oldValue = *(varIter->second);
+        undoLog.push_back(record);
+        loggedVariables.insert(name);
+    }
+
+    void Interactor::commitTransaction() {
+        if (!pendingLogRecords.empty()) {
+            string record;
+            putU8(record, LogRecord::Batch);
+            putU32(record, (uint32_t)pendingLogRecords.size());
+            for (auto& sub : pendingLogRecords) {
+                putString(record, sub);
+            }
+            pendingLogRecords.clear();
+            WriteAheadLog::instance()->append(record);
+        }
+        // 提交时只需释放快照和被删除的对象
+        for (auto& record : undoLog) {
+            switch (record.kind) {
+                case UndoRecord::ADTDeleted:
+                case UndoRecord::ADTModified:
+                    record.adt->release();
+                    delete record.adt;
+                    break;
+                case UndoRecord::VariableDeleted:
+                    delete record.variable;
+                    break;
+                default:
+                    break;
+            }
+        }
+        undoLog.clear();
+        loggedADTs.clear();
+        loggedVariables.clear();
+        inTransaction = false;
+    }
+
+    void Interactor::rollbackTransaction() {
+        lock_guard<mutex> registryGuard(registryMutex);
+        for (auto record = undoLog.rbegin(); record != undoLog.rend(); ++record) {
+            switch (record->kind) {
+                case UndoRecord::ADTCreated: {
+                    auto obj = releaseADTSlot(userCreatedADTs.at(record->name));
+                    obj->release();
+                    delete obj;
+                    userCreatedADTs.erase(record->name);
+                    break;
+                }
+                case UndoRecord::ADTDeleted:
+                    // 恢复的对象会分配到新的槽位，删除之前发放的旧句柄不会重新生效
+                    userCreatedADTs.insert({ record->name,
+                        allocateADTSlot(record->adtType, record->adt, record->name) });
+                    break;
+                case UndoRecord::ADTModified: {
+                    auto& handle = userCreatedADTs.at(record->name);
+                    auto& slot = adtTypes[handle.type].slots[handle.index];
+                    slot.obj->release();
+                    delete slot.obj;
+                    slot.obj = record->adt;
+                    break;
+                }
+                case UndoRecord::ADTInverse: {
+                    // 按名称取当前的对象：它可能已被回滚时恢复的快照替换，或者是被删除后重新放回的对象
+                    auto& handle = userCreatedADTs.at(record->name);
+                    record->undo(adtTypes[handle.type].slots[handle.index].obj);
+                    break;
+                }
+                case UndoRecord::VariableCreated:
+                    delete userCreatedVariables.at(record->name);
+                    userCreatedVariables.erase(record->name);
+                    break;
+                case UndoRecord::VariableDeleted:
+                    userCreatedVariables.insert({ record->name, record->variable });
+                    break;
+                case UndoRecord::VariableModified:
+                    *(userCreatedVariables.at(record->name)) = record->oldValue;
+                    break;
+            }
+        }
+        pendingLogRecords.clear();
+        undoLog.clear();
+        loggedADTs.clear();
+        loggedVariables.clear();
+        inTransaction = false;
+    }
+
+    ADTRefs Interactor::resolveADTs(const vector<string> &args) {
+        ADTRefs adts;
+        lock_guard<mutex> registryGuard(registryMutex);
+        for (auto& arg : args) {
+            auto obj = lookupADT(arg);
+            if (obj != nullptr) {
+                adts.push_back({ obj, arg });
+                string depName;
+                auto dep = obj->dependency(depName);
+                if (dep != nullptr) {
+                    adts.push_back({ dep, depName });
+                }
+            }
+        }
+        sort(adts.begin(), adts.end());
+        adts.erase(unique(adts.begin(), adts.end(),
+            [](const pair<ADTObject*, string>& a, const pair<ADTObject*, string>& b) {
+                return a.first == b.first;
+            }), adts.end());
+        return adts;
+    }
+
+    bool Interactor::handleJobInstruction(const string &instStr) {
+        static const regex waitInstRegex(R"(wait (\d+))");
+        static const regex cancelInstRegex(R"(cancel (\d+))");
+        smatch strMatch;
+        if (!instStr.empty() && instStr[0] == '&') {
+            submitJob(instStr.substr(1));
+        }
+        else if (instStr == "jobs") {
+            listJobs();
+        }
+        else if (startsWith(instStr, "wait ") && regex_match(instStr, strMatch, waitInstRegex)) {
+            waitJob(stoi(strMatch[1]));
+        }
+        else if (startsWith(instStr, "cancel ") && regex_match(instStr, strMatch, cancelInstRegex)) {
+            cancelJob(stoi(strMatch[1]));
+        }
+        else {
+            return false;
+        }
+        return true;
+    }
+
+    void Interactor::submitJob(const string &instStr) {
+        string instName;
+        auto instArgs = extractInstructionStr(instStr, instName);
+        auto func = findInstruction(instName);
+        if (func == nullptr) {
+            throw InstructionNotFoundException(instName);
+        }
+        auto job = unique_ptr<BackgroundJob>(new BackgroundJob);
+        // 名称参数在参数块中引用的是字符串本身，所以直接对任务持有的参数解码
+        job->args = instArgs;
+        InvokeError::clear();
+        if (!decodeLiterals(func->signature(), job->args, job->argBlock)) {
+            OutputSink::instance()->error(InvokeError::current().message());
+            return;
+        }
+        job->id = nextJobId++;
+        job->instStr = instStr;
+        job->instName = instName;
+        job->func = func;
+        // 提交时就引用所有参数中的 ADT 和变量，保证任务结束之前它们不会被删除
+        // ADT、变量只会在主线程中被删除，所以这里的查找和引用之间不会有其他线程插入
+        job->adts = resolveADTs(instArgs);
+        {
+            lock_guard<mutex> registryGuard(registryMutex);
+            // 变量没有访问锁，同一个变量同时只能被一个后台任务使用
+            for (auto& arg : instArgs) {
+                if (pinnedVariables.find(arg) != pinnedVariables.end()) {
+                    throw ADTBusyException(arg);
+                }
+            }
+            for (auto& adt : job->adts) {
+                ++adt.first->pinCount;
+            }
+            for (auto& arg : instArgs) {
+                if (userCreatedVariables.find(arg) != userCreatedVariables.end() &&
+                    find(job->variables.begin(), job->variables.end(), arg) == job->variables.end()) {
+                    job->variables.push_back(arg);
+                    ++pinnedVariables[arg];
+                }
+            }
+        }
+        auto pJob = job.get();
+        backgroundJobs.insert({ pJob->id, std::move(job) });
+        pJob->worker = thread(&Interactor::runJob, this, pJob);
+        // 紧凑格式下输出 OK <任务编号>，供之后的 wait、cancel 使用
+        OutputSink::instance()->result(pJob->id, "[" + to_string(pJob->id) + "] " + pJob->instStr);
+    }
+
+    void Interactor::runJob(BackgroundJob *job) {
+        jobTemporaries = &job->temporaries;
+        CancellationToken::current() = &job->cancelled;
+        if (ExecutionTracer::enabled()) {
+            ExecutionTracer::instance()->nameThread("Job " + to_string(job->id));
+        }
+        int state = BackgroundJob::Done;
+        {
+            // 后台任务会一直等待，直到拿到所有 ADT 的锁为止
+            ADTLockGuard adtGuard(job->adts, true);
+            auto signature = job->func->signature();
+            bool bound = false;
             try {
-                *left = *getVariable(sm[2]);
+                InvokeError::clear();
+                bound = bindReferences(signature, job->args, job->argBlock);
+                if (bound) {
+                    InstructionTraceScope span(job->instName, job->args);
+                    job->status = job->func->invoke(job->argBlock);
+                }
+                if (InvokeError::pending()) {
+                    job->error = InvokeError::current().message();
+                    state = BackgroundJob::Failed;
+                }
+            }
+            catch (const invalid_argument& iae) {
+                job->error = InstructionInvalidArgumentException(iae.what()).what();
+                state = BackgroundJob::Failed;
+            }
+            catch (const exception& e) {
+                job->error = e.what();
+                state = BackgroundJob::Failed;
             }
-            catch (const OperateObjectFailedException& oofe) {
-                *left = stoi(sm[2]);
+            // 正常完成的任务记录指令本身；被取消或者出错的任务可能只完成了一部分修改，重放指令得不到相同的结果，
+            // 所以改为记录它用到的所有 ADT、变量此时的完整内容
+            if (bound && !job->func->readOnly()) {
+                if (state == BackgroundJob::Done && !job->cancelled.load()) {
+                    logRecord(encodeInvoke(job->instName, signature, job->args, job->argBlock));
+                }
+                else {
+                    for (auto& adt : job->adts) {
+                        logRecord(encodeADTImage(adt.second, adt.first));
+                    }
+                    for (auto& var : job->variables) {
+                        string record;
+                        putU8(record, LogRecord::SetVariable);
+                        putString(record, var);
+                        putI32(record, *getVariable(var));
+                        logRecord(record);
+                    }
+                }
+            }
+        }
+        // 被取消或者出错时指令可能来不及删除自己的临时变量，这里统一清理
+        for (auto& temp : job->temporaries) {
+            delete temp.second;
+        }
+        job->temporaries.clear();
+        {
+            lock_guard<mutex> registryGuard(registryMutex);
+            for (auto& adt : job->adts) {
+                --adt.first->pinCount;
+            }
+            for (auto& var : job->variables) {
+                if (--pinnedVariables[var] == 0) {
+                    pinnedVariables.erase(var);
+                }
+            }
+        }
+        jobTemporaries = nullptr;
+        CancellationToken::current() = nullptr;
+        job->state.store(state);
+    }
+
+    void Interactor::listJobs() {
+        for (auto& elem : backgroundJobs) {
+            auto job = elem.second.get();
+            string stateStr;
+            switch (job->state.load()) {
+                case BackgroundJob::Running:
+                    stateStr = job->cancelled.load() ? "Cancelling" : "Running";
+                    break;
+                case BackgroundJob::Done:
+                    stateStr = job->cancelled.load() ? "Cancelled" : "Done";
+                    break;
+                default:
+                    stateStr = "Failed";
+                    break;
             }
+            OutputSink::instance()->info() << "[" << job->id << "] " << stateStr << "\t" << job->instStr << '\n';
+        }
+    }
+
+    void Interactor::waitJob(int id) {
+        auto jobIter = backgroundJobs.find(id);
+        if (jobIter == backgroundJobs.end()) {
+            throw JobNotFoundException(id);
+        }
+        auto job = jobIter->second.get();
+        job->worker.join();
+        auto sink = OutputSink::instance();
+        sink->out() << "[" << job->id << "] " << job->instStr << '\n';
+        if (job->state.load() == BackgroundJob::Failed) {
+            sink->error(job->error);
+        }
+        else {
+            sink->result(job->status, string("Status = ") + StatusToString(job->status));
+            hasResult = true;
+            lastStatus = job->status;
+        }
+        backgroundJobs.erase(jobIter);
+    }
+
+    void Interactor::cancelJob(int id) {
+        auto jobIter = backgroundJobs.find(id);
+        if (jobIter == backgroundJobs.end()) {
+            throw JobNotFoundException(id);
+        }
+        jobIter->second->cancelled.store(true);
+    }
+
+    void Interactor::quit(int code) {
+        // 静态对象析构时不能还有任务线程在访问 ADT，所以先取消所有未结束的任务并等待它们退出
+        for (auto& elem : backgroundJobs) {
+            elem.second->cancelled.store(true);
+        }
+        for (auto& elem : backgroundJobs) {
+            if (elem.second->worker.joinable()) {
+                elem.second->worker.join();
+            }
+        }
+        backgroundJobs.clear();
+        std::exit(code);
+    }
+
+    bool Interactor::handleLogInstruction(const string &instStr) {
+        if (instStr != "checkpoint" && instStr != "wal") return false;
+        auto wal = WriteAheadLog::instance();
+        if (!wal->active()) {
+            throw OperateObjectFailedException("Access", "Write-ahead log", "",
+                "Not enabled. Start the interactor with --wal <path>.");
+        }
+        if (instStr == "wal") {
+            OutputSink::instance()->info() << wal->status() << '\n';
             return true;
         }
-        else if (userCreatedVariables.find(instStr) != userCreatedVariables.end()) {
-            std::cout << *(userCreatedVariables.at(instStr)) << endl;
+        if (inBatch || hasRunningJobs()) {
+            throw OperateObjectFailedException("Checkpoint", "Write-ahead log", "",
+                "A batch or background job is still in progress.");
+        }
+        checkpoint();
+        OutputSink::instance()->out() << wal->status() << '\n';
+        return true;
+    }
+
+    bool Interactor::handleTraceInstruction(const string &instStr) {
+        static const regex traceInstRegex(R"(trace (\S+))"); // 格式：trace [path]|stop
+        smatch strMatch;
+        if (!startsWith(instStr, "trace ") || !regex_match(instStr, strMatch, traceInstRegex)) return false;
+        auto tracer = ExecutionTracer::instance();
+        if (strMatch[1] != "stop") {
+            startTracing(strMatch[1]);
+            OutputSink::instance()->out() << "Tracing to \"" << tracer->outputPath() << "\".\n";
             return true;
         }
+        if (!ExecutionTracer::enabled()) {
+            throw OperateObjectFailedException("Stop", "Execution trace", "",
+                "Not started. Use trace <path> or start the interactor with --trace <path>.");
+        }
+        auto count = tracer->stop();
+        if (count < 0) {
+            throw OperateObjectFailedException("Write", "Execution trace", tracer->outputPath());
+        }
+        OutputSink::instance()->out() << "Wrote " << count << " event(s) to \"" << tracer->outputPath() << "\".\n";
+        return true;
+    }
+
+    void Interactor::startTracing(const string &path) {
+        auto tracer = ExecutionTracer::instance();
+        tracer->start(path);
+        tracer->nameThread("Interactor");
+    }
+
+    void Interactor::openWriteAheadLog(const string &path) {
+        auto sink = OutputSink::instance();
+        // 重放时不输出执行结果
+        bool quiet = sink->quiet;
+        sink->quiet = true;
+        uint64_t replayed;
+        try {
+            replayed = WriteAheadLog::instance()->open(path,
+                [this](BinaryReader& in) { return restoreSnapshot(in); },
+                [this](BinaryReader& in) { return applyLogRecord(in); });
+        }
+        catch (...) {
+            sink->quiet = quiet;
+            throw;
+        }
+        sink->quiet = quiet;
+        sink->barrier = &WriteAheadLog::flushBarrier;
+        if (sink->format == OutputSink::TextFormat) {
+            sink->out() << "Recovered from \"" << path << "\": " << userCreatedADTs.size() << " ADT(s), "
+                        << userCreatedVariables.size() << " variable(s), " << replayed << " log record(s) replayed.\n";
+        }
+    }
+
+    void Interactor::checkpoint() {
+        string snapshot;
+        buildSnapshot(snapshot);
+        WriteAheadLog::instance()->checkpoint(snapshot);
+    }
+
+    bool Interactor::hasRunningJobs() {
+        for (auto& elem : backgroundJobs) {
+            if (elem.second->state.load() == BackgroundJob::Running) return true;
+        }
         return false;
     }
 
+    void Interactor::logRecord(const string &payload) {
+        auto wal = WriteAheadLog::instance();
+        if (!wal->active()) return;
+        // 后台任务不参与批处理，它们的记录总是直接追加
+        if (jobTemporaries == nullptr && inTransaction) {
+            pendingLogRecords.push_back(payload);
+        }
+        else {
+            wal->append(payload);
+        }
+    }
+
+    string Interactor::encodeInvoke(const string &instName, const ArgSignature &signature,
+                                    const vector<string> &args, const ArgBlock &block) {
+        string record;
+        putU8(record, LogRecord::Invoke);
+        putString(record, instName);
+        putU8(record, (uint8_t)args.size());
+        for (size_t i = 0; i < args.size(); ++i) {
+            if (signature.specs[i].kind == ArgSpec::Int) {
+                putI32(record, block.value(i));
+            }
+            else {
+                putString(record, args[i]);
+            }
+        }
+        return record;
+    }
+
+    string Interactor::encodeADTImage(const string &name, ADTObject *obj) {
+        string record;
+        putU8(record, LogRecord::ADTImage);
+        putString(record, name);
+        obj->serialize(record);
+        return record;
+    }
+
+    void Interactor::buildSnapshot(string &out) {
+        putU32(out, (uint32_t)userCreatedVariables.size());
+        for (auto& elem : userCreatedVariables) {
+            putString(out, elem.first);
+            putI32(out, *(elem.second));
+        }
+        putU32(out, (uint32_t)userCreatedADTs.size());
+        for (auto& registry : adtTypes) {
+            for (auto& slot : registry.slots) {
+                if (slot.obj == nullptr) continue;
+                putString(out, registry.name);
+                putString(out, slot.name);
+                string content;
+                slot.obj->serialize(content);
+                putString(out, content);
+            }
+        }
+    }
+
+    bool Interactor::restoreSnapshot(BinaryReader &in) {
+        uint32_t count = in.getU32();
+        for (uint32_t i = 0; i < count && in.ok; ++i) {
+            string name = in.getString();
+            ElemType value = in.getI32();
+            if (!in.ok) return false;
+            createVariable(name);
+            *getVariable(name) = value;
+        }
+        count = in.getU32();
+        for (uint32_t i = 0; i < count && in.ok; ++i) {
+            string type = in.getString();
+            string name = in.getString();
+            string content = in.getString();
+            if (!in.ok) return false;
+            createADT(name, type);
+            BinaryReader reader(content.data(), content.size());
+            if (!getADT(name)->deserialize(reader)) return false;
+        }
+        return in.ok;
+    }
+
+    bool Interactor::applyLogRecord(BinaryReader &in) {
+        try {
+            switch (in.getU8()) {
+                case LogRecord::NewADT: {
+                    string type = in.getString();
+                    string name = in.getString();
+                    if (!in.ok) return false;
+                    createADT(name, type);
+                    return true;
+                }
+                case LogRecord::DeleteADT: {
+                    string name = in.getString();
+                    if (!in.ok) return false;
+                    deleteADT(name);
+                    return true;
+                }
+                case LogRecord::NewVariable: {
+                    string name = in.getString();
+                    if (!in.ok) return false;
+                    createVariable(name);
+                    return true;
+                }
+                case LogRecord::DeleteVariable: {
+                    string name = in.getString();
+                    if (!in.ok) return false;
+                    deleteVariable(name);
+                    return true;
+                }
+                case LogRecord::SetVariable: {
+                    string name = in.getString();
+                    ElemType value = in.getI32();
+                    if (!in.ok) return false;
+                    *getVariable(name) = value;
+                    return true;
+                }
+                case LogRecord::Invoke: {
+                    string instName = in.getString();
+                    size_t count = in.getU8();
+                    auto func = findInstruction(instName);
+                    if (!in.ok || func == nullptr) return false;
+                    auto signature = func->signature();
+                    if (count != signature.count) return false;
+                    vector<string> args(count);
+                    for (size_t i = 0; i < count; ++i) {
+                        args[i] = (signature.specs[i].kind == ArgSpec::Int) ? to_string(in.getI32()) : in.getString();
+                    }
+                    return in.ok && invoke(instName, func, args);
+                }
+                case LogRecord::ADTImage: {
+                    string name = in.getString();
+                    auto handle = findADTHandle(name);
+                    auto old = resolveADT(handle);
+                    if (!in.ok || old == nullptr) return false;
+                    auto obj = adtTypes[handle.type].sample->copy();
+                    if (!obj->deserialize(in)) {
+                        delete obj;
+                        return false;
+                    }
+                    old->release();
+                    delete old;
+                    adtTypes[handle.type].slots[handle.index].obj = obj;
+                    return true;
+                }
+                case LogRecord::Batch: {
+                    uint32_t count = in.getU32();
+                    for (uint32_t i = 0; i < count; ++i) {
+                        string sub = in.getString();
+                        BinaryReader reader(sub.data(), sub.size());
+                        if (!in.ok || !applyLogRecord(reader)) return false;
+                    }
+                    return in.ok;
+                }
+                default:
+                    return false;
+            }
+        }
+        catch (const exception&) {
+            return false;
+        }
+    }
+
     void Interactor::listUserCreatedAdts() {
-        for (auto& elem : userCreatedADTs) {
-            cout << elem.second->str() << " " << elem.first << endl;
+        // 按类型逐个扫描紧凑的槽位数组，同一类型的 ADT 会连续列出
+        for (auto& registry : adtTypes) {
+            for (auto& slot : registry.slots) {
+                if (slot.obj != nullptr) {
+                    OutputSink::instance()->info() << slot.obj->str() << " " << slot.name << '\n';
+                }
+            }
         }
     }
 
     void Interactor::listUserCreateVariables() {
+        lock_guard<mutex> registryGuard(registryMutex);
         for (auto& elem : userCreatedVariables) {
-            cout << elem.first << " = " << *(elem.second) << endl;
+            auto& info = OutputSink::instance()->info();
+            if (pinnedVariables.find(elem.first) != pinnedVariables.end()) {
+                info << elem.first << " = (in use by a background job)\n";
+            }
+            else {
+                info << elem.first << " = " << *(elem.second) << '\n';
+            }
         }
     }
 
     void Interactor::showHelpText() {
-        cout << "\t/q\tQuit" << endl;
-        cout << "\t/?\tHelp" << endl;
+        auto& helpText = OutputSink::instance()->info();
+        helpText << "\t/q\tQuit" << '\n';
+        helpText << "\t/?\tHelp" << '\n';
+        helpText << "\tbegin\tStart collecting a batch of commands" << '\n';
+        helpText << "\tcommit\tExecute the batch, rolling back all changes if any command fails" << '\n';
+        helpText << "\trollback\tDiscard the batch" << '\n';
+        helpText << "\t&Instr(args)\tRun an instruction in the background" << '\n';
+        helpText << "\tInstr(S, \"text\")\tString literals are quoted; escape \\\" and \\\\ inside them" << '\n';
+        helpText << "\tjobs\tList background jobs" << '\n';
+        helpText << "\twait <id>\tWait for a background job and show its result" << '\n';
+        helpText << "\tcancel <id>\tRequest cancellation of a background job" << '\n';
+        helpText << "\tset output normal|quiet\tQuiet mode only prints failures and explicit queries" << '\n';
+        helpText << "\tset format text|compact\tCompact format prints one \"OK <status>\" or \"ERR <message>\" line per result" << '\n';
+        helpText << "\tset flush command|batch|exit\tWhen buffered output is written out (results wait for the write-ahead log)" << '\n';
+        helpText << "\tcheckpoint\tWrite a snapshot and truncate the write-ahead log (start with --wal <path>)" << '\n';
+        helpText << "\twal\tShow the write-ahead log status" << '\n';
+        helpText << "\ttrace <path>|stop\tStart recording instruction spans, or stop and write them as Chrome trace-event JSON" << '\n';
     }
 }
@@ -17,17 +17,125 @@
 #pragma once
 
 #include "Common.h"
+#include "InstructionTable.h"
+#include "WriteAheadLog.h"
 
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 using namespace  std;
 
 namespace DataStructure_Cxx {
 
-    // 加载函数实例的宏，参见 Interactor::addInstruction 方法即可明白此宏的作用
-#define LoadFunc(func_name) Interactor::instance()->addInstruction(#func_name, func_name::instance())
+    // 用户创建的 ADT 的句柄：类型编号 + 槽位下标 + 代数（generation）
+    // 槽位被释放时代数加一，之后再用旧句柄访问会被识别为失效，而不会访问到占用该槽位的新对象
+    struct ADTHandle {
+        uint32_t type = UINT32_MAX;
+        uint32_t index = 0;
+        uint32_t generation = 0;
+    };
+
+    struct ADTSlot {
+        ADTObject* obj = nullptr;   // 为空表示槽位空闲
+        uint32_t generation = 0;
+        string name;
+    };
+
+    // 同一种 ADT 的所有对象存放在一个紧凑的槽位数组中，空闲槽位通过 freeSlots 复用
+    // 对象本身仍然单独分配：ADTObject 持有互斥锁而无法移动，事务回滚时也需要整体替换对象
+    struct ADTTypeRegistry {
+        string name;
+        ADTObject* sample = nullptr;    // 程序维护的标准数据结构样本（用来复制产生用户创建的数据结构）
+        uint32_t baseType = UINT32_MAX; // 派生自哪种 ADT（参见 ADT_FAMILY_ARG），没有则为 UINT32_MAX
+        vector<ADTSlot> slots;
+        vector<uint32_t> freeSlots;
+    };
+
+    // 批处理中的一条命令：函数指令在提交时即完成解析、查找和整数参数的解码，
+    // 其余命令（new、delete、赋值等）保留原始字符串
+    struct BatchCommand {
+        string instStr;
+        string instName;
+        Function* func = nullptr;
+        vector<string> args;
+        ArgBlock argBlock;
+    };
+
+    // 撤销日志中的一条记录，回滚时按照与记录相反的顺序逐条撤销
+    struct UndoRecord {
+        enum Kind {
+            ADTCreated, ADTDeleted, ADTModified, ADTInverse,
+            VariableCreated, VariableDeleted, VariableModified
+        };
+        Kind kind;
+        string name;
+        uint32_t adtType = 0;           // ADTDeleted：被删除的对象的类型编号，回滚时据此重新分配槽位
+        ADTObject* adt = nullptr;       // ADTDeleted：被删除的对象；ADTModified：修改之前的快照
+        // ADTInverse：指令给出的逆操作（参见 Function::undoSteps）
+        function<void(ADTObject*)> undo;
+        ElemType* variable = nullptr;   // VariableDeleted：被删除的变量
+        ElemType oldValue = 0;          // VariableModified：修改之前的值
+    };
+
+    // 按地址顺序为一组 ADT 加锁（避免死锁），析构时自动解锁
+    // wait 为 false 时只尝试加锁，任何一个 ADT 正在被使用都会抛出 ADTBusyException
+    using ADTRefs = vector<pair<ADTObject*, string>>;
+
+    class ADTLockGuard {
+    private:
+        vector<ADTObject*> locked;
+
+    public:
+        ADTLockGuard(const ADTRefs& adts, bool wait);
+        ~ADTLockGuard();
+    };
+
+    // 通过 &Instr(args) 提交的后台任务
+    struct BackgroundJob {
+        enum State { Running, Done, Failed };
+        int id = 0;
+        string instStr;
+        string instName;
+        Function* func = nullptr;
+        vector<string> args;
+        ArgBlock argBlock;
+        ADTRefs adts;                       // 任务涉及的 ADT，提交时即被引用（pin），结束后释放
+        vector<string> variables;           // 任务涉及的变量，任务结束之前不能被删除
+        atomic<bool> cancelled{false};
+        atomic<int> state{Running};
+        Status status = DSCxx_OK;
+        string error;
+        // 指令内部创建的临时变量（以下划线开头）只对本任务可见，避免与其他线程中的同名临时变量冲突
+        unordered_map<string, ElemType*> temporaries;
+        thread worker;
+    };
+
+    // 一行输入的执行结果，录制时写入轨迹文件，重放时用来核对
+    struct CommandOutcome {
+        enum Kind {
+            Done,       // 执行成功，但没有返回状态（new、赋值、begin 等命令）
+            Result,     // 函数指令（或者 wait 的后台任务）执行成功，status 为其返回的状态
+            Failed      // 执行失败，message 为错误信息
+        };
+        Kind kind = Done;
+        long long status = 0;
+        string message;
+
+        // 轨迹文件中的表示：ok、err 或者状态值
+        string str() const {
+            return (kind == Done) ? "ok" : (kind == Failed) ? "err" : to_string(status);
+        }
+    };
 
     // Interactor，即命令交互器，负责提示用户输入、解析命名字符串、动态调用函数、反馈函数执行结果等
     class Interactor {
@@ -44,32 +152,112 @@ namespace DataStructure_Cxx {
         }
 
     private:
-        // 可调用的函数指令，这个 map 在初始化的时候即应该定义好，运行时不会改动
+        // 可调用的函数指令：编译期生成的完美哈希指令表（参见 InstructionTable.h），
+        // 以及通过 addInstruction 在运行时额外添加的指令（通常为空，只在测试等场合使用）
+        InstructionTableView instructionTable;
         unordered_map<string, Function*> availableInstructions;
-        // [数据结构的字符串名称] : [程序维护的标准数据结构样本]（用来复制产生用户创建的数据结构）
-        unordered_map<string, ADTObject*> availableADTs;
-        // [用户命名的标识符] : [实际存储的数据结构对象]
-        unordered_map<string, ADTObject*> userCreatedADTs;
+        // 以类型编号为下标的 ADT 类型表，以及 [数据结构的字符串名称] : [类型编号]
+        vector<ADTTypeRegistry> adtTypes;
+        unordered_map<string, uint32_t> availableADTs;
+        // [用户命名的标识符] : [实际存储的数据结构对象的句柄]
+        unordered_map<string, ADTHandle> userCreatedADTs;
         // [用户命名的变量名称] : [实际存储的变量]
         unordered_map<string, ElemType*> userCreatedVariables;
 
+        // 在 begin 与 commit/rollback 之间输入的命令会先暂存起来，提交时一次性解析并连续执行
+        bool inBatch = false;
+        vector<string> pendingBatch;
+        // 提交批处理期间的撤销日志：指令能给出逆操作时只记录逆操作，否则每个 ADT、变量只在第一次被修改之前保存一次快照
+        bool inTransaction = false;
+        vector<UndoRecord> undoLog;
+        unordered_set<string> loggedADTs;
+        unordered_set<string> loggedVariables;
+
+        // 后台任务会在其他线程中查找 ADT、变量，所以对这几个表的修改和查找都需要加锁
+        mutex registryMutex;
+        map<int, unique_ptr<BackgroundJob>> backgroundJobs;
+        int nextJobId = 1;
+        unordered_map<string, int> pinnedVariables;
+
+        // 提交批处理期间产生的预写日志记录，提交时合并为一条 Batch 记录写入，回滚时丢弃
+        vector<string> pendingLogRecords;
+
+        // 最近一条命令是否产生了状态（参见 CommandOutcome::Result）
+        bool hasResult = false;
+        Status lastStatus = DSCxx_OK;
+        // 录制模式下的轨迹文件，每行为：[相对于开始录制的微秒数]\t[执行结果]\t[输入的命令]
+        FILE* traceFile = nullptr;
+        chrono::steady_clock::time_point traceStart;
+
     public:
         void run();
+        // 执行一行输入（run 和 replay 共用），错误不会输出，而是记录在返回的结果中
+        CommandOutcome dispatch(const string& instStr);
+        // 录制模式：之后 run 读到的每一行输入都会连同时间戳和执行结果写入轨迹文件
+        void startRecording(const string& path);
+        // 重放轨迹文件中的命令并核对执行结果，输出吞吐量和延迟的分位数；所有结果都一致时返回 true
+        // originalPacing 为 true 时按照录制时的时间间隔执行，否则尽可能快地连续执行
+        bool replay(const string& path, bool originalPacing);
+        // 执行一条普通命令（操作命令、变量命令或者函数指令）
+        // 函数指令的常见错误通过 InvokeError 报告并返回 false，其余错误仍然抛出异常
+        bool execute(const string& instStr);
         vector<string> extractInstructionStr(const string& argStr, string& instName);
-        void invoke(Function* func, const vector<string>& args);
+        // 与 extractInstructionStr 相同，但格式错误时返回 false 而不抛出异常
+        bool parseInstructionStr(const string& instStr, string& instName, vector<string>& instArgs);
+        // 执行函数指令并输出结果；指令报告了错误（参见 InvokeError）时返回 false，不输出结果
+        bool invoke(const string& instName, Function* func, const vector<string>& args);
 
+        // 按指令的签名解码参数，出错时记录 InvokeError 并返回 false
+        // 整数字面值、名称在解析之后立即解码（decodeLiterals），名称引用 args 中的字符串，args 须比参数块存活更久；
+        // ADT、变量则在即将执行时才绑定（bindReferences），
+        // 因为批处理中它们可能由前面的命令创建，后台任务也要等到拿到锁之后才能访问
+        bool decodeLiterals(const ArgSignature& signature, const vector<string>& args, ArgBlock& block);
+        bool bindReferences(const ArgSignature& signature, const vector<string>& args, ArgBlock& block);
+
+        // 加载指令时检查其签名：参数不能过多，用到的 ADT 类型必须已经注册，否则抛出 logic_error
+        void checkSignature(const string& name, const ArgSignature& signature);
+        void setInstructionTable(const InstructionTableView& table);
         void addInstruction(const string& name, Function* func);
-        void addAdtType(const string& name, ADTObject* obj);
+        // 按名称查找函数指令，找不到时返回 nullptr
+        Function* findInstruction(const string& name);
+
+        // baseType 为已注册的基础类型的编号，派生类型的 ADT 可以传给声明了 ADT_FAMILY_ARG(基础类型) 的指令
+        template<typename T>
+        void addAdtType(const string& name, T* obj, uint32_t baseType = UINT32_MAX) {
+            ADTTypeId<T>::value = (uint32_t)adtTypes.size();
+            ADTTypeRegistry registry;
+            registry.name = name;
+            registry.sample = obj;
+            registry.baseType = baseType;
+            adtTypes.push_back(registry);
+            availableADTs.insert({ name, ADTTypeId<T>::value });
+        }
 
         // 下面关于 ADT、Variable 的 create、delete、get 方法均会处理异常，
         // 所以无需在调用这些方法前对传入的字符串参数进行额外判断
         void createADT(const string& name, const string& adtType);
         void deleteADT(const string& name);
         ADTObject* getADT(const string& name);
+        // 找不到或者类型不符时返回 nullptr 并记录 InvokeError，供指令在热路径中使用
+        // acceptDerived 为 true 时，类型为 type 的派生类型的 ADT 也视为符合
+        ADTObject* findADT(const string& name, uint32_t type, bool acceptDerived = false);
+        template<typename T>
+        T* findADT(const string& name) {
+            return static_cast<T*>(findADT(name, ADTTypeId<T>::value));
+        }
+        // 按名称取得句柄（找不到时返回的句柄无效），以及通过句柄直接访问对象（句柄失效时返回 nullptr）
+        ADTHandle findADTHandle(const string& name);
+        ADTObject* resolveADT(const ADTHandle& handle);
+        // 加锁后再通过句柄访问对象，以及由对象反查句柄和名称（找不到时返回的句柄无效），供引用其他 ADT 的数据结构使用
+        ADTObject* findADT(const ADTHandle& handle);
+        ADTHandle findADTHandle(ADTObject* obj, string& name);
 
         void createVariable(const string& name);
         void deleteVariable(const string& name);
         ElemType* getVariable(const string& name);
+        // 找不到、或者被后台任务引用（在主线程中访问时）返回 nullptr 并记录 InvokeError
+        ElemType* findVariable(const string& name);
+        bool isVariable(const string& name);
 
         // 处理诸如"退出程序"等控制命令
         bool handleControlInstruction(const string& instStr);
@@ -77,7 +265,60 @@ namespace DataStructure_Cxx {
         bool handleOperationInstruction(const string& instStr);
         // 当用户直接输入变量名时，显示其内容
         bool handleVariableInstruction(const string& instStr);
+        // 处理 set output|format|flush 等输出设置命令
+        bool handleSettingInstruction(const string& instStr);
+        // 处理 begin、commit、rollback 等批处理命令
+        bool handleTransactionInstruction(const string& instStr);
+        // 处理 &Instr(args)、jobs、wait、cancel 等后台任务命令
+        bool handleJobInstruction(const string& instStr);
+
+        // 找出参数中出现的所有 ADT 以及它们引用的 ADT，按地址排序并去重，用于加锁
+        ADTRefs resolveADTs(const vector<string>& args);
+        void submitJob(const string& instStr);
+        void runJob(BackgroundJob* job);
+        void listJobs();
+        void waitJob(int id);
+        void cancelJob(int id);
+        // 取消并等待所有后台任务，然后以 code 退出程序
+        [[noreturn]] void quit(int code);
 
+        void commitBatch();
+        // 在 ADT、变量被修改之前调用，将其原状态写入撤销日志（不在事务中时什么也不做）
+        void logADTModification(const string& name);
+        void logVariableModification(const string& name);
+        // 在批处理中执行函数指令之前调用（参数已经绑定）：记录它的逆操作，或者为它会修改的参数保存快照
+        void logInstructionModification(const BatchCommand& cmd);
+        void commitTransaction();
+        void rollbackTransaction();
+
+        // 启用预写日志（参见 WriteAheadLog.h）：先从日志和快照中恢复状态，之后的修改都会被记录
+        void openWriteAheadLog(const string& path);
+        // 处理 checkpoint、wal 等预写日志命令
+        bool handleLogInstruction(const string& instStr);
+        void checkpoint();
+        // 开始执行追踪（参见 ExecutionTracer.h），追踪结果在 trace stop 或者程序退出时写入 path
+        void startTracing(const string& path);
+        // 处理 trace <path>、trace stop 命令
+        bool handleTraceInstruction(const string& instStr);
+        bool hasRunningJobs();
+        // 记录一次修改：提交批处理期间先暂存，否则直接追加到日志（未启用预写日志时什么也不做）
+        void logRecord(const string& payload);
+        string encodeInvoke(const string& instName, const ArgSignature& signature,
+                            const vector<string>& args, const ArgBlock& block);
+        string encodeADTImage(const string& name, ADTObject* obj);
+        // 快照的内容：所有变量，以及所有 ADT 的类型、名称和 serialize 的结果
+        void buildSnapshot(string& out);
+        bool restoreSnapshot(BinaryReader& in);
+        // 重放一条日志记录，出错时返回 false
+        bool applyLogRecord(BinaryReader& in);
+
+    private:
+        // 以下方法只能在持有 registryMutex 时调用
+        ADTHandle allocateADTSlot(uint32_t type, ADTObject* obj, const string& name);
+        ADTObject* releaseADTSlot(const ADTHandle& handle);
+        ADTObject* lookupADT(const string& name);
+
+    public:
         void listUserCreatedAdts();
         void listUserCreateVariables();
         void showHelpText();
@@ -159,6 +400,63 @@ namespace DataStructure_Cxx {
         }
     };
 
+    class BatchStateException : public exception {
+    private:
+        string msg;
+
+    public:
+        explicit BatchStateException(const string& reason) {
+            msg = "Batch operation failed. Reason: " + reason;
+        }
+
+        const char * what() const noexcept override {
+            return msg.c_str();
+        }
+    };
+
+    class BatchAbortedException : public exception {
+    private:
+        string msg;
+
+    public:
+        BatchAbortedException(size_t index, const string& instStr, const string& reason) {
+            msg = "Batch aborted at command " + to_string(index) + " \"" + instStr +
+                  "\", all changes rolled back. Reason: " + reason;
+        }
+
+        const char * what() const noexcept override {
+            return msg.c_str();
+        }
+    };
+
+    class ADTBusyException : public exception {
+    private:
+        string msg;
+
+    public:
+        explicit ADTBusyException(const string& name) {
+            msg = "ADT/Variable \"" + name + "\" is in use by a background job.";
+        }
+
+        const char * what() const noexcept override {
+            return msg.c_str();
+        }
+    };
+
+    class JobNotFoundException : public exception {
+    private:
+        string msg;
+
+    public:
+        explicit JobNotFoundException(int id) {
+            msg = "Job [" + to_string(id) + "] not found.";
+        }
+
+        const char * what() const noexcept override {
+            return msg.c_str();
+        }
+    };
+
     class ConflictUserDefinedNameException : public exception {
     private:
         string msg;
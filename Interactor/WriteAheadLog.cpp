@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+
+#include "WriteAheadLog.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace DataStructure_Cxx {
+
+    static const char SnapshotMagic[8] = { 'D', 'S', 'C', 'X', 'S', 'N', 'P', '1' };
+    static const size_t RecordHeaderSize = 16;  // 长度、CRC32、LSN
+
+    // CRC32（IEEE 802.3 多项式），查找表在第一次使用时生成
+    static uint32_t crc32(const char* data, size_t size) {
+        static const auto table = [] {
+            struct { uint32_t v[256]; } t;
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                }
+                t.v[i] = c;
+            }
+            return t;
+        }();
+        uint32_t crc = 0xffffffffu;
+        for (size_t i = 0; i < size; ++i) {
+            crc = table.v[(crc ^ (uint8_t)data[i]) & 0xff] ^ (crc >> 8);
+        }
+        return crc ^ 0xffffffffu;
+    }
+
+    static bool readFile(const string& path, string& content) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        content.clear();
+        char chunk[64 * 1024];
+        ssize_t n;
+        while ((n = ::read(fd, chunk, sizeof(chunk))) > 0) {
+            content.append(chunk, (size_t)n);
+        }
+        ::close(fd);
+        return n == 0;
+    }
+
+    // 日志文件的 I/O 出错之后已经无法保证持久性，只能终止程序
+    static void ioFailed(const char* what) {
+        fprintf(stderr, "Write-ahead log %s failed: %s\n", what, strerror(errno));
+        std::abort();
+    }
+
+    uint64_t WriteAheadLog::open(const string& logPath,
+                                 const function<bool(BinaryReader&)>& restoreSnapshot,
+                                 const function<bool(BinaryReader&)>& applyRecord) {
+        if (isActive) {
+            throw runtime_error("Write-ahead log is already open.");
+        }
+        path = logPath;
+        string content;
+        if (readFile(path + ".snapshot", content)) {
+            BinaryReader header(content.data(), content.size());
+            if (content.size() < 20 || memcmp(content.data(), SnapshotMagic, 8) != 0) {
+                throw runtime_error("Invalid snapshot file \"" + path + ".snapshot\".");
+            }
+            header.p += 8;
+            snapshotLsn = header.getU64();
+            uint32_t crc = header.getU32();
+            BinaryReader body(header.p, header.end - header.p);
+            if (crc32(body.p, body.end - body.p) != crc || !restoreSnapshot(body)) {
+                throw runtime_error("Snapshot file \"" + path + ".snapshot\" is corrupted.");
+            }
+        }
+        nextLsn = snapshotLsn + 1;
+
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+        if (fd < 0) {
+            throw runtime_error("Cannot open write-ahead log \"" + path + "\": " + strerror(errno));
+        }
+        if (!readFile(path, content)) {
+            throw runtime_error("Cannot read write-ahead log \"" + path + "\".");
+        }
+        uint64_t replayed = 0;
+        size_t offset = 0;
+        while (content.size() - offset >= RecordHeaderSize) {
+            BinaryReader header(content.data() + offset, RecordHeaderSize);
+            uint32_t size = header.getU32();
+            uint32_t crc = header.getU32();
+            if (size < 8 || content.size() - offset - 8 < size ||
+                crc32(content.data() + offset + 8, size) != crc)
+            {
+                break;
+            }
+            uint64_t lsn = header.getU64();
+            if (lsn > snapshotLsn) {
+                BinaryReader record(content.data() + offset + RecordHeaderSize, size - 8);
+                if (!applyRecord(record)) {
+                    throw runtime_error("Failed to replay write-ahead log record " + to_string(lsn) + ".");
+                }
+                ++replayed;
+            }
+            if (lsn >= nextLsn) {
+                nextLsn = lsn + 1;
+            }
+            offset += 8 + size;
+        }
+        // 尾部不完整（崩溃时正在写入）的记录从未被确认过，直接截断
+        if (offset < content.size()) {
+            if (::ftruncate(fd, (off_t)offset) != 0 || ::fdatasync(fd) != 0) {
+                throw runtime_error("Cannot truncate write-ahead log \"" + path + "\".");
+            }
+        }
+        fileSize = offset;
+        appendedLsn = durableLsn = nextLsn - 1;
+        isActive = true;
+        flusher = thread(&WriteAheadLog::flusherLoop, this);
+        flusher.detach();
+        return replayed;
+    }
+
+    uint64_t WriteAheadLog::append(const string& payload) {
+        lock_guard<mutex> guard(bufferMutex);
+        uint64_t lsn = nextLsn++;
+        bool wasEmpty = buffer.empty();
+        size_t start = buffer.size();
+        putU32(buffer, (uint32_t)(payload.size() + 8));
+        putU32(buffer, 0);
+        putU64(buffer, lsn);
+        buffer.append(payload);
+        uint32_t crc = crc32(buffer.data() + start + 8, payload.size() + 8);
+        for (int i = 0; i < 4; ++i) {
+            buffer[start + 4 + i] = (char)(crc >> (8 * i));
+        }
+        appendedLsn = lsn;
+        // 缓冲区由空变为非空时唤醒刷写线程开始计时，超过阈值时让它立即写出
+        if (wasEmpty || buffer.size() >= WAL_GROUP_COMMIT_BYTES) {
+            flushNeeded.notify_one();
+        }
+        return lsn;
+    }
+
+    void WriteAheadLog::waitDurable(uint64_t lsn) {
+        unique_lock<mutex> lock(bufferMutex);
+        if (durableLsn >= lsn) return;
+        urgent = true;
+        flushNeeded.notify_one();
+        flushDone.wait(lock, [&] { return durableLsn >= lsn; });
+    }
+
+    void WriteAheadLog::sync() {
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(bufferMutex);
+            lsn = appendedLsn;
+        }
+        waitDurable(lsn);
+    }
+
+    void WriteAheadLog::flusherLoop() {
+        unique_lock<mutex> lock(bufferMutex);
+        while (true) {
+            flushNeeded.wait(lock, [&] { return !buffer.empty(); });
+            // 没有人等待落盘时再多等一会儿，让更多的记录加入这一组
+            if (!urgent && buffer.size() < WAL_GROUP_COMMIT_BYTES) {
+                flushNeeded.wait_for(lock, chrono::microseconds(WAL_GROUP_COMMIT_INTERVAL_US),
+                    [&] { return urgent || buffer.size() >= WAL_GROUP_COMMIT_BYTES; });
+            }
+            string pending;
+            pending.swap(buffer);
+            uint64_t upTo = appendedLsn;
+            urgent = false;
+            lock.unlock();
+            {
+                lock_guard<mutex> ioGuard(ioMutex);
+                writeAll(pending.data(), pending.size());
+                if (::fdatasync(fd) != 0) ioFailed("fdatasync");
+            }
+            lock.lock();
+            fileSize += pending.size();
+            durableLsn = upTo;
+            ++groupCommits;
+            flushDone.notify_all();
+        }
+    }
+
+    void WriteAheadLog::writeAll(const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t n = ::write(fd, data, size);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                ioFailed("write");
+            }
+            data += n;
+            size -= (size_t)n;
+        }
+    }
+
+    void WriteAheadLog::checkpoint(const string& snapshot) {
+        sync();
+        uint64_t lsn;
+        {
+            lock_guard<mutex> guard(bufferMutex);
+            lsn = appendedLsn;
+        }
+        string content(SnapshotMagic, 8);
+        putU64(content, lsn);
+        putU32(content, crc32(snapshot.data(), snapshot.size()));
+        content.append(snapshot);
+
+        string snapshotPath = path + ".snapshot";
+        string tempPath = snapshotPath + ".tmp";
+        int snapFd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (snapFd < 0) {
+            throw runtime_error("Cannot create snapshot file \"" + tempPath + "\": " + strerror(errno));
+        }
+        const char* data = content.data();
+        size_t size = content.size();
+        while (size > 0) {
+            ssize_t n = ::write(snapFd, data, size);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) {
+                ::close(snapFd);
+                throw runtime_error("Cannot write snapshot file \"" + tempPath + "\": " + strerror(errno));
+            }
+            data += n;
+            size -= (size_t)n;
+        }
+        if (::fsync(snapFd) != 0 || ::close(snapFd) != 0 || ::rename(tempPath.c_str(), snapshotPath.c_str()) != 0) {
+            throw runtime_error("Cannot install snapshot file \"" + snapshotPath + "\": " + strerror(errno));
+        }
+        // rename 本身也要落盘，否则崩溃后可能仍然看到旧的快照，而日志已经被清空
+        auto slash = snapshotPath.find_last_of('/');
+        string dir = (slash == string::npos) ? "." : snapshotPath.substr(0, slash + 1);
+        int dirFd = ::open(dir.c_str(), O_RDONLY);
+        if (dirFd >= 0) {
+            ::fsync(dirFd);
+            ::close(dirFd);
+        }
+
+        // 快照已经覆盖了日志中的所有记录；即使在截断之前崩溃，恢复时也会按 LSN 跳过它们
+        lock_guard<mutex> ioGuard(ioMutex);
+        if (::ftruncate(fd, 0) != 0 || ::fdatasync(fd) != 0) ioFailed("truncate");
+        lock_guard<mutex> guard(bufferMutex);
+        fileSize = 0;
+        snapshotLsn = lsn;
+    }
+
+    uint64_t WriteAheadLog::logSize() {
+        lock_guard<mutex> guard(bufferMutex);
+        return fileSize + buffer.size();
+    }
+
+    string WriteAheadLog::status() {
+        lock_guard<mutex> guard(bufferMutex);
+        return "Write-ahead log \"" + path + "\": " +
+               to_string(appendedLsn) + " appended, " +
+               to_string(durableLsn) + " durable, " +
+               to_string(fileSize) + " bytes, " +
+               to_string(groupCommits) + " group commit(s), snapshot at " +
+               to_string(snapshotLsn) + ".";
+    }
+}
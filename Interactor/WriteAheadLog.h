@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2021 yiyaowen
+ *
+ * 数据结构:C语言版/严蔚敏,吴伟民编著.（计算机系列教材）
+ * --北京：清华大学出版社，1997.4 ISBN 978-7-302-02368-5
+ *
+ * 此为《数据结构（C语言版）》中抽象数据结构和常见算法的实现，
+ * 为了优化程序结构，在某些地方可能作出了经过考量的修改和优化。
+ *
+ * 使用本代码时请列出原始出处和作者名称，例如：
+ * Author: yiyaowen
+ * From: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ * Also see: https://github.com/yiyaowen/DataStructure_Cxx
+ *
+ */
+#pragma once
+
+#include "Common.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+namespace DataStructure_Cxx {
+
+#define WAL_GROUP_COMMIT_INTERVAL_US 2000           // 组提交最多等待这么久（微秒），让同一时间段内的记录共用一次 fdatasync
+#define WAL_GROUP_COMMIT_BYTES (256 * 1024)         // 缓冲的记录超过该大小时不再等待，立即写出
+#define WAL_CHECKPOINT_THRESHOLD (64 * 1024 * 1024) // 日志文件超过该大小时自动做一次检查点，使恢复时间有上限
+
+    // 日志记录的种类，每条记录的第一个字节
+    struct LogRecord {
+        enum Kind : uint8_t {
+            NewADT = 1,     // ADT 类型名、名称
+            DeleteADT,      // 名称
+            NewVariable,    // 名称
+            DeleteVariable, // 名称
+            SetVariable,    // 名称、新的值
+            Invoke,         // 指令名、参数个数、各参数（整数参数为 32 位整数，其余为名称）
+            ADTImage,       // 名称、ADT 的完整内容（serialize 的结果），用于被取消的后台任务等无法重放的修改
+            Batch           // 子记录个数、各子记录：提交的批处理作为一条记录写入，恢复时要么全部重放，要么全部丢弃
+        };
+    };
+
+    // 预写日志：修改 ADT、变量的命令执行成功之后以紧凑的二进制记录追加到日志文件，程序启动时按顺序重放以恢复状态
+    //
+    // 文件中每条记录为 [长度 u32][CRC32 u32][LSN u64][内容]，CRC 覆盖 LSN 和内容；
+    // 崩溃时写了一半的尾部记录校验失败，恢复时会被截断
+    //
+    // 组提交：append 只把记录放进缓冲区，由后台的刷写线程统一写出并 fdatasync，
+    // 一次 fdatasync 可以覆盖主线程和所有后台任务在这段时间内提交的全部记录
+    // 输出的结果在写到标准输出之前会等待对应的记录落盘（参见 OutputSink::barrier），所以用户看到的结果都已持久化
+    //
+    // 检查点：把当前全部状态写入快照文件 <path>.snapshot（先写临时文件再 rename，保证原子性），
+    // 快照中记录它覆盖到的 LSN，随后清空日志；恢复时先载入快照，再重放 LSN 更大的记录
+    class WriteAheadLog {
+    private:
+        WriteAheadLog() = default;
+
+    public:
+        // 刷写线程可能在程序退出（析构静态对象）时仍在工作，所以日志对象不随静态对象析构
+        static WriteAheadLog* instance() {
+            static auto wal = new WriteAheadLog;
+            return wal;
+        }
+
+        // 打开（或创建）日志文件并恢复：先用 restoreSnapshot 载入快照（如果有），再对每条未被快照覆盖的记录调用 applyRecord
+        // 任何一步失败都会抛出 runtime_error；返回重放的记录条数。恢复完成之后才开始接受新的记录
+        uint64_t open(const string& logPath,
+                      const function<bool(BinaryReader&)>& restoreSnapshot,
+                      const function<bool(BinaryReader&)>& applyRecord);
+
+        bool active() const {
+            return isActive;
+        }
+
+        // 追加一条记录（可以在任何线程中调用），返回其 LSN；记录此时尚未落盘
+        uint64_t append(const string& payload);
+        // 等待 LSN 不超过 lsn 的记录全部落盘
+        void waitDurable(uint64_t lsn);
+        // 等待目前已追加的所有记录落盘
+        void sync();
+
+        // 用 snapshot 作为新的快照，然后清空日志
+        // 调用者保证 snapshot 反映了目前已追加的所有记录，并且此时没有其他线程追加记录
+        void checkpoint(const string& snapshot);
+
+        uint64_t logSize();
+        string status();
+
+        // 供 OutputSink 在写出之前调用
+        static void flushBarrier() {
+            auto wal = instance();
+            if (wal->active()) {
+                wal->sync();
+            }
+        }
+
+    private:
+        void flusherLoop();
+        void writeAll(const char* data, size_t size);
+
+        string path;
+        int fd = -1;
+        bool isActive = false;
+
+        mutex bufferMutex;              // 保护下面的缓冲区和计数
+        condition_variable flushNeeded; // 唤醒刷写线程
+        condition_variable flushDone;   // 唤醒等待落盘的线程
+        string buffer;
+        bool urgent = false;            // 有线程在等待落盘，刷写线程不再等待更多记录
+        uint64_t nextLsn = 1;
+        uint64_t appendedLsn = 0;
+        uint64_t durableLsn = 0;
+        uint64_t fileSize = 0;
+        uint64_t groupCommits = 0;
+        uint64_t snapshotLsn = 0;
+
+        mutex ioMutex;                  // 刷写线程的写出和检查点的截断互斥
+        thread flusher;
+    };
+}
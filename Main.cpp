@@ -23,11 +23,67 @@
 
 using namespace DataStructure_Cxx;
 
-int main() {
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// 用法：DSCxx_Interactor [--wal <path>] [--trace <json>] [--record <trace> | --replay <trace> [--pace original|max]]
+// --wal：启用预写日志，启动时从 <path> 及其快照中恢复上次的状态，之后的修改都会记录到 <path>
+// --trace：记录每条指令及其内部调用的执行区间，退出时写成 Chrome trace-event 格式的 JSON 文件
+// --record：把本次输入的每一行连同时间戳和执行结果写入轨迹文件
+// --replay：重放轨迹文件并核对执行结果，输出吞吐量和延迟后退出；默认尽可能快地执行，original 为按录制时的节奏执行
+int main(int argc, char** argv) {
 #ifdef BuildTest
     Interactor::instance()->addInstruction("MyAdd", MyAdd::instance());
 #else
     loadAllAdts();
 #endif
-    Interactor::instance()->run();
+    string walPath, tracePath, recordPath, replayPath, pace = "max";
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--wal") == 0) {
+            walPath = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--trace") == 0) {
+            tracePath = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--record") == 0) {
+            recordPath = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--replay") == 0) {
+            replayPath = argv[++i];
+        }
+        else if (i + 1 < argc && strcmp(argv[i], "--pace") == 0) {
+            pace = argv[++i];
+        }
+        else {
+            walPath.clear();
+            pace.clear();
+            break;
+        }
+    }
+    if ((pace != "max" && pace != "original") || (!recordPath.empty() && !replayPath.empty())) {
+        cerr << "Usage: " << argv[0] << " [--wal <path>] [--trace <json>] [--record <trace> | --replay <trace> [--pace original|max]]" << endl;
+        return EXIT_FAILURE;
+    }
+    auto interactor = Interactor::instance();
+    try {
+        if (!tracePath.empty()) {
+            interactor->startTracing(tracePath);
+        }
+        if (!walPath.empty()) {
+            interactor->openWriteAheadLog(walPath);
+        }
+        if (!replayPath.empty()) {
+            bool matched = interactor->replay(replayPath, pace == "original");
+            interactor->quit(matched ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+        if (!recordPath.empty()) {
+            interactor->startRecording(recordPath);
+        }
+    }
+    catch (const exception& e) {
+        cerr << e.what() << endl;
+        return EXIT_FAILURE;
+    }
+    interactor->run();
 }
\ No newline at end of file
@@ -22,14 +22,14 @@
 namespace DataStructure_Cxx {
     class MyAdd : public Function {
         ENABLE_SINGLETON(MyAdd)
+        SIGNATURE(INT_ARG, INT_ARG)
     public:
-        void invoke(const vector<string> &args) override {
-            CHECK_ARG_COUNT(2)
+        Status invoke(const ArgBlock &args) override {
             // 函数功能在这里实现
-            status = stoi(args[0]) + stoi(args[1]);
+            return args.value(0) + args.value(1);
         }
         void output() override {
-            cout << "Result: " << status << endl;
+            OutputSink::instance()->result(status, "Result: " + to_string(status));
         }
     };
     SINGLETON_MEMBER(MyAdd)